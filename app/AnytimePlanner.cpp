@@ -0,0 +1,230 @@
+/* Copyright (C)
+ * 2019 - Bhargav Dandamudi
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the 'Software'), to deal in the Software without
+ * restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit
+ * persons to whom the Software is furnished to do so,subject to
+ * the following conditions:
+ * The above copyright notice and this permission notice shall
+ * be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED ''AS IS'', WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR
+ * ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM,OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+/**
+ * @file AnytimePlanner.cpp
+ * @brief  ARA* search passes, epsilon schedule and deadline handling
+ * @author Bhargav Dandamudi
+ * @version 1
+ * @date 2019-04-21
+ */
+#include "../include/AnytimePlanner.h"
+#include <algorithm>
+#include <cfloat>
+#include <cstdlib>
+#include <limits>
+
+// the clock is read once per this many expansions
+static const int DEADLINE_CHECK_INTERVAL = 256;
+
+AnytimePlanner::AnytimePlanner(double initial_epsilon, double epsilon_step)
+    : initial_epsilon_(std::max(1.0, initial_epsilon)),
+      epsilon_step_(epsilon_step > 0.0
+                        ? epsilon_step
+                        : std::numeric_limits<double>::infinity()),
+      epsilon_(initial_epsilon),
+      bound_(std::numeric_limits<double>::infinity()), completed_searches_(0),
+      expanded_nodes_(0), start_index_(0), goal_index_(0), query_(0),
+      pass_(0) {}
+
+void AnytimePlanner::setSolutionCallback(SolutionCallback callback) {
+  this->callback_ = callback;
+}
+
+float AnytimePlanner::gCost(int cell) {
+  return this->seen_[cell] == this->query_ ? this->g_cost_[cell] : FLT_MAX;
+}
+
+double AnytimePlanner::fValue(int cell) {
+  std::pair<int, int> position = this->world_map_.toPosition(cell);
+  double h_cost = abs(position.first - this->goal_position_.first) +
+                  abs(position.second - this->goal_position_.second);
+  return gCost(cell) + this->epsilon_ * h_cost;
+}
+
+/* ----------------------------------------------------------------*/
+/**
+ * @brief  Expands cells until no queued cell can beat the goal under the
+ *          current epsilon. Cells improved after their expansion in this
+ *          pass are set aside as inconsistent for the next pass.
+ *
+ * @param deadline
+ *
+ * @return false if the deadline was hit before the pass finished
+ */
+/* ----------------------------------------------------------------*/
+bool AnytimePlanner::improvePath(Deadline deadline) {
+  int width = this->world_map_.getWidth();
+  int height = this->world_map_.getHeight();
+  int until_check = DEADLINE_CHECK_INTERVAL;
+  while (!this->open_.empty() &&
+         gCost(this->goal_index_) > this->open_.topPriority()) {
+    if (--until_check == 0) {
+      until_check = DEADLINE_CHECK_INTERVAL;
+      if (std::chrono::steady_clock::now() >= deadline) {
+        return false;
+      }
+    }
+    int cell = this->open_.pop();
+    this->closed_[cell] = this->pass_;
+    this->expanded_nodes_++;
+    int y = cell / width;
+    int x = cell % width;
+    int neighbors[4] = {y > 0 ? cell - width : -1, x > 0 ? cell - 1 : -1,
+                        y < height - 1 ? cell + width : -1,
+                        x < width - 1 ? cell + 1 : -1};
+    float g_new = gCost(cell) + 1.0f;
+    for (int neighbor : neighbors) {
+      if (neighbor == -1 || this->world_map_.isOccupied(neighbor) ||
+          g_new >= gCost(neighbor)) {
+        continue;
+      }
+      this->g_cost_[neighbor] = g_new;
+      this->parent_[neighbor] = cell;
+      this->seen_[neighbor] = this->query_;
+      if (this->closed_[neighbor] != this->pass_) {
+        this->open_.push(neighbor, fValue(neighbor));
+      } else if (this->incons_[neighbor] != this->pass_) {
+        this->incons_[neighbor] = this->pass_;
+        this->inconsistent_.push_back(neighbor);
+      }
+    }
+  }
+  return true;
+}
+
+double AnytimePlanner::currentBound() {
+  double goal_cost = gCost(this->goal_index_);
+  double lowest = goal_cost;
+  // the f values of queued cells hold the inflated heuristic, recompute
+  // them with the plain one; the heap storage is scanned in place, so the
+  // open list keeps its order
+  double epsilon = this->epsilon_;
+  this->epsilon_ = 1.0;
+  for (int cell : this->inconsistent_) {
+    lowest = std::min(lowest, fValue(cell));
+  }
+  for (int slot = 0; slot < this->open_.size(); slot++) {
+    lowest = std::min(lowest, fValue(this->open_.at(slot)));
+  }
+  this->epsilon_ = epsilon;
+  if (lowest <= 0.0) {
+    return this->epsilon_;
+  }
+  return std::min(this->epsilon_, goal_cost / lowest);
+}
+
+std::stack<std::pair<int, int>> AnytimePlanner::trackPath() {
+  std::stack<std::pair<int, int>> path;
+  for (int cell = this->goal_index_; cell != this->start_index_;
+       cell = this->parent_[cell]) {
+    path.push(this->world_map_.toPosition(cell));
+  }
+  path.push(this->start_position_);
+  return path;
+}
+
+/* ----------------------------------------------------------------*/
+/**
+ * @brief  Runs weighted astar passes with falling epsilon. Before each
+ *          pass the inconsistent cells join the open list and all queued
+ *          cells are ordered by the new epsilon.
+ *
+ * @param world_map
+ * @param robot_pose
+ * @param goal_pose
+ * @param deadline
+ *
+ * @return best path found in time
+ */
+/* ----------------------------------------------------------------*/
+std::stack<std::pair<int, int>>
+AnytimePlanner::search(const GridView &world_map,
+                       std::pair<int, int> robot_pose,
+                       std::pair<int, int> goal_pose, Deadline deadline) {
+  this->world_map_ = world_map;
+  this->start_position_ = robot_pose;
+  this->goal_position_ = goal_pose;
+  this->start_index_ = world_map.toIndex(robot_pose);
+  this->goal_index_ = world_map.toIndex(goal_pose);
+  this->epsilon_ = this->initial_epsilon_;
+  this->bound_ = std::numeric_limits<double>::infinity();
+  this->completed_searches_ = 0;
+  this->expanded_nodes_ = 0;
+
+  int cells = world_map.getCellCount();
+  if (int(this->seen_.size()) != cells) {
+    this->g_cost_.assign(cells, FLT_MAX);
+    this->parent_.assign(cells, -1);
+    this->seen_.assign(cells, 0);
+    this->closed_.assign(cells, 0);
+    this->incons_.assign(cells, 0);
+    this->open_.resize(cells);
+    this->query_ = 0;
+    this->pass_ = 0;
+  }
+  this->query_++;
+  this->pass_++;
+  this->open_.clear();
+  this->inconsistent_.clear();
+
+  std::stack<std::pair<int, int>> best;
+  best.push(robot_pose);
+  if (!world_map.isInside(robot_pose) || !world_map.isInside(goal_pose) ||
+      world_map.isOccupied(this->start_index_) ||
+      world_map.isOccupied(this->goal_index_)) {
+    return best;
+  }
+  this->g_cost_[this->start_index_] = 0.0f;
+  this->parent_[this->start_index_] = this->start_index_;
+  this->seen_[this->start_index_] = this->query_;
+  this->open_.push(this->start_index_, fValue(this->start_index_));
+
+  while (improvePath(deadline)) {
+    if (gCost(this->goal_index_) == FLT_MAX) {
+      break; // open list ran empty, the goal is unreachable
+    }
+    this->completed_searches_++;
+    best = trackPath();
+    this->bound_ = currentBound();
+    if (this->callback_) {
+      this->callback_(best, this->bound_);
+    }
+    if (this->bound_ <= 1.0 || std::chrono::steady_clock::now() >= deadline) {
+      break;
+    }
+    this->epsilon_ = std::max(1.0, this->epsilon_ - this->epsilon_step_);
+    // next pass: queued and inconsistent cells, keyed with the new epsilon
+    std::vector<int> queued;
+    queued.swap(this->inconsistent_);
+    while (!this->open_.empty()) {
+      queued.push_back(this->open_.pop());
+    }
+    this->pass_++;
+    for (int cell : queued) {
+      this->open_.push(cell, fValue(cell));
+    }
+  }
+  return best;
+}
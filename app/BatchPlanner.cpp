@@ -0,0 +1,155 @@
+/* Copyright (C)
+ * 2019 - Bhargav Dandamudi
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the 'Software'), to deal in the Software without
+ * restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit
+ * persons to whom the Software is furnished to do so,subject to
+ * the following conditions:
+ * The above copyright notice and this permission notice shall
+ * be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED ''AS IS'', WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR
+ * ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM,OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+/**
+ * @file BatchPlanner.cpp
+ * @brief  Batch planning thread pool definitions
+ * @author Bhargav Dandamudi
+ * @version 1
+ * @date 2019-04-16
+ */
+#include "../include/BatchPlanner.h"
+
+/* ----------------------------------------------------------------*/
+/**
+ * @brief  Constructor, starts the workers which then wait for a batch
+ *
+ * @param threads number of workers, 0 for one per hardware thread
+ */
+/* ----------------------------------------------------------------*/
+BatchPlanner::BatchPlanner(int threads)
+    : map_(nullptr), queries_(nullptr), results_(nullptr), next_query_(0),
+      busy_workers_(0), batch_id_(0), stopping_(false) {
+  if (threads <= 0) {
+    threads = std::max(1, int(std::thread::hardware_concurrency()));
+  }
+  this->planners_.resize(threads);
+  for (int i = 0; i < threads; i++) {
+    this->workers_.push_back(std::thread(&BatchPlanner::work, this, i));
+  }
+}
+
+BatchPlanner::~BatchPlanner() {
+  {
+    std::lock_guard<std::mutex> lock(this->mutex_);
+    this->stopping_ = true;
+  }
+  this->start_cv_.notify_all();
+  for (auto &worker : this->workers_) {
+    worker.join();
+  }
+}
+
+/* ----------------------------------------------------------------*/
+/**
+ * @brief  Hands the batch to the workers and waits until all are done
+ *
+ * @param map
+ * @param queries
+ *
+ * @return results in query order
+ */
+/* ----------------------------------------------------------------*/
+std::vector<PlanResult>
+BatchPlanner::planBatch(const GridView &map,
+                        const std::vector<PlanQuery> &queries) {
+  std::lock_guard<std::mutex> batch_lock(this->batch_mutex_);
+  std::vector<PlanResult> results(queries.size());
+  if (queries.empty()) {
+    return results;
+  }
+  {
+    std::lock_guard<std::mutex> lock(this->mutex_);
+    this->map_ = &map;
+    this->queries_ = &queries;
+    this->results_ = &results;
+    this->next_query_ = 0;
+    this->batch_stats_ = SearchStats();
+    this->busy_workers_ = int(this->workers_.size());
+    this->batch_id_++;
+  }
+  this->start_cv_.notify_all();
+  std::unique_lock<std::mutex> lock(this->mutex_);
+  this->done_cv_.wait(lock, [this] { return this->busy_workers_ == 0; });
+  return results;
+}
+
+/* ----------------------------------------------------------------*/
+/**
+ * @brief  Worker loop: waits for a batch, plans queries until none is left
+ *
+ * @param worker index of the worker and of its planner
+ */
+/* ----------------------------------------------------------------*/
+void BatchPlanner::work(int worker) {
+  optimalPlanner &planner = this->planners_[worker];
+  unsigned seen_batch = 0;
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(this->mutex_);
+      this->start_cv_.wait(lock, [this, seen_batch] {
+        return this->stopping_ || this->batch_id_ != seen_batch;
+      });
+      if (this->stopping_) {
+        return;
+      }
+      seen_batch = this->batch_id_;
+    }
+    const std::vector<PlanQuery> &queries = *this->queries_;
+    int query;
+    SearchStats stats;
+    while ((query = this->next_query_.fetch_add(1)) < int(queries.size())) {
+      PlanResult &result = (*this->results_)[query];
+      result = planner.plan(*this->map_, queries[query].first,
+                            queries[query].second);
+      stats += result.stats;
+    }
+    std::lock_guard<std::mutex> lock(this->mutex_);
+    this->batch_stats_ += stats;
+    if (--this->busy_workers_ == 0) {
+      this->done_cv_.notify_one();
+    }
+  }
+}
+
+/* ----------------------------------------------------------------*/
+/**
+ * @brief  Sets the search mode of all worker planners
+ *
+ * @param mode
+ */
+/* ----------------------------------------------------------------*/
+void BatchPlanner::setSearchMode(SearchMode mode) {
+  std::lock_guard<std::mutex> batch_lock(this->batch_mutex_);
+  for (auto &planner : this->planners_) {
+    planner.setSearchMode(mode);
+  }
+}
+
+SearchStats BatchPlanner::getBatchStats() {
+  std::lock_guard<std::mutex> lock(this->mutex_);
+  return this->batch_stats_;
+}
+
+int BatchPlanner::getThreadCount() { return int(this->workers_.size()); }
@@ -0,0 +1,386 @@
+/* Copyright (C)
+ * 2019 - Bhargav Dandamudi
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the 'Software'), to deal in the Software without
+ * restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit
+ * persons to whom the Software is furnished to do so,subject to
+ * the following conditions:
+ * The above copyright notice and this permission notice shall
+ * be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED ''AS IS'', WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR
+ * ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM,OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+/**
+ * @file BitWavefront.cpp
+ * @brief  Definitions of the bit parallel wavefronts
+ * @author Bhargav Dandamudi
+ * @version 1
+ * @date 2019-04-25
+ */
+#include "../include/BitWavefront.h"
+#include <algorithm>
+
+const uint32_t BitWavefront::UNREACHABLE;
+
+BitWavefront::BitWavefront()
+    : height_(0), width_(0), words_per_row_(0), round_(0) {}
+
+BitWavefront::BitWavefront(const GridView &world_map) : BitWavefront() {
+  build(world_map);
+}
+
+/* ----------------------------------------------------------------*/
+/**
+ * @brief  Packs the free cells, bit grids are inverted a word at a time
+ *
+ * @param world_map
+ */
+/* ----------------------------------------------------------------*/
+void BitWavefront::build(const GridView &world_map) {
+  this->world_map_ = world_map;
+  this->height_ = world_map.getHeight();
+  this->width_ = world_map.getWidth();
+  this->words_per_row_ = (this->width_ + 63) / 64;
+  int words = this->height_ * this->words_per_row_;
+  this->free_.assign(words, 0);
+  // bits of the last word in a row which lie inside the map
+  uint64_t last_mask = (this->width_ % 64 == 0)
+                           ? ~uint64_t(0)
+                           : (uint64_t(1) << (this->width_ % 64)) - 1;
+  for (int y = 0; y < this->height_; y++) {
+    uint64_t *row = &this->free_[y * this->words_per_row_];
+    if (world_map.getStorage() == CellStorage::BIT) {
+      const uint64_t *occupied =
+          world_map.getWords() + y * world_map.getStride();
+      for (int w = 0; w < this->words_per_row_; w++) {
+        row[w] = ~occupied[w];
+      }
+    } else {
+      for (int x = 0; x < this->width_; x++) {
+        if (!world_map.isOccupied(std::make_pair(y, x))) {
+          row[x >> 6] |= uint64_t(1) << (x & 63);
+        }
+      }
+    }
+    if (this->words_per_row_ > 0) {
+      row[this->words_per_row_ - 1] &= last_mask;
+    }
+  }
+  this->reached_.assign(words, 0);
+  this->layer_.assign(words, 0);
+  this->next_.assign(words, 0);
+  this->computed_.assign(words, 0);
+  this->round_ = 0;
+}
+
+void BitWavefront::updateCells(
+    const std::vector<std::pair<int, int>> &cells) {
+  for (const auto &cell : cells) {
+    if (this->world_map_.isInside(cell)) {
+      setFree(cell, !this->world_map_.isOccupied(cell));
+    }
+  }
+}
+
+bool BitWavefront::isFree(std::pair<int, int> position) const {
+  if (position.first < 0 || position.second < 0 ||
+      position.first >= this->height_ || position.second >= this->width_) {
+    return false;
+  }
+  uint64_t word = this->free_[position.first * this->words_per_row_ +
+                              (position.second >> 6)];
+  return (word >> (position.second & 63)) & 1u;
+}
+
+void BitWavefront::setFree(std::pair<int, int> position, bool free) {
+  if (position.first < 0 || position.second < 0 ||
+      position.first >= this->height_ || position.second >= this->width_) {
+    return;
+  }
+  uint64_t &word = this->free_[position.first * this->words_per_row_ +
+                               (position.second >> 6)];
+  uint64_t bit = uint64_t(1) << (position.second & 63);
+  if (free) {
+    word |= bit;
+  } else {
+    word &= ~bit;
+  }
+}
+
+bool BitWavefront::isReachable(std::pair<int, int> start,
+                               std::pair<int, int> target) {
+  if (!isFree(start) || !isFree(target)) {
+    return false;
+  }
+  return flood(start, target.first * this->width_ + target.second);
+}
+
+int BitWavefront::getDistance(std::pair<int, int> start,
+                              std::pair<int, int> target) {
+  if (!isFree(start) || !isFree(target)) {
+    return -1;
+  }
+  return wavefront(start, target.first * this->width_ + target.second,
+                   nullptr);
+}
+
+std::size_t BitWavefront::getMemoryUsage() const {
+  std::size_t words = this->free_.capacity() + this->reached_.capacity() +
+                      this->layer_.capacity() + this->next_.capacity() +
+                      this->pending_.capacity() * 2;
+  std::size_t ints = this->active_.capacity() +
+                     this->next_active_.capacity() +
+                     this->touched_.capacity() + this->computed_.capacity();
+  return words * sizeof(uint64_t) + ints * sizeof(uint32_t);
+}
+
+int BitWavefront::distances(std::pair<int, int> goal,
+                            std::vector<uint32_t> &distance) {
+  distance.assign(std::size_t(this->height_) * std::size_t(this->width_),
+                  UNREACHABLE);
+  if (!isFree(goal)) {
+    return 0;
+  }
+  return wavefront(goal, -1, distance.data());
+}
+
+// cells of x and the cells reached from them through runs of set bits of
+// m towards higher (fillUp) or lower (fillDown) bits, Kogge-Stone steps
+static uint64_t fillUp(uint64_t x, uint64_t m) {
+  x |= m & (x << 1);
+  m &= m << 1;
+  x |= m & (x << 2);
+  m &= m << 2;
+  x |= m & (x << 4);
+  m &= m << 4;
+  x |= m & (x << 8);
+  m &= m << 8;
+  x |= m & (x << 16);
+  m &= m << 16;
+  return x | (m & (x << 32));
+}
+
+static uint64_t fillDown(uint64_t x, uint64_t m) {
+  x |= m & (x >> 1);
+  m &= m >> 1;
+  x |= m & (x >> 2);
+  m &= m >> 2;
+  x |= m & (x >> 4);
+  m &= m >> 4;
+  x |= m & (x >> 8);
+  m &= m >> 8;
+  x |= m & (x >> 16);
+  m &= m >> 16;
+  return x | (m & (x >> 32));
+}
+
+/* ----------------------------------------------------------------*/
+/**
+ * @brief  Flood fill without layers. A word taking new cells fills the
+ *          free runs through them at once and hands its new cells on to
+ *          the words above and below, and the end bits to the words left
+ *          and right. A word is visited again only when a neighbor brings
+ *          it new cells, far fewer times than the layers crossing it.
+ *
+ * @param source
+ * @param target cell index
+ *
+ * @return true once the target is reached
+ */
+/* ----------------------------------------------------------------*/
+bool BitWavefront::flood(std::pair<int, int> source, int target) {
+  int stride = this->words_per_row_;
+  int last_row = this->height_ - 1;
+  int target_y = target / this->width_;
+  int target_x = target % this->width_;
+  int target_word = target_y * stride + (target_x >> 6);
+  uint64_t target_bit = uint64_t(1) << (target_x & 63);
+
+  for (int word : this->touched_) {
+    this->reached_[word] = 0;
+  }
+  this->touched_.clear();
+  // words with the cells they were handed, as (row, column, cells)
+  std::vector<std::pair<std::pair<int, int>, uint64_t>> &pending =
+      this->pending_;
+  pending.clear();
+  pending.push_back(std::make_pair(
+      std::make_pair(source.first, source.second >> 6),
+      uint64_t(1) << (source.second & 63)));
+  while (!pending.empty()) {
+    int row = pending.back().first.first;
+    int column = pending.back().first.second;
+    uint64_t seed = pending.back().second;
+    pending.pop_back();
+    int word = row * stride + column;
+    uint64_t open = this->free_[word] & ~this->reached_[word];
+    seed &= open;
+    if (seed == 0) {
+      continue;
+    }
+    uint64_t fresh = fillUp(seed, open) | fillDown(seed, open);
+    if (this->reached_[word] == 0) {
+      this->touched_.push_back(word);
+    }
+    this->reached_[word] |= fresh;
+    if (word == target_word && (fresh & target_bit) != 0) {
+      return true;
+    }
+    if (row > 0) {
+      pending.push_back(std::make_pair(std::make_pair(row - 1, column), fresh));
+    }
+    if (row < last_row) {
+      pending.push_back(std::make_pair(std::make_pair(row + 1, column), fresh));
+    }
+    if (column > 0 && (fresh & 1u) != 0) {
+      pending.push_back(
+          std::make_pair(std::make_pair(row, column - 1), uint64_t(1) << 63));
+    }
+    if (column < stride - 1 && (fresh >> 63) != 0) {
+      pending.push_back(
+          std::make_pair(std::make_pair(row, column + 1), uint64_t(1)));
+    }
+  }
+  return false;
+}
+
+/* ----------------------------------------------------------------*/
+/**
+ * @brief  Layer loop. Every word next to a nonzero word of the layer is
+ *          computed once per layer (computed_ keeps the round it was done
+ *          in): its new cells are the layer words around it shifted onto
+ *          it, masked with the free cells not reached yet.
+ *
+ * @param source
+ * @param target cell index or -1
+ * @param distance
+ *
+ * @return layer of the target, -1 if not reached, or the reached cells
+ */
+/* ----------------------------------------------------------------*/
+int BitWavefront::wavefront(std::pair<int, int> source, int target,
+                            uint32_t *distance) {
+  int stride = this->words_per_row_;
+  int last_row = this->height_ - 1;
+  int target_word = -1;
+  uint64_t target_bit = 0;
+  if (target >= 0) {
+    int y = target / this->width_;
+    int x = target % this->width_;
+    target_word = y * stride + (x >> 6);
+    target_bit = uint64_t(1) << (x & 63);
+  }
+
+  // forget the cells of the previous query
+  for (int word : this->touched_) {
+    this->reached_[word] = 0;
+  }
+  this->touched_.clear();
+  this->active_.clear();
+
+  int source_word = source.first * stride + (source.second >> 6);
+  uint64_t source_bit = uint64_t(1) << (source.second & 63);
+  this->layer_[source_word] = source_bit;
+  this->reached_[source_word] = source_bit;
+  this->touched_.push_back(source_word);
+  this->active_.push_back(source_word);
+  if (distance != nullptr) {
+    distance[source.first * this->width_ + source.second] = 0;
+  }
+  int reached = 1;
+  int result = -1;
+  if (source_word == target_word && source_bit == target_bit) {
+    result = 0;
+  }
+
+  uint32_t layer = 0;
+  while (result < 0 && !this->active_.empty()) {
+    layer++;
+    if (++this->round_ == 0) {
+      // the round counter wrapped, old marks could look current
+      std::fill(this->computed_.begin(), this->computed_.end(), 0);
+      this->round_ = 1;
+    }
+    this->next_active_.clear();
+    for (int word : this->active_) {
+      int row = word / stride;
+      int column = word - row * stride;
+      // the word itself and its four neighbor words, as (row, column)
+      int candidates[5][2] = {{row, column},
+                              {row, column - 1},
+                              {row, column + 1},
+                              {row - 1, column},
+                              {row + 1, column}};
+      for (const auto &candidate : candidates) {
+        int c_row = candidate[0];
+        int c_column = candidate[1];
+        if (c_row < 0 || c_row > last_row || c_column < 0 ||
+            c_column >= stride) {
+          continue;
+        }
+        int c = c_row * stride + c_column;
+        if (this->computed_[c] == this->round_) {
+          continue;
+        }
+        this->computed_[c] = this->round_;
+        uint64_t center = this->layer_[c];
+        uint64_t grown = center | (center << 1) | (center >> 1);
+        if (c_column > 0) {
+          grown |= this->layer_[c - 1] >> 63;
+        }
+        if (c_column < stride - 1) {
+          grown |= this->layer_[c + 1] << 63;
+        }
+        if (c_row > 0) {
+          grown |= this->layer_[c - stride];
+        }
+        if (c_row < last_row) {
+          grown |= this->layer_[c + stride];
+        }
+        uint64_t fresh = grown & this->free_[c] & ~this->reached_[c];
+        if (fresh == 0) {
+          continue;
+        }
+        this->next_[c] = fresh;
+        if (this->reached_[c] == 0) {
+          this->touched_.push_back(c);
+        }
+        this->reached_[c] |= fresh;
+        this->next_active_.push_back(c);
+        reached += __builtin_popcountll(fresh);
+        if (distance != nullptr) {
+          int base = c_row * this->width_ + c_column * 64;
+          for (uint64_t bits = fresh; bits != 0; bits &= bits - 1) {
+            distance[base + __builtin_ctzll(bits)] = layer;
+          }
+        }
+        if (c == target_word && (fresh & target_bit) != 0) {
+          result = int(layer);
+        }
+      }
+    }
+    for (int word : this->active_) {
+      this->layer_[word] = 0;
+    }
+    this->layer_.swap(this->next_);
+    this->active_.swap(this->next_active_);
+  }
+  // leave the layer buffers clear for the next query
+  for (int word : this->active_) {
+    this->layer_[word] = 0;
+  }
+  this->active_.clear();
+  return target >= 0 ? result : reached;
+}
@@ -0,0 +1,254 @@
+/* Copyright (C)
+ * 2019 - Bhargav Dandamudi
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the 'Software'), to deal in the Software without
+ * restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit
+ * persons to whom the Software is furnished to do so,subject to
+ * the following conditions:
+ * The above copyright notice and this permission notice shall
+ * be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED ''AS IS'', WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR
+ * ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM,OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+/**
+ * @file ComponentIndex.cpp
+ * @brief  Union-find labelling and incremental relabelling of regions
+ * @author Bhargav Dandamudi
+ * @version 1
+ * @date 2019-04-20
+ */
+#include "../include/ComponentIndex.h"
+#include <algorithm>
+
+ComponentIndex::ComponentIndex() : component_count_(0), version_(0) {}
+
+ComponentIndex::ComponentIndex(const GridView &world_map)
+    : component_count_(0), version_(0) {
+  build(world_map);
+}
+
+int ComponentIndex::findRoot(std::vector<int> &parents, int cell) {
+  while (parents[cell] != cell) {
+    parents[cell] = parents[parents[cell]];
+    cell = parents[cell];
+  }
+  return cell;
+}
+
+/* ----------------------------------------------------------------*/
+/**
+ * @brief  First pass joins every free cell with its free top and left
+ *          neighbor, the second pass turns the roots into dense labels
+ *
+ * @param world_map
+ */
+/* ----------------------------------------------------------------*/
+void ComponentIndex::build(const GridView &world_map) {
+  this->world_map_ = world_map;
+  this->version_ = world_map.getVersion();
+  int width = world_map.getWidth();
+  int cells = world_map.getCellCount();
+  std::vector<int> parents(cells);
+  for (int i = 0; i < cells; i++) {
+    parents[i] = i;
+    if (world_map.isOccupied(i)) {
+      continue;
+    }
+    if (i >= width && !world_map.isOccupied(i - width)) {
+      parents[findRoot(parents, i)] = findRoot(parents, i - width);
+    }
+    if (i % width > 0 && !world_map.isOccupied(i - 1)) {
+      int a = findRoot(parents, i);
+      int b = findRoot(parents, i - 1);
+      if (a != b) {
+        parents[a] = b;
+      }
+    }
+  }
+  this->labels_.assign(cells, -1);
+  this->sizes_.clear();
+  this->free_labels_.clear();
+  this->component_count_ = 0;
+  std::vector<int> root_labels(cells, -1);
+  for (int i = 0; i < cells; i++) {
+    if (world_map.isOccupied(i)) {
+      continue;
+    }
+    int root = findRoot(parents, i);
+    if (root_labels[root] == -1) {
+      root_labels[root] = newLabel(0);
+    }
+    this->labels_[i] = root_labels[root];
+    this->sizes_[root_labels[root]]++;
+  }
+}
+
+int ComponentIndex::newLabel(int size) {
+  this->component_count_++;
+  if (!this->free_labels_.empty()) {
+    int label = this->free_labels_.back();
+    this->free_labels_.pop_back();
+    this->sizes_[label] = size;
+    return label;
+  }
+  this->sizes_.push_back(size);
+  return int(this->sizes_.size()) - 1;
+}
+
+void ComponentIndex::retireLabel(int label) {
+  this->sizes_[label] = 0;
+  this->free_labels_.push_back(label);
+  this->component_count_--;
+}
+
+int ComponentIndex::findNeighbors(int cell, int *neighbors) const {
+  int width = this->world_map_.getWidth();
+  int y = cell / width;
+  int x = cell % width;
+  int count = 0;
+  if (y > 0) {
+    neighbors[count++] = cell - width;
+  }
+  if (x > 0) {
+    neighbors[count++] = cell - 1;
+  }
+  if (y < this->world_map_.getHeight() - 1) {
+    neighbors[count++] = cell + width;
+  }
+  if (x < width - 1) {
+    neighbors[count++] = cell + 1;
+  }
+  return count;
+}
+
+int ComponentIndex::flood(int source, int label) {
+  int neighbors[4];
+  this->queue_.clear();
+  this->queue_.push_back(source);
+  this->replaced_.clear();
+  this->labels_[source] = label;
+  for (size_t head = 0; head < this->queue_.size(); head++) {
+    int count = findNeighbors(this->queue_[head], neighbors);
+    for (int i = 0; i < count; i++) {
+      int old_label = this->labels_[neighbors[i]];
+      if (old_label != label && !this->world_map_.isOccupied(neighbors[i])) {
+        if (old_label != -1 &&
+            std::find(this->replaced_.begin(), this->replaced_.end(),
+                      old_label) == this->replaced_.end()) {
+          this->replaced_.push_back(old_label);
+        }
+        this->labels_[neighbors[i]] = label;
+        this->queue_.push_back(neighbors[i]);
+      }
+    }
+  }
+  return int(this->queue_.size());
+}
+
+/* ----------------------------------------------------------------*/
+/**
+ * @brief  Blocked cells are handled first: they lose their label and their
+ *          old region is marked dirty. Freed cells then merge the clean
+ *          regions around them into the largest one. Finally whatever is
+ *          left of a dirty region is flooded again from the neighbors of
+ *          the blocked cells, one new label per part, in case it was split.
+ *          Cells outside the map are skipped.
+ *
+ * @param cells changed cell locations
+ * @param version
+ */
+/* ----------------------------------------------------------------*/
+void ComponentIndex::updateCells(const std::vector<std::pair<int, int>> &cells,
+                                 uint64_t version) {
+  this->version_ = version;
+  std::vector<int> blocked;
+  std::vector<int> dirty;
+  for (const auto &position : cells) {
+    if (!this->world_map_.isInside(position)) {
+      continue;
+    }
+    int cell = this->world_map_.toIndex(position);
+    int label = this->labels_[cell];
+    if (this->world_map_.isOccupied(cell) && label != -1) {
+      this->labels_[cell] = -1;
+      blocked.push_back(cell);
+      if (std::find(dirty.begin(), dirty.end(), label) == dirty.end()) {
+        dirty.push_back(label);
+      }
+    }
+  }
+  int neighbors[4];
+  for (const auto &position : cells) {
+    if (!this->world_map_.isInside(position)) {
+      continue;
+    }
+    int cell = this->world_map_.toIndex(position);
+    // skips cells which are blocked or already reached by an earlier flood
+    if (this->world_map_.isOccupied(cell) || this->labels_[cell] != -1) {
+      continue;
+    }
+    int count = findNeighbors(cell, neighbors);
+    int keep = -1;
+    for (int i = 0; i < count; i++) {
+      int label = this->labels_[neighbors[i]];
+      if (label != -1 &&
+          std::find(dirty.begin(), dirty.end(), label) == dirty.end() &&
+          (keep == -1 || this->sizes_[label] > this->sizes_[keep])) {
+        keep = label;
+      }
+    }
+    if (keep == -1) {
+      keep = newLabel(0);
+    }
+    // the flood may run through other freed cells into regions which are
+    // not next to this one, every clean region it swallows is retired
+    this->sizes_[keep] += flood(cell, keep);
+    for (int label : this->replaced_) {
+      if (std::find(dirty.begin(), dirty.end(), label) == dirty.end()) {
+        retireLabel(label);
+      }
+    }
+  }
+  for (int cell : blocked) {
+    int count = findNeighbors(cell, neighbors);
+    for (int i = 0; i < count; i++) {
+      int label = this->labels_[neighbors[i]];
+      if (label != -1 &&
+          std::find(dirty.begin(), dirty.end(), label) != dirty.end()) {
+        int fresh = newLabel(0);
+        this->sizes_[fresh] = flood(neighbors[i], fresh);
+      }
+    }
+  }
+  // retired last, so none of the new parts got a dirty label back
+  for (int label : dirty) {
+    retireLabel(label);
+  }
+}
+
+bool ComponentIndex::matches(const GridView &world_map) const {
+  return this->version_ != 0 && this->version_ == world_map.getVersion() &&
+         this->world_map_.getHeight() == world_map.getHeight() &&
+         this->world_map_.getWidth() == world_map.getWidth();
+}
+
+bool ComponentIndex::isConnected(std::pair<int, int> a,
+                                 std::pair<int, int> b) const {
+  if (!this->world_map_.isInside(a) || !this->world_map_.isInside(b)) {
+    return false;
+  }
+  int label = this->labels_[this->world_map_.toIndex(a)];
+  return label != -1 && label == this->labels_[this->world_map_.toIndex(b)];
+}
@@ -0,0 +1,192 @@
+/* Copyright (C)
+ * 2019 - Bhargav Dandamudi
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the 'Software'), to deal in the Software without
+ * restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit
+ * persons to whom the Software is furnished to do so,subject to
+ * the following conditions:
+ * The above copyright notice and this permission notice shall
+ * be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED ''AS IS'', WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR
+ * ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM,OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+/**
+ * @file CostMap.cpp
+ * @brief  Vectorized cost updates, inflation and lowest cost tracking
+ * @author Bhargav Dandamudi
+ * @version 1
+ * @date 2019-04-23
+ */
+#include "../include/CostMap.h"
+#include <algorithm>
+#include <cstring>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+const uint8_t CostMap::LETHAL;
+
+CostMap::CostMap() : height_(0), width_(0), min_cost_(LETHAL) {}
+
+CostMap::CostMap(int height, int width, uint8_t cost)
+    : height_(height), width_(width), min_cost_(cost),
+      costs_(size_t(height) * width, cost) {}
+
+// out[i] = max(out[i], value) for count bytes
+static void maxRow(uint8_t *out, uint8_t value, int count) {
+  int i = 0;
+#ifdef __SSE2__
+  __m128i fill = _mm_set1_epi8(char(value));
+  for (; i + 16 <= count; i += 16) {
+    __m128i *slot = reinterpret_cast<__m128i *>(out + i);
+    _mm_storeu_si128(slot, _mm_max_epu8(_mm_loadu_si128(slot), fill));
+  }
+#endif
+  for (; i < count; i++) {
+    out[i] = std::max(out[i], value);
+  }
+}
+
+// lowest byte of count bytes
+static uint8_t minRow(const uint8_t *row, int count, uint8_t lowest) {
+  int i = 0;
+#ifdef __SSE2__
+  __m128i low = _mm_set1_epi8(char(lowest));
+  for (; i + 16 <= count; i += 16) {
+    low = _mm_min_epu8(
+        low, _mm_loadu_si128(reinterpret_cast<const __m128i *>(row + i)));
+  }
+  uint8_t lanes[16];
+  _mm_storeu_si128(reinterpret_cast<__m128i *>(lanes), low);
+  lowest = *std::min_element(lanes, lanes + 16);
+#endif
+  for (; i < count; i++) {
+    lowest = std::min(lowest, row[i]);
+  }
+  return lowest;
+}
+
+void CostMap::updateMinCost() {
+  this->min_cost_ = minRow(this->costs_.data(), int(this->costs_.size()),
+                           LETHAL);
+}
+
+void CostMap::setCost(int index, uint8_t cost) {
+  uint8_t old_cost = this->costs_[index];
+  this->costs_[index] = cost;
+  if (cost < this->min_cost_) {
+    this->min_cost_ = cost;
+  } else if (old_cost == this->min_cost_ && cost > old_cost) {
+    updateMinCost(); // the lowest cell may have been this one
+  }
+}
+
+void CostMap::fill(std::pair<int, int> corner, int height, int width,
+                   uint8_t cost) {
+  for (int y = corner.first; y < corner.first + height; y++) {
+    std::memset(&this->costs_[size_t(y) * this->width_ + corner.second], cost,
+                width);
+  }
+  updateMinCost();
+}
+
+void CostMap::raise(std::pair<int, int> corner, int height, int width,
+                    uint8_t cost) {
+  for (int y = corner.first; y < corner.first + height; y++) {
+    maxRow(&this->costs_[size_t(y) * this->width_ + corner.second], cost,
+           width);
+  }
+  updateMinCost();
+}
+
+/* ----------------------------------------------------------------*/
+/**
+ * @brief  Grows a proximity grid out of the lethal cells, one Manhattan
+ *          step per round: every cell takes the largest of itself and its
+ *          four neighbors minus decay (saturating). Rows are padded with
+ *          zero guard bytes so the shifted loads need no edge cases. At the
+ *          end every cell is raised to its proximity, capped at 254.
+ *
+ * @param radius
+ * @param decay
+ */
+/* ----------------------------------------------------------------*/
+void CostMap::inflate(int radius, uint8_t decay) {
+  const int guard = 16;
+  int stride = this->width_ + 2 * guard;
+  // guard rows above and below, guard bytes left and right of every row
+  std::vector<uint8_t> proximity(size_t(this->height_ + 2) * stride, 0);
+  std::vector<uint8_t> next(proximity.size(), 0);
+  for (int y = 0; y < this->height_; y++) {
+    const uint8_t *row = &this->costs_[size_t(y) * this->width_];
+    uint8_t *out = &proximity[size_t(y + 1) * stride + guard];
+    for (int x = 0; x < this->width_; x++) {
+      out[x] = row[x] == LETHAL ? LETHAL : 0;
+    }
+  }
+  for (int round = 0; round < radius; round++) {
+    for (int y = 1; y <= this->height_; y++) {
+      const uint8_t *center = &proximity[size_t(y) * stride + guard];
+      const uint8_t *up = center - stride;
+      const uint8_t *down = center + stride;
+      uint8_t *out = &next[size_t(y) * stride + guard];
+      int x = 0;
+#ifdef __SSE2__
+      __m128i step = _mm_set1_epi8(char(decay));
+      for (; x + 16 <= this->width_; x += 16) {
+        __m128i around = _mm_max_epu8(
+            _mm_max_epu8(
+                _mm_loadu_si128(reinterpret_cast<const __m128i *>(up + x)),
+                _mm_loadu_si128(reinterpret_cast<const __m128i *>(down + x))),
+            _mm_max_epu8(
+                _mm_loadu_si128(
+                    reinterpret_cast<const __m128i *>(center + x - 1)),
+                _mm_loadu_si128(
+                    reinterpret_cast<const __m128i *>(center + x + 1))));
+        __m128i value = _mm_max_epu8(
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(center + x)),
+            _mm_subs_epu8(around, step));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out + x), value);
+      }
+#endif
+      for (; x < this->width_; x++) {
+        int around = std::max(std::max(up[x], down[x]),
+                              std::max(center[x - 1], center[x + 1]));
+        out[x] =
+            uint8_t(std::max(int(center[x]), std::max(0, around - decay)));
+      }
+    }
+    proximity.swap(next);
+  }
+  // lethal cells have proximity 255, capping at 254 leaves them lethal
+  for (int y = 0; y < this->height_; y++) {
+    uint8_t *row = &this->costs_[size_t(y) * this->width_];
+    const uint8_t *near = &proximity[size_t(y + 1) * stride + guard];
+    int x = 0;
+#ifdef __SSE2__
+    __m128i cap = _mm_set1_epi8(char(LETHAL - 1));
+    for (; x + 16 <= this->width_; x += 16) {
+      __m128i *slot = reinterpret_cast<__m128i *>(row + x);
+      __m128i raised = _mm_min_epu8(
+          _mm_loadu_si128(reinterpret_cast<const __m128i *>(near + x)), cap);
+      _mm_storeu_si128(slot, _mm_max_epu8(_mm_loadu_si128(slot), raised));
+    }
+#endif
+    for (; x < this->width_; x++) {
+      row[x] = std::max(row[x], std::min(near[x], uint8_t(LETHAL - 1)));
+    }
+  }
+  updateMinCost();
+}
@@ -0,0 +1,229 @@
+/* Copyright (C)
+ * 2019 - Bhargav Dandamudi
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the 'Software'), to deal in the Software without
+ * restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit
+ * persons to whom the Software is furnished to do so,subject to
+ * the following conditions:
+ * The above copyright notice and this permission notice shall
+ * be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED ''AS IS'', WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR
+ * ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM,OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+/**
+ * @file FlowField.cpp
+ * @brief  Definitions of the goal distance and next step field
+ * @author Bhargav Dandamudi
+ * @version 1
+ * @date 2019-04-24
+ */
+#include "../include/FlowField.h"
+#include "../include/Neighborhood.h"
+#include <algorithm>
+#include <thread>
+
+const uint32_t FlowField::UNREACHABLE;
+const uint8_t FlowField::NO_STEP;
+
+// cells of the current layer a thread takes at once
+static const int CHUNK = 256;
+
+FlowField::FlowField()
+    : height_(0), width_(0), goal_(-1, -1), map_(nullptr), next_chunk_(0),
+      next_row_(0), arrived_(0), barrier_round_(0) {}
+
+/* ----------------------------------------------------------------*/
+/**
+ * @brief  Runs the wavefront from the goal on all threads, then stores the
+ *          step towards a neighbor one layer closer for every cell
+ *
+ * @param map
+ * @param goal
+ * @param threads
+ */
+/* ----------------------------------------------------------------*/
+void FlowField::build(const GridView &map, std::pair<int, int> goal,
+                      int threads) {
+  int cells = map.getCellCount();
+  this->height_ = map.getHeight();
+  this->width_ = map.getWidth();
+  this->goal_ = goal;
+  // atomics can not be copied, a new vector replaces the old one
+  std::vector<std::atomic<uint32_t>> distance(cells);
+  this->distance_.swap(distance);
+  for (int i = 0; i < cells; i++) {
+    this->distance_[i].store(UNREACHABLE, std::memory_order_relaxed);
+  }
+  this->direction_.assign(cells, NO_STEP);
+  if (!map.isInside(goal) || map.isOccupied(goal)) {
+    return;
+  }
+
+  if (threads <= 0) {
+    threads = std::max(1, int(std::thread::hardware_concurrency()));
+  }
+  this->map_ = &map;
+  this->layer_.assign(1, map.toIndex(goal));
+  this->distance_[this->layer_[0]].store(0, std::memory_order_relaxed);
+  this->next_layer_.assign(threads, std::vector<int>());
+  this->next_chunk_ = 0;
+  this->next_row_ = 0;
+  this->arrived_ = 0;
+  this->barrier_round_ = 0;
+
+  std::vector<std::thread> workers;
+  for (int t = 1; t < threads; t++) {
+    workers.push_back(std::thread(&FlowField::grow, this, t, threads));
+  }
+  grow(0, threads);
+  for (auto &worker : workers) {
+    worker.join();
+  }
+  this->map_ = nullptr;
+  this->layer_ = std::vector<int>();
+  this->next_layer_.clear();
+}
+
+/* ----------------------------------------------------------------*/
+/**
+ * @brief  Expands chunks of the current layer until it is used up. After
+ *          every layer the threads meet at a barrier, thread 0 joins the
+ *          cells found into the next layer and a second barrier releases
+ *          all threads onto it. Once the wavefront is done the rows are
+ *          shared out the same way for the next step pass.
+ *
+ * @param thread index of the calling thread, 0 is the caller of build
+ * @param threads number of threads in the loop
+ */
+/* ----------------------------------------------------------------*/
+void FlowField::grow(int thread, int threads) {
+  // spins until all threads arrived, the last one opens the next round
+  auto barrier = [this, threads]() {
+    int round = this->barrier_round_.load();
+    if (this->arrived_.fetch_add(1) == threads - 1) {
+      this->arrived_.store(0);
+      this->barrier_round_.fetch_add(1);
+      return;
+    }
+    while (this->barrier_round_.load() == round) {
+      std::this_thread::yield();
+    }
+  };
+  const GridView &map = *this->map_;
+  std::vector<int> &found = this->next_layer_[thread];
+  uint32_t layer_distance = 0;
+
+  while (true) {
+    int layer_size = int(this->layer_.size());
+    int begin;
+    while ((begin = this->next_chunk_.fetch_add(CHUNK)) < layer_size) {
+      int end = std::min(begin + CHUNK, layer_size);
+      for (int i = begin; i < end; i++) {
+        std::pair<int, int> cell = map.toPosition(this->layer_[i]);
+        for (int k = 0; k < FourConnected::SIZE; k++) {
+          std::pair<int, int> neighbor(cell.first + FourConnected::DY[k],
+                                       cell.second + FourConnected::DX[k]);
+          if (!map.isInside(neighbor) || map.isOccupied(neighbor)) {
+            continue;
+          }
+          int index = map.toIndex(neighbor);
+          uint32_t unreached = UNREACHABLE;
+          if (this->distance_[index].load(std::memory_order_relaxed) ==
+                  UNREACHABLE &&
+              this->distance_[index].compare_exchange_strong(
+                  unreached, layer_distance + 1, std::memory_order_relaxed)) {
+            found.push_back(index);
+          }
+        }
+      }
+    }
+    barrier();
+    if (thread == 0) {
+      this->layer_.clear();
+      for (auto &cells : this->next_layer_) {
+        this->layer_.insert(this->layer_.end(), cells.begin(), cells.end());
+        cells.clear();
+      }
+      this->next_chunk_ = 0;
+    }
+    barrier();
+    layer_distance++;
+    if (this->layer_.empty()) {
+      break;
+    }
+  }
+
+  // every reached cell but the goal has a neighbor one step closer
+  int row;
+  while ((row = this->next_row_.fetch_add(1)) < this->height_) {
+    for (int x = 0; x < this->width_; x++) {
+      int index = row * this->width_ + x;
+      uint32_t distance =
+          this->distance_[index].load(std::memory_order_relaxed);
+      if (distance == UNREACHABLE || distance == 0) {
+        continue;
+      }
+      for (int k = 0; k < FourConnected::SIZE; k++) {
+        std::pair<int, int> neighbor(row + FourConnected::DY[k],
+                                     x + FourConnected::DX[k]);
+        if (map.isInside(neighbor) &&
+            this->distance_[map.toIndex(neighbor)].load(
+                std::memory_order_relaxed) == distance - 1) {
+          this->direction_[index] = uint8_t(k);
+          break;
+        }
+      }
+    }
+  }
+}
+
+std::stack<std::pair<int, int>>
+FlowField::path(std::pair<int, int> start) const {
+  std::stack<std::pair<int, int>> path;
+  if (getDistance(start) == UNREACHABLE) {
+    path.push(start);
+    return path;
+  }
+  // walk to the goal first, the stack is popped from the start
+  std::vector<std::pair<int, int>> steps(1, start);
+  while (steps.back() != this->goal_) {
+    steps.push_back(nextStep(steps.back()));
+  }
+  for (auto it = steps.rbegin(); it != steps.rend(); ++it) {
+    path.push(*it);
+  }
+  return path;
+}
+
+uint32_t FlowField::getDistance(std::pair<int, int> position) const {
+  if (position.first < 0 || position.second < 0 ||
+      position.first >= this->height_ || position.second >= this->width_) {
+    return UNREACHABLE;
+  }
+  return this->distance_[position.first * this->width_ + position.second].load(
+      std::memory_order_relaxed);
+}
+
+std::pair<int, int> FlowField::nextStep(std::pair<int, int> position) const {
+  if (getDistance(position) == UNREACHABLE) {
+    return position;
+  }
+  uint8_t k = this->direction_[position.first * this->width_ + position.second];
+  if (k == NO_STEP) {
+    return position;
+  }
+  return std::make_pair(position.first + FourConnected::DY[k],
+                        position.second + FourConnected::DX[k]);
+}
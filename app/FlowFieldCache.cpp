@@ -0,0 +1,123 @@
+/* Copyright (C)
+ * 2019 - Bhargav Dandamudi
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the 'Software'), to deal in the Software without
+ * restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit
+ * persons to whom the Software is furnished to do so,subject to
+ * the following conditions:
+ * The above copyright notice and this permission notice shall
+ * be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED ''AS IS'', WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR
+ * ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM,OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+/**
+ * @file FlowFieldCache.cpp
+ * @brief  Definitions of the flow field cache
+ * @author Bhargav Dandamudi
+ * @version 1
+ * @date 2019-04-24
+ */
+#include "../include/FlowFieldCache.h"
+#include <algorithm>
+
+FlowFieldCache::FlowFieldCache(int capacity, int threads)
+    : capacity_(std::max(1, capacity)), threads_(threads), builds_(0) {}
+
+/* ----------------------------------------------------------------*/
+/**
+ * @brief  Looks the goal up, moves a current field to the front and
+ *          replaces a field of an older map version in place. The field is
+ *          built with the cache unlocked; callers wanting the same goal
+ *          meanwhile wait for that build. A build which throws hands the
+ *          exception to them and drops its entry, so the next call builds
+ *          again.
+ *
+ * @param map
+ * @param goal
+ *
+ * @return flow field
+ */
+/* ----------------------------------------------------------------*/
+std::shared_ptr<const FlowField>
+FlowFieldCache::get(const GridView &map, std::pair<int, int> goal) {
+  uint64_t version = map.getVersion();
+  std::unique_lock<std::mutex> lock(this->mutex_);
+  auto entry = this->entries_.begin();
+  while (entry != this->entries_.end() && entry->goal != goal) {
+    ++entry;
+  }
+  if (entry != this->entries_.end()) {
+    this->entries_.splice(this->entries_.begin(), this->entries_, entry);
+    if (version != 0 && entry->version == version &&
+        entry->height == map.getHeight() &&
+        entry->width == map.getWidth()) {
+      std::shared_future<std::shared_ptr<const FlowField>> field =
+          entry->field;
+      lock.unlock();
+      return field.get();
+    }
+  } else {
+    if (int(this->entries_.size()) == this->capacity_) {
+      this->entries_.pop_back();
+    }
+    this->entries_.push_front(Entry());
+    entry = this->entries_.begin();
+    entry->goal = goal;
+  }
+  // fields already handed out keep the old version, a new one is built
+  std::promise<std::shared_ptr<const FlowField>> built;
+  entry->height = map.getHeight();
+  entry->width = map.getWidth();
+  entry->version = version;
+  entry->field = built.get_future().share();
+  int build = ++this->builds_;
+  entry->build = build;
+  lock.unlock();
+
+  std::shared_ptr<FlowField> field;
+  try {
+    field = std::make_shared<FlowField>();
+    field->build(map, goal, this->threads_);
+  } catch (...) {
+    built.set_exception(std::current_exception());
+    lock.lock();
+    // the entry may have been rebuilt or dropped meanwhile
+    for (auto failed = this->entries_.begin(); failed != this->entries_.end();
+         ++failed) {
+      if (failed->goal == goal && failed->build == build) {
+        this->entries_.erase(failed);
+        break;
+      }
+    }
+    throw;
+  }
+  built.set_value(field);
+  return field;
+}
+
+void FlowFieldCache::clear() {
+  std::lock_guard<std::mutex> lock(this->mutex_);
+  this->entries_.clear();
+}
+
+int FlowFieldCache::size() {
+  std::lock_guard<std::mutex> lock(this->mutex_);
+  return int(this->entries_.size());
+}
+
+int FlowFieldCache::getBuildCount() {
+  std::lock_guard<std::mutex> lock(this->mutex_);
+  return this->builds_;
+}
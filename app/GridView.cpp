@@ -0,0 +1,59 @@
+/* Copyright (C)
+ * 2019 - Bhargav Dandamudi
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the 'Software'), to deal in the Software without
+ * restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit
+ * persons to whom the Software is furnished to do so,subject to
+ * the following conditions:
+ * The above copyright notice and this permission notice shall
+ * be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED ''AS IS'', WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR
+ * ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM,OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+/**
+ * @file GridView.cpp
+ * @brief  Grid view constructors
+ * @author Bhargav Dandamudi
+ * @version 1
+ * @date 2019-04-12
+ */
+#include "../include/GridView.h"
+
+GridView::GridView()
+    : bytes_(nullptr), words_(nullptr), height_(0), width_(0), stride_(0),
+      storage_(CellStorage::BYTE), version_(0) {}
+
+GridView::GridView(const uint8_t *cells, int height, int width, int stride,
+                   uint64_t version)
+    : bytes_(cells), words_(nullptr), height_(height), width_(width),
+      stride_(stride), storage_(CellStorage::BYTE), version_(version) {}
+
+GridView::GridView(const uint64_t *words, int height, int width,
+                   int words_per_row, uint64_t version)
+    : bytes_(nullptr), words_(words), height_(height), width_(width),
+      stride_(words_per_row), storage_(CellStorage::BIT), version_(version) {}
+
+GridView::GridView(const OccupancyGrid &grid)
+    : bytes_(nullptr), words_(nullptr), height_(grid.getHeight()),
+      width_(grid.getWidth()), storage_(grid.getStorage()),
+      version_(grid.getVersion()) {
+  if (grid.getStorage() == CellStorage::BYTE) {
+    this->bytes_ = grid.getBytes();
+    this->stride_ = grid.getWidth();
+  } else {
+    this->words_ = grid.getWords();
+    this->stride_ = grid.getWordsPerRow();
+  }
+}
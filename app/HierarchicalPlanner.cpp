@@ -0,0 +1,483 @@
+/* Copyright (C)
+ * 2019 - Bhargav Dandamudi
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the 'Software'), to deal in the Software without
+ * restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit
+ * persons to whom the Software is furnished to do so,subject to
+ * the following conditions:
+ * The above copyright notice and this permission notice shall
+ * be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED ''AS IS'', WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR
+ * ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM,OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+/**
+ * @file HierarchicalPlanner.cpp
+ * @brief  Cluster abstraction, abstract search and path refinement
+ * @author Bhargav Dandamudi
+ * @version 1
+ * @date 2019-04-17
+ */
+#include "../include/HierarchicalPlanner.h"
+#include <algorithm>
+#include <set>
+
+/* ----------------------------------------------------------------*/
+/**
+ * @brief  Constructor, cuts the map into clusters and builds all of them
+ *
+ * @param world_map
+ * @param cluster_size
+ */
+/* ----------------------------------------------------------------*/
+HierarchicalPlanner::HierarchicalPlanner(const GridView &world_map,
+                                         int cluster_size)
+    : world_map_(world_map), cluster_size_(cluster_size),
+      rebuilt_clusters_(0), query_start_(-1), query_goal_(-1) {
+  this->clusters_y_ = (world_map.getHeight() + cluster_size - 1) / cluster_size;
+  this->clusters_x_ = (world_map.getWidth() + cluster_size - 1) / cluster_size;
+  int count = this->clusters_y_ * this->clusters_x_;
+  this->clusters_.resize(count);
+  this->right_entrances_.resize(count);
+  this->bottom_entrances_.resize(count);
+  for (int k = 0; k < count; k++) {
+    Cluster &cluster = this->clusters_[k];
+    cluster.top = (k / this->clusters_x_) * cluster_size;
+    cluster.left = (k % this->clusters_x_) * cluster_size;
+    cluster.height =
+        std::min(cluster_size, world_map.getHeight() - cluster.top);
+    cluster.width = std::min(cluster_size, world_map.getWidth() - cluster.left);
+  }
+  for (int k = 0; k < count; k++) {
+    findRightEntrances(k);
+    findBottomEntrances(k);
+  }
+  for (int k = 0; k < count; k++) {
+    buildCluster(k);
+  }
+  this->rebuilt_clusters_ = count;
+}
+
+int HierarchicalPlanner::clusterOf(int cell) {
+  std::pair<int, int> position = this->world_map_.toPosition(cell);
+  return (position.first / this->cluster_size_) * this->clusters_x_ +
+         position.second / this->cluster_size_;
+}
+
+bool HierarchicalPlanner::isFree(std::pair<int, int> position) {
+  return this->world_map_.isInside(position) &&
+         !this->world_map_.isOccupied(position);
+}
+
+int HierarchicalPlanner::getAbstractNodeCount() {
+  int count = 0;
+  for (const auto &cluster : this->clusters_) {
+    count += int(cluster.nodes.size());
+  }
+  return count;
+}
+
+// adds the transitions of one run of free cell pairs [first, last] along a
+// border: the middle of a short run, both ends of a long one
+static void addTransitions(std::vector<int> &entrances, int first, int last,
+                           int step) {
+  int length = (last - first) / step + 1;
+  if (length < 6) {
+    entrances.push_back(first + (length / 2) * step);
+  } else {
+    entrances.push_back(first);
+    entrances.push_back(last);
+  }
+}
+
+/* ----------------------------------------------------------------*/
+/**
+ * @brief  Finds the transitions between a cluster and its right neighbor,
+ *          stores the cells of the last column of the cluster
+ *
+ * @param k cluster
+ */
+/* ----------------------------------------------------------------*/
+void HierarchicalPlanner::findRightEntrances(int k) {
+  std::vector<int> &entrances = this->right_entrances_[k];
+  entrances.clear();
+  if (k % this->clusters_x_ == this->clusters_x_ - 1) {
+    return;
+  }
+  const Cluster &cluster = this->clusters_[k];
+  int x = cluster.left + cluster.width - 1;
+  int width = this->world_map_.getWidth();
+  int run_start = -1;
+  for (int y = cluster.top; y <= cluster.top + cluster.height; y++) {
+    bool open = y < cluster.top + cluster.height &&
+                isFree(std::make_pair(y, x)) &&
+                isFree(std::make_pair(y, x + 1));
+    if (open && run_start == -1) {
+      run_start = y;
+    } else if (!open && run_start != -1) {
+      addTransitions(entrances, run_start * width + x, (y - 1) * width + x,
+                     width);
+      run_start = -1;
+    }
+  }
+}
+
+/* ----------------------------------------------------------------*/
+/**
+ * @brief  Finds the transitions between a cluster and the one below it,
+ *          stores the cells of the last row of the cluster
+ *
+ * @param k cluster
+ */
+/* ----------------------------------------------------------------*/
+void HierarchicalPlanner::findBottomEntrances(int k) {
+  std::vector<int> &entrances = this->bottom_entrances_[k];
+  entrances.clear();
+  if (k / this->clusters_x_ == this->clusters_y_ - 1) {
+    return;
+  }
+  const Cluster &cluster = this->clusters_[k];
+  int y = cluster.top + cluster.height - 1;
+  int width = this->world_map_.getWidth();
+  int run_start = -1;
+  for (int x = cluster.left; x <= cluster.left + cluster.width; x++) {
+    bool open = x < cluster.left + cluster.width &&
+                isFree(std::make_pair(y, x)) &&
+                isFree(std::make_pair(y + 1, x));
+    if (open && run_start == -1) {
+      run_start = x;
+    } else if (!open && run_start != -1) {
+      addTransitions(entrances, y * width + run_start, y * width + x - 1, 1);
+      run_start = -1;
+    }
+  }
+}
+
+/* ----------------------------------------------------------------*/
+/**
+ * @brief  View of the cells of a cluster. Byte maps are viewed in place
+ *          through the row stride, bit packed maps are copied since a
+ *          cluster does not start on a word boundary.
+ *
+ * @param k cluster
+ *
+ * @return view with (0,0) at the top left corner of the cluster
+ */
+/* ----------------------------------------------------------------*/
+GridView HierarchicalPlanner::clusterView(int k) {
+  const Cluster &cluster = this->clusters_[k];
+  if (this->world_map_.getStorage() == CellStorage::BYTE) {
+    return GridView(this->world_map_.getBytes() +
+                        cluster.top * this->world_map_.getStride() +
+                        cluster.left,
+                    cluster.height, cluster.width,
+                    this->world_map_.getStride());
+  }
+  this->cluster_copy_ = OccupancyGrid(cluster.height, cluster.width);
+  this->cluster_copy_.fillRows([this, &cluster](int y, uint8_t *cells) {
+    for (int x = 0; x < cluster.width; x++) {
+      cells[x] = uint8_t(this->world_map_.getValue(
+          std::make_pair(cluster.top + y, cluster.left + x)));
+    }
+    return true;
+  });
+  return GridView(this->cluster_copy_);
+}
+
+/* ----------------------------------------------------------------*/
+/**
+ * @brief  Cost of the shortest path between two cells which stays inside
+ *          the cluster, found with optimalPlanner on the cluster view
+ *
+ * @param k cluster
+ * @param from cell index
+ * @param to cell index
+ *
+ * @return path cost, FLT_MAX if there is none
+ */
+/* ----------------------------------------------------------------*/
+float HierarchicalPlanner::clusterCost(int k, int from, int to) {
+  if (from == to) {
+    return 0.0f;
+  }
+  const Cluster &cluster = this->clusters_[k];
+  std::pair<int, int> a = this->world_map_.toPosition(from);
+  std::pair<int, int> b = this->world_map_.toPosition(to);
+  std::stack<std::pair<int, int>> path = this->local_planner_.search(
+      clusterView(k),
+      std::make_pair(a.first - cluster.top, a.second - cluster.left),
+      std::make_pair(b.first - cluster.top, b.second - cluster.left));
+  // a search without result returns only the start
+  return path.size() > 1 ? float(path.size() - 1) : FLT_MAX;
+}
+
+/* ----------------------------------------------------------------*/
+/**
+ * @brief  Collects the transition cells lying in a cluster, its own and
+ *          those of the left/top neighbor, and links every pair
+ *
+ * @param k cluster
+ */
+/* ----------------------------------------------------------------*/
+void HierarchicalPlanner::buildCluster(int k) {
+  Cluster &cluster = this->clusters_[k];
+  std::set<int> nodes(this->right_entrances_[k].begin(),
+                      this->right_entrances_[k].end());
+  nodes.insert(this->bottom_entrances_[k].begin(),
+               this->bottom_entrances_[k].end());
+  if (k % this->clusters_x_ > 0) {
+    for (int cell : this->right_entrances_[k - 1]) {
+      nodes.insert(cell + 1);
+    }
+  }
+  if (k / this->clusters_x_ > 0) {
+    for (int cell : this->bottom_entrances_[k - this->clusters_x_]) {
+      nodes.insert(cell + this->world_map_.getWidth());
+    }
+  }
+  cluster.nodes.assign(nodes.begin(), nodes.end());
+  int count = int(cluster.nodes.size());
+  cluster.costs.assign(count, std::vector<float>(count, 0.0f));
+  for (int i = 0; i < count; i++) {
+    for (int j = i + 1; j < count; j++) {
+      float cost = clusterCost(k, cluster.nodes[i], cluster.nodes[j]);
+      cluster.costs[i][j] = cost;
+      cluster.costs[j][i] = cost;
+    }
+  }
+}
+
+/* ----------------------------------------------------------------*/
+/**
+ * @brief  Rebuilds the clusters around the changed cells
+ *
+ * @param cells
+ */
+/* ----------------------------------------------------------------*/
+void HierarchicalPlanner::updateCells(
+    const std::vector<std::pair<int, int>> &cells) {
+  std::set<int> changed;
+  for (const auto &position : cells) {
+    changed.insert(clusterOf(this->world_map_.toIndex(position)));
+  }
+  // every border of a changed cluster is searched again, that touches the
+  // node sets of the neighbors as well
+  std::set<int> rebuild;
+  for (int k : changed) {
+    int row = k / this->clusters_x_;
+    int column = k % this->clusters_x_;
+    findRightEntrances(k);
+    findBottomEntrances(k);
+    rebuild.insert(k);
+    if (column > 0) {
+      findRightEntrances(k - 1);
+      rebuild.insert(k - 1);
+    }
+    if (row > 0) {
+      findBottomEntrances(k - this->clusters_x_);
+      rebuild.insert(k - this->clusters_x_);
+    }
+    if (column < this->clusters_x_ - 1) {
+      rebuild.insert(k + 1);
+    }
+    if (row < this->clusters_y_ - 1) {
+      rebuild.insert(k + this->clusters_x_);
+    }
+  }
+  for (int k : rebuild) {
+    buildCluster(k);
+  }
+  this->rebuilt_clusters_ = int(rebuild.size());
+}
+
+/* ----------------------------------------------------------------*/
+/**
+ * @brief  Abstract graph neighbors of a cell: the nodes of its cluster,
+ *          transition cells right across a border, and the temporary links
+ *          of the query start and goal
+ *
+ * @param cell
+ */
+/* ----------------------------------------------------------------*/
+void HierarchicalPlanner::findNeighbors(int cell) {
+  this->neighbors_.clear();
+  if (cell == this->query_start_) {
+    this->neighbors_ = this->start_links_;
+  }
+  for (const auto &link : this->goal_links_) {
+    if (link.first == cell) {
+      this->neighbors_.push_back(
+          std::make_pair(this->query_goal_, link.second));
+    }
+  }
+  int k = clusterOf(cell);
+  const Cluster &cluster = this->clusters_[k];
+  auto found = std::find(cluster.nodes.begin(), cluster.nodes.end(), cell);
+  if (found == cluster.nodes.end()) {
+    return;
+  }
+  int i = int(found - cluster.nodes.begin());
+  for (int j = 0; j < int(cluster.nodes.size()); j++) {
+    if (j != i && cluster.costs[i][j] < FLT_MAX) {
+      this->neighbors_.push_back(
+          std::make_pair(cluster.nodes[j], cluster.costs[i][j]));
+    }
+  }
+  std::pair<int, int> position = this->world_map_.toPosition(cell);
+  std::pair<int, int> sides[4] = {
+      std::make_pair(position.first - 1, position.second),
+      std::make_pair(position.first, position.second - 1),
+      std::make_pair(position.first + 1, position.second),
+      std::make_pair(position.first, position.second + 1)};
+  for (const auto &side : sides) {
+    if (!isFree(side)) {
+      continue;
+    }
+    int side_cell = this->world_map_.toIndex(side);
+    int side_cluster = clusterOf(side_cell);
+    if (side_cluster == k) {
+      continue;
+    }
+    const std::vector<int> &others = this->clusters_[side_cluster].nodes;
+    if (std::find(others.begin(), others.end(), side_cell) != others.end()) {
+      this->neighbors_.push_back(std::make_pair(side_cell, 1.0f));
+    }
+  }
+}
+
+/* ----------------------------------------------------------------*/
+/**
+ * @brief  Links start and goal into the abstract graph, runs astar on it
+ *          and refines the abstract path cluster by cluster
+ *
+ * @param robot_pose
+ * @param goal_pose
+ *
+ * @return path, start on top
+ */
+/* ----------------------------------------------------------------*/
+std::stack<std::pair<int, int>>
+HierarchicalPlanner::search(std::pair<int, int> robot_pose,
+                            std::pair<int, int> goal_pose) {
+  // poses outside the map or on obstacles have no cluster, they are
+  // answered like optimalPlanner::search does
+  if (!isFree(robot_pose) || !isFree(goal_pose)) {
+    std::stack<std::pair<int, int>> path;
+    path.push(robot_pose);
+    return path;
+  }
+  int start = this->world_map_.toIndex(robot_pose);
+  int goal = this->world_map_.toIndex(goal_pose);
+  int start_cluster = clusterOf(start);
+  int goal_cluster = clusterOf(goal);
+  this->query_start_ = start;
+  this->query_goal_ = goal;
+
+  // temporary edges of start and goal to the nodes of their clusters
+  this->start_links_.clear();
+  this->goal_links_.clear();
+  for (int node : this->clusters_[start_cluster].nodes) {
+    float cost = clusterCost(start_cluster, start, node);
+    if (cost < FLT_MAX) {
+      this->start_links_.push_back(std::make_pair(node, cost));
+    }
+  }
+  for (int node : this->clusters_[goal_cluster].nodes) {
+    float cost = clusterCost(goal_cluster, node, goal);
+    if (cost < FLT_MAX) {
+      this->goal_links_.push_back(std::make_pair(node, cost));
+    }
+  }
+  if (start_cluster == goal_cluster) {
+    float cost = clusterCost(start_cluster, start, goal);
+    if (cost < FLT_MAX) {
+      this->start_links_.push_back(std::make_pair(goal, cost));
+    }
+  }
+
+  // astar on the abstract graph, states are kept by cell index
+  int cells = this->world_map_.getCellCount();
+  this->abstract_context_.beginSearch(cells);
+  if (this->abstract_open_.capacity() != cells) {
+    this->abstract_open_.resize(cells);
+  }
+  this->abstract_open_.clear();
+  this->abstract_context_.reach(start, 0.0f, start);
+  this->abstract_open_.push(start, 0.0);
+  while (!this->abstract_open_.empty()) {
+    int cell = this->abstract_open_.pop();
+    if (cell == goal) {
+      break;
+    }
+    this->abstract_context_.close(cell);
+    float g_cost = this->abstract_context_.getGCost(cell);
+    findNeighbors(cell);
+    for (const auto &neighbor : this->neighbors_) {
+      if (this->abstract_context_.isClosed(neighbor.first)) {
+        continue;
+      }
+      float g_new = g_cost + neighbor.second;
+      if (g_new < this->abstract_context_.getGCost(neighbor.first)) {
+        std::pair<int, int> position =
+            this->world_map_.toPosition(neighbor.first);
+        this->abstract_context_.reach(neighbor.first, g_new, cell);
+        this->abstract_open_.push(
+            neighbor.first, g_new + abs(position.first - goal_pose.first) +
+                                abs(position.second - goal_pose.second));
+      }
+    }
+  }
+
+  std::stack<std::pair<int, int>> path;
+  if (!this->abstract_context_.isReached(goal)) {
+    path.push(robot_pose);
+    return path;
+  }
+  std::vector<int> waypoints;
+  for (int cell = goal; cell != start;
+       cell = this->abstract_context_.getParent(cell)) {
+    waypoints.push_back(cell);
+  }
+  waypoints.push_back(start);
+
+  // refine from the goal backwards, so the start ends up on top
+  for (int i = 0; i + 1 < int(waypoints.size()); i++) {
+    int to = waypoints[i];
+    int from = waypoints[i + 1];
+    int k = clusterOf(from);
+    if (clusterOf(to) != k) {
+      path.push(this->world_map_.toPosition(to)); // step across a border
+      continue;
+    }
+    const Cluster &cluster = this->clusters_[k];
+    std::pair<int, int> a = this->world_map_.toPosition(from);
+    std::pair<int, int> b = this->world_map_.toPosition(to);
+    std::stack<std::pair<int, int>> segment = this->local_planner_.search(
+        clusterView(k),
+        std::make_pair(a.first - cluster.top, a.second - cluster.left),
+        std::make_pair(b.first - cluster.top, b.second - cluster.left));
+    std::vector<std::pair<int, int>> steps;
+    segment.pop(); // from is pushed by the next segment or as start
+    while (!segment.empty()) {
+      steps.push_back(std::make_pair(segment.top().first + cluster.top,
+                                     segment.top().second + cluster.left));
+      segment.pop();
+    }
+    for (auto it = steps.rbegin(); it != steps.rend(); ++it) {
+      path.push(*it);
+    }
+  }
+  path.push(robot_pose);
+  return path;
+}
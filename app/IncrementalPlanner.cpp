@@ -0,0 +1,288 @@
+/* Copyright (C)
+ * 2019 - Bhargav Dandamudi
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the 'Software'), to deal in the Software without
+ * restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit
+ * persons to whom the Software is furnished to do so,subject to
+ * the following conditions:
+ * The above copyright notice and this permission notice shall
+ * be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED ''AS IS'', WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR
+ * ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM,OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+/**
+ * @file IncrementalPlanner.cpp
+ * @brief  D* Lite search, map updates and replanning
+ * @author Bhargav Dandamudi
+ * @version 1
+ * @date 2019-04-18
+ */
+#include "../include/IncrementalPlanner.h"
+#include <algorithm>
+#include <cfloat>
+#include <climits>
+#include <cstdlib>
+
+static const int INFINITE_COST = INT_MAX;
+
+// a + b which stays at INFINITE_COST instead of overflowing
+static int addCost(int a, int b) {
+  return (a == INFINITE_COST || b == INFINITE_COST) ? INFINITE_COST : a + b;
+}
+
+/* ----------------------------------------------------------------*/
+/**
+ * @brief  Constructor, only the goal is queued, nothing is searched yet.
+ *          A start or goal outside the map or on an obstacle makes the
+ *          planner invalid, its searches then return the start only.
+ *
+ * @param world_map
+ * @param robot_pose
+ * @param goal_pose
+ */
+/* ----------------------------------------------------------------*/
+IncrementalPlanner::IncrementalPlanner(const OccupancyGrid &world_map,
+                                       std::pair<int, int> robot_pose,
+                                       std::pair<int, int> goal_pose)
+    : world_map_(world_map), start_(robot_pose), goal_(goal_pose),
+      start_index_(0), goal_index_(0), last_start_index_(0), km_(0),
+      key_scale_(1.0), expanded_nodes_(0) {
+  this->valid_ = isFree(robot_pose) && isFree(goal_pose);
+  if (!this->valid_) {
+    return;
+  }
+  int cells = world_map.getCellCount();
+  this->start_index_ = world_map.toIndex(robot_pose);
+  this->goal_index_ = world_map.toIndex(goal_pose);
+  this->last_start_index_ = this->start_index_;
+  // path costs stay below the cell count, so the second key component
+  // never carries into the first
+  this->key_scale_ = double(cells) + 1.0;
+  this->g_.assign(cells, INFINITE_COST);
+  this->rhs_.assign(cells, INFINITE_COST);
+  this->open_.resize(cells);
+  this->rhs_[this->goal_index_] = 0;
+  this->open_.update(this->goal_index_, calculateKey(this->goal_index_));
+}
+
+IncrementalPlanner::IncrementalPlanner(
+    const std::vector<std::vector<int>> &world_map,
+    std::pair<int, int> robot_pose, std::pair<int, int> goal_pose)
+    : IncrementalPlanner(OccupancyGrid(world_map), robot_pose, goal_pose) {}
+
+bool IncrementalPlanner::isFree(std::pair<int, int> position) {
+  return this->world_map_.isInside(position) &&
+         !this->world_map_.isOccupied(this->world_map_.toIndex(position));
+}
+
+int IncrementalPlanner::heuristic(int a, int b) {
+  std::pair<int, int> first = this->world_map_.toPosition(a);
+  std::pair<int, int> second = this->world_map_.toPosition(b);
+  return abs(first.first - second.first) + abs(first.second - second.second);
+}
+
+int IncrementalPlanner::stepCost(int a, int b) {
+  return (this->world_map_.isOccupied(a) || this->world_map_.isOccupied(b))
+             ? INFINITE_COST
+             : 1;
+}
+
+int IncrementalPlanner::findNeighbors(int cell, int *neighbors) {
+  std::pair<int, int> position = this->world_map_.toPosition(cell);
+  int width = this->world_map_.getWidth();
+  int count = 0;
+  if (position.first > 0) {
+    neighbors[count++] = cell - width;
+  }
+  if (position.second > 0) {
+    neighbors[count++] = cell - 1;
+  }
+  if (position.first < this->world_map_.getHeight() - 1) {
+    neighbors[count++] = cell + width;
+  }
+  if (position.second < width - 1) {
+    neighbors[count++] = cell + 1;
+  }
+  return count;
+}
+
+double IncrementalPlanner::calculateKey(int cell) {
+  int cost = std::min(this->g_[cell], this->rhs_[cell]);
+  if (cost == INFINITE_COST) {
+    return DBL_MAX;
+  }
+  return double(cost + heuristic(this->start_index_, cell) + this->km_) *
+             this->key_scale_ +
+         double(cost);
+}
+
+int IncrementalPlanner::lookahead(int cell) {
+  int neighbors[4];
+  int count = findNeighbors(cell, neighbors);
+  int best = INFINITE_COST;
+  for (int i = 0; i < count; i++) {
+    best = std::min(best, addCost(stepCost(cell, neighbors[i]),
+                                  this->g_[neighbors[i]]));
+  }
+  return best;
+}
+
+/* ----------------------------------------------------------------*/
+/**
+ * @brief  Queues a cell if it is inconsistent (g != rhs), removes it from
+ *          the queue otherwise
+ *
+ * @param cell
+ */
+/* ----------------------------------------------------------------*/
+void IncrementalPlanner::updateVertex(int cell) {
+  if (this->g_[cell] != this->rhs_[cell]) {
+    this->open_.update(cell, calculateKey(cell));
+  } else if (this->open_.contains(cell)) {
+    this->open_.remove(cell);
+  }
+}
+
+/* ----------------------------------------------------------------*/
+/**
+ * @brief  Expands inconsistent cells until the start is consistent and no
+ *          queued cell can lower its distance
+ */
+/* ----------------------------------------------------------------*/
+void IncrementalPlanner::computeShortestPath() {
+  this->expanded_nodes_ = 0;
+  int neighbors[4];
+  while (!this->open_.empty() &&
+         (this->open_.topPriority() < calculateKey(this->start_index_) ||
+          this->rhs_[this->start_index_] != this->g_[this->start_index_])) {
+    int cell = this->open_.top();
+    double old_key = this->open_.topPriority();
+    double new_key = calculateKey(cell);
+    if (old_key < new_key) {
+      // queued before the start moved, the key was a lower bound
+      this->open_.update(cell, new_key);
+      continue;
+    }
+    this->expanded_nodes_++;
+    int count = findNeighbors(cell, neighbors);
+    if (this->g_[cell] > this->rhs_[cell]) {
+      // overconsistent, the distance went down
+      this->g_[cell] = this->rhs_[cell];
+      this->open_.remove(cell);
+      for (int i = 0; i < count; i++) {
+        int neighbor = neighbors[i];
+        if (neighbor != this->goal_index_) {
+          this->rhs_[neighbor] =
+              std::min(this->rhs_[neighbor],
+                       addCost(stepCost(neighbor, cell), this->g_[cell]));
+        }
+        updateVertex(neighbor);
+      }
+    } else {
+      // underconsistent, the distance went up: cells which took their
+      // lookahead through this one have to look again
+      int old_g = this->g_[cell];
+      this->g_[cell] = INFINITE_COST;
+      for (int i = 0; i < count; i++) {
+        int neighbor = neighbors[i];
+        if (neighbor != this->goal_index_ &&
+            this->rhs_[neighbor] == addCost(stepCost(neighbor, cell), old_g)) {
+          this->rhs_[neighbor] = lookahead(neighbor);
+        }
+        updateVertex(neighbor);
+      }
+      updateVertex(cell);
+    }
+  }
+}
+
+/* ----------------------------------------------------------------*/
+/**
+ * @brief  Runs the search and follows the lowest g + step cost from the
+ *          start to the goal
+ *
+ * @return path, start on top
+ */
+/* ----------------------------------------------------------------*/
+std::stack<std::pair<int, int>> IncrementalPlanner::search() {
+  std::stack<std::pair<int, int>> path;
+  if (!this->valid_ || !this->world_map_.isInside(this->start_)) {
+    path.push(this->start_);
+    return path;
+  }
+  computeShortestPath();
+  if (this->g_[this->start_index_] == INFINITE_COST) {
+    path.push(this->start_);
+    return path;
+  }
+  std::vector<int> cells{this->start_index_};
+  int neighbors[4];
+  int cell = this->start_index_;
+  while (cell != this->goal_index_) {
+    int count = findNeighbors(cell, neighbors);
+    int best = INFINITE_COST;
+    int next = cell;
+    for (int i = 0; i < count; i++) {
+      int cost = addCost(stepCost(cell, neighbors[i]), this->g_[neighbors[i]]);
+      if (cost < best) {
+        best = cost;
+        next = neighbors[i];
+      }
+    }
+    cell = next;
+    cells.push_back(cell);
+  }
+  for (auto it = cells.rbegin(); it != cells.rend(); ++it) {
+    path.push(this->world_map_.toPosition(*it));
+  }
+  return path;
+}
+
+void IncrementalPlanner::updateCell(std::pair<int, int> location, int value) {
+  if (!this->valid_ || !this->world_map_.isInside(location)) {
+    return;
+  }
+  int cell = this->world_map_.toIndex(location);
+  if (this->world_map_.getValue(cell) == value) {
+    return;
+  }
+  this->world_map_.setValue(cell, value);
+  // only the steps into and out of this cell changed their cost, so only
+  // the lookahead of the cell and its neighbors can differ; one slot past
+  // the four neighbors holds the cell itself
+  int neighbors[5];
+  int count = findNeighbors(cell, neighbors);
+  neighbors[count++] = cell;
+  for (int i = 0; i < count; i++) {
+    if (neighbors[i] != this->goal_index_) {
+      this->rhs_[neighbors[i]] = lookahead(neighbors[i]);
+    }
+    updateVertex(neighbors[i]);
+  }
+}
+
+std::stack<std::pair<int, int>>
+IncrementalPlanner::replan(std::pair<int, int> robot_pose) {
+  this->start_ = robot_pose;
+  if (!this->valid_ || !this->world_map_.isInside(robot_pose)) {
+    std::stack<std::pair<int, int>> path;
+    path.push(robot_pose);
+    return path;
+  }
+  this->start_index_ = this->world_map_.toIndex(robot_pose);
+  this->km_ += heuristic(this->last_start_index_, this->start_index_);
+  this->last_start_index_ = this->start_index_;
+  return search();
+}
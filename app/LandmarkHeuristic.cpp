@@ -0,0 +1,260 @@
+/* Copyright (C)
+ * 2019 - Bhargav Dandamudi
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the 'Software'), to deal in the Software without
+ * restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit
+ * persons to whom the Software is furnished to do so,subject to
+ * the following conditions:
+ * The above copyright notice and this permission notice shall
+ * be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED ''AS IS'', WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR
+ * ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM,OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+/**
+ * @file LandmarkHeuristic.cpp
+ * @brief  Landmark placement, parallel table construction and persistence
+ * @author Bhargav Dandamudi
+ * @version 1
+ * @date 2019-04-19
+ */
+#include "../include/LandmarkHeuristic.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <fstream>
+#include <thread>
+
+const uint32_t LandmarkHeuristic::UNREACHABLE;
+
+static const char FILE_MAGIC[4] = {'L', 'M', 'R', 'K'};
+static const uint32_t FILE_VERSION = 1;
+
+LandmarkHeuristic::LandmarkHeuristic() : height_(0), width_(0), checksum_(0) {}
+
+uint64_t LandmarkHeuristic::checksum(const GridView &world_map) {
+  uint64_t hash = 14695981039346656037ull;
+  hash = (hash ^ uint64_t(world_map.getHeight())) * 1099511628211ull;
+  hash = (hash ^ uint64_t(world_map.getWidth())) * 1099511628211ull;
+  for (int i = 0; i < world_map.getCellCount(); i++) {
+    hash = (hash ^ uint64_t(world_map.isOccupied(i))) * 1099511628211ull;
+  }
+  return hash;
+}
+
+bool LandmarkHeuristic::matches(const GridView &world_map) const {
+  return world_map.getHeight() == this->height_ &&
+         world_map.getWidth() == this->width_ &&
+         checksum(world_map) == this->checksum_;
+}
+
+int LandmarkHeuristic::nearestFreeCell(const GridView &world_map,
+                                       std::pair<int, int> location) {
+  int radius_limit = std::max(world_map.getHeight(), world_map.getWidth());
+  for (int radius = 0; radius < radius_limit; radius++) {
+    for (int dy = -radius; dy <= radius; dy++) {
+      int dx = radius - abs(dy);
+      std::pair<int, int> cells[2] = {
+          std::make_pair(location.first + dy, location.second - dx),
+          std::make_pair(location.first + dy, location.second + dx)};
+      for (const auto &cell : cells) {
+        if (world_map.isInside(cell) && !world_map.isOccupied(cell)) {
+          return world_map.toIndex(cell);
+        }
+      }
+    }
+  }
+  return -1;
+}
+
+void LandmarkHeuristic::distancesFrom(const GridView &world_map, int source,
+                                      std::vector<uint32_t> &distances) {
+  int width = world_map.getWidth();
+  int height = world_map.getHeight();
+  distances.assign(world_map.getCellCount(), UNREACHABLE);
+  std::vector<int> queue;
+  queue.reserve(world_map.getCellCount());
+  queue.push_back(source);
+  distances[source] = 0;
+  for (size_t head = 0; head < queue.size(); head++) {
+    int cell = queue[head];
+    int y = cell / width;
+    int x = cell % width;
+    int neighbors[4] = {y > 0 ? cell - width : -1, x > 0 ? cell - 1 : -1,
+                        y < height - 1 ? cell + width : -1,
+                        x < width - 1 ? cell + 1 : -1};
+    for (int neighbor : neighbors) {
+      if (neighbor != -1 && distances[neighbor] == UNREACHABLE &&
+          !world_map.isOccupied(neighbor)) {
+        distances[neighbor] = distances[cell] + 1;
+        queue.push_back(neighbor);
+      }
+    }
+  }
+}
+
+/* ----------------------------------------------------------------*/
+/**
+ * @brief  Spreads the landmarks evenly along the map border, then runs one
+ *          breadth first search per landmark on a pool of threads. Each
+ *          search writes its own row-major table, which are interleaved at
+ *          the end so the threads never share cache lines.
+ *
+ * @param world_map
+ * @param count number of landmarks
+ * @param threads
+ */
+/* ----------------------------------------------------------------*/
+void LandmarkHeuristic::build(const GridView &world_map, int count,
+                              int threads) {
+  this->height_ = world_map.getHeight();
+  this->width_ = world_map.getWidth();
+  this->checksum_ = checksum(world_map);
+  this->landmarks_.clear();
+  int bottom = this->height_ - 1;
+  int right = this->width_ - 1;
+  int perimeter = std::max(1, 2 * (bottom + right));
+  for (int l = 0; l < count; l++) {
+    // walk clockwise from the top left corner
+    int step = int(int64_t(l) * perimeter / count);
+    std::pair<int, int> location;
+    if (step < right) {
+      location = std::make_pair(0, step);
+    } else if (step < right + bottom) {
+      location = std::make_pair(step - right, right);
+    } else if (step < 2 * right + bottom) {
+      location = std::make_pair(bottom, right - (step - right - bottom));
+    } else {
+      location = std::make_pair(bottom - (step - 2 * right - bottom), 0);
+    }
+    int cell = nearestFreeCell(world_map, location);
+    if (cell != -1 &&
+        std::find(this->landmarks_.begin(), this->landmarks_.end(), cell) ==
+            this->landmarks_.end()) {
+      this->landmarks_.push_back(cell);
+    }
+  }
+
+  int landmark_count = int(this->landmarks_.size());
+  std::vector<std::vector<uint32_t>> tables(landmark_count);
+  if (threads <= 0) {
+    threads = std::max(1, int(std::thread::hardware_concurrency()));
+  }
+  threads = std::max(1, std::min(threads, landmark_count));
+  std::atomic<int> next(0);
+  auto work = [&]() {
+    for (int l = next++; l < landmark_count; l = next++) {
+      distancesFrom(world_map, this->landmarks_[l], tables[l]);
+    }
+  };
+  std::vector<std::thread> workers;
+  for (int t = 1; t < threads; t++) {
+    workers.push_back(std::thread(work));
+  }
+  work();
+  for (auto &worker : workers) {
+    worker.join();
+  }
+
+  int cells = world_map.getCellCount();
+  this->distances_.resize(size_t(cells) * landmark_count);
+  for (int l = 0; l < landmark_count; l++) {
+    for (int i = 0; i < cells; i++) {
+      this->distances_[size_t(i) * landmark_count + l] = tables[l][i];
+    }
+  }
+}
+
+/* ----------------------------------------------------------------*/
+/**
+ * @brief  File layout: magic, format version, height, width, map checksum,
+ *          landmark count, landmark cells, cell major distance table
+ *
+ * @param file_name
+ *
+ * @return false if the file could not be written
+ */
+/* ----------------------------------------------------------------*/
+bool LandmarkHeuristic::save(const std::string &file_name) const {
+  std::ofstream file(file_name, std::ios::binary);
+  if (!file) {
+    return false;
+  }
+  int32_t count = int32_t(this->landmarks_.size());
+  int32_t height = this->height_;
+  int32_t width = this->width_;
+  file.write(FILE_MAGIC, sizeof(FILE_MAGIC));
+  file.write(reinterpret_cast<const char *>(&FILE_VERSION),
+             sizeof(FILE_VERSION));
+  file.write(reinterpret_cast<const char *>(&height), sizeof(height));
+  file.write(reinterpret_cast<const char *>(&width), sizeof(width));
+  file.write(reinterpret_cast<const char *>(&this->checksum_),
+             sizeof(this->checksum_));
+  file.write(reinterpret_cast<const char *>(&count), sizeof(count));
+  for (int cell : this->landmarks_) {
+    int32_t value = cell;
+    file.write(reinterpret_cast<const char *>(&value), sizeof(value));
+  }
+  file.write(reinterpret_cast<const char *>(this->distances_.data()),
+             this->distances_.size() * sizeof(uint32_t));
+  return bool(file);
+}
+
+bool LandmarkHeuristic::load(const std::string &file_name,
+                             const GridView &world_map) {
+  std::ifstream file(file_name, std::ios::binary);
+  char magic[4];
+  uint32_t version = 0;
+  int32_t height = 0, width = 0, count = 0;
+  uint64_t map_checksum = 0;
+  file.read(magic, sizeof(magic));
+  file.read(reinterpret_cast<char *>(&version), sizeof(version));
+  file.read(reinterpret_cast<char *>(&height), sizeof(height));
+  file.read(reinterpret_cast<char *>(&width), sizeof(width));
+  file.read(reinterpret_cast<char *>(&map_checksum), sizeof(map_checksum));
+  file.read(reinterpret_cast<char *>(&count), sizeof(count));
+  if (!file || !std::equal(magic, magic + 4, FILE_MAGIC) ||
+      version != FILE_VERSION || height != world_map.getHeight() ||
+      width != world_map.getWidth() || count < 0 ||
+      map_checksum != checksum(world_map)) {
+    return false;
+  }
+  // landmarks are distinct cells, a larger count is a broken file and
+  // must not size the tables
+  int64_t cells = int64_t(height) * width;
+  if (count > cells) {
+    return false;
+  }
+  std::vector<int> landmarks(count);
+  for (int l = 0; l < count; l++) {
+    int32_t value = 0;
+    file.read(reinterpret_cast<char *>(&value), sizeof(value));
+    if (value < 0 || value >= cells) {
+      return false;
+    }
+    landmarks[l] = value;
+  }
+  std::vector<uint32_t> distances(size_t(height) * width * count);
+  file.read(reinterpret_cast<char *>(distances.data()),
+            distances.size() * sizeof(uint32_t));
+  if (!file) {
+    return false;
+  }
+  this->height_ = height;
+  this->width_ = width;
+  this->checksum_ = map_checksum;
+  this->landmarks_.swap(landmarks);
+  this->distances_.swap(distances);
+  return true;
+}
@@ -0,0 +1,368 @@
+/* Copyright (C)
+ * 2019 - Bhargav Dandamudi
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the 'Software'), to deal in the Software without
+ * restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit
+ * persons to whom the Software is furnished to do so,subject to
+ * the following conditions:
+ * The above copyright notice and this permission notice shall
+ * be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED ''AS IS'', WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR
+ * ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM,OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+/**
+ * @file MapFile.cpp
+ * @brief  Definitions of the binary map files and converters
+ * @author Bhargav Dandamudi
+ * @version 1
+ * @date 2019-04-26
+ */
+#include "../include/MapFile.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+static const char FILE_MAGIC[4] = {'G', 'M', 'A', 'P'};
+static const uint32_t FILE_VERSION = 1;
+
+// on disk header, the cells start 8 byte aligned right after it
+struct MapFileHeader {
+  char magic[4];
+  uint32_t version;
+  uint32_t height;
+  uint32_t width;
+  uint32_t storage; // 0 BIT, 1 BYTE
+  uint32_t stride;  // 64 bit words (BIT) or bytes (BYTE) per row
+  double resolution;
+  uint64_t checksum;
+  uint64_t data_offset;
+  uint8_t reserved[16];
+};
+static_assert(sizeof(MapFileHeader) == 64, "map file header must be 64 bytes");
+// header and cells are mapped as they are stored, without byte swapping
+#if defined(__BYTE_ORDER__)
+static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__,
+              "map files are only supported on little endian hosts");
+#endif
+
+// bytes of the cells, padded to whole 64 bit words
+static uint64_t paddedSize(uint64_t bytes) { return (bytes + 7) / 8 * 8; }
+
+// FNV-1a over 64 bit words, 8 times fewer steps than per byte
+static uint64_t checksumWords(const uint8_t *data, uint64_t bytes) {
+  uint64_t hash = 14695981039346656037ull;
+  for (uint64_t i = 0; i < bytes; i += 8) {
+    uint64_t word;
+    std::memcpy(&word, data + i, sizeof(word));
+    hash = (hash ^ word) * 1099511628211ull;
+  }
+  return hash;
+}
+
+MapFile::MapFile()
+    : data_(nullptr), size_(0), height_(0), width_(0),
+      storage_(CellStorage::BYTE), stride_(0), resolution_(0), checksum_(0),
+      data_offset_(0), version_(0) {}
+
+MapFile::~MapFile() { close(); }
+
+/* ----------------------------------------------------------------*/
+/**
+ * @brief  Maps the file and checks that the header describes cells which
+ *          fit into it
+ *
+ * @param file_name
+ *
+ * @return false if it is not a valid map file
+ */
+/* ----------------------------------------------------------------*/
+bool MapFile::open(const std::string &file_name) {
+  close();
+  int descriptor = ::open(file_name.c_str(), O_RDONLY);
+  if (descriptor < 0) {
+    return false;
+  }
+  struct stat status;
+  if (fstat(descriptor, &status) != 0 ||
+      uint64_t(status.st_size) < sizeof(MapFileHeader)) {
+    ::close(descriptor);
+    return false;
+  }
+  std::size_t size = std::size_t(status.st_size);
+  void *mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+  // the mapping stays valid after the descriptor is closed
+  ::close(descriptor);
+  if (mapping == MAP_FAILED) {
+    return false;
+  }
+  MapFileHeader header;
+  std::memcpy(&header, mapping, sizeof(header));
+  uint64_t row_bytes = header.storage == 0 ? uint64_t(header.stride) * 8
+                                           : uint64_t(header.stride);
+  bool valid =
+      std::equal(header.magic, header.magic + 4, FILE_MAGIC) &&
+      header.version == FILE_VERSION && header.storage <= 1 &&
+      header.height <= uint32_t(INT32_MAX) &&
+      header.width <= uint32_t(INT32_MAX) &&
+      header.stride <= uint32_t(INT32_MAX) &&
+      (header.storage == 0 ? uint64_t(header.stride) * 64 >= header.width
+                           : header.stride >= header.width) &&
+      header.data_offset >= sizeof(header) && header.data_offset % 8 == 0 &&
+      header.data_offset <= size;
+  if (valid && row_bytes > 0) {
+    // compared by division, so a crafted header can not wrap the products
+    uint64_t room = size - header.data_offset;
+    valid = header.height <= room / row_bytes &&
+            paddedSize(row_bytes * header.height) <= room;
+  }
+  if (!valid) {
+    munmap(mapping, size);
+    return false;
+  }
+  this->data_ = static_cast<const uint8_t *>(mapping);
+  this->size_ = size;
+  this->height_ = int(header.height);
+  this->width_ = int(header.width);
+  this->storage_ = header.storage == 0 ? CellStorage::BIT : CellStorage::BYTE;
+  this->stride_ = int(header.stride);
+  this->resolution_ = header.resolution;
+  this->checksum_ = header.checksum;
+  this->data_offset_ = header.data_offset;
+  this->version_ = OccupancyGrid::nextVersion();
+  return true;
+}
+
+void MapFile::close() {
+  if (this->data_ != nullptr) {
+    munmap(const_cast<uint8_t *>(this->data_), this->size_);
+  }
+  this->data_ = nullptr;
+  this->size_ = 0;
+  this->height_ = 0;
+  this->width_ = 0;
+  this->stride_ = 0;
+  this->version_ = 0;
+}
+
+bool MapFile::verify() const {
+  if (this->data_ == nullptr) {
+    return false;
+  }
+  uint64_t row_bytes = this->storage_ == CellStorage::BIT
+                           ? uint64_t(this->stride_) * 8
+                           : uint64_t(this->stride_);
+  return checksumWords(this->data_ + this->data_offset_,
+                       paddedSize(row_bytes * this->height_)) ==
+         this->checksum_;
+}
+
+GridView MapFile::getView() const {
+  if (this->data_ == nullptr) {
+    return GridView();
+  }
+  const uint8_t *cells = this->data_ + this->data_offset_;
+  if (this->storage_ == CellStorage::BIT) {
+    return GridView(reinterpret_cast<const uint64_t *>(cells), this->height_,
+                    this->width_, this->stride_, this->version_);
+  }
+  return GridView(cells, this->height_, this->width_, this->stride_,
+                  this->version_);
+}
+
+/* ----------------------------------------------------------------*/
+/**
+ * @brief  Packs the rows without the stride of the view, builds the
+ *          checksum and writes header and cells
+ *
+ * @param file_name
+ * @param world_map
+ * @param resolution
+ *
+ * @return false if the file can not be written
+ */
+/* ----------------------------------------------------------------*/
+bool MapFile::save(const std::string &file_name, const GridView &world_map,
+                   double resolution) {
+  int height = world_map.getHeight();
+  int width = world_map.getWidth();
+  bool bits = world_map.getStorage() == CellStorage::BIT;
+  int stride = bits ? (width + 63) / 64 : width;
+  std::size_t row_bytes = bits ? std::size_t(stride) * 8 : std::size_t(stride);
+  std::vector<uint8_t> cells(paddedSize(row_bytes * height), 0);
+  for (int y = 0; y < height; y++) {
+    uint8_t *row = &cells[std::size_t(y) * row_bytes];
+    if (bits) {
+      std::memcpy(row,
+                  world_map.getWords() +
+                      std::size_t(y) * std::size_t(world_map.getStride()),
+                  row_bytes);
+    } else {
+      std::memcpy(row,
+                  world_map.getBytes() +
+                      std::size_t(y) * std::size_t(world_map.getStride()),
+                  row_bytes);
+    }
+  }
+
+  MapFileHeader header;
+  std::memset(&header, 0, sizeof(header));
+  std::memcpy(header.magic, FILE_MAGIC, sizeof(FILE_MAGIC));
+  header.version = FILE_VERSION;
+  header.height = uint32_t(height);
+  header.width = uint32_t(width);
+  header.storage = bits ? 0 : 1;
+  header.stride = uint32_t(stride);
+  header.resolution = resolution;
+  header.checksum = checksumWords(cells.data(), cells.size());
+  header.data_offset = sizeof(header);
+
+  std::ofstream file(file_name, std::ios::binary);
+  if (!file) {
+    return false;
+  }
+  file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  file.write(reinterpret_cast<const char *>(cells.data()), cells.size());
+  return bool(file);
+}
+
+// next token of a PGM header, skipping white space and # comments
+static bool pgmToken(std::istream &input, std::string &token) {
+  token.clear();
+  char c;
+  while (input.get(c)) {
+    if (c == '#') {
+      std::string comment;
+      std::getline(input, comment);
+    } else if (!std::isspace(static_cast<unsigned char>(c))) {
+      token.push_back(c);
+      break;
+    }
+  }
+  while (input.get(c) && !std::isspace(static_cast<unsigned char>(c))) {
+    token.push_back(c);
+  }
+  return !token.empty();
+}
+
+bool MapFile::readPgm(const std::string &file_name, OccupancyGrid &grid,
+                      double free_threshold) {
+  std::ifstream file(file_name, std::ios::binary);
+  std::string magic, token;
+  if (!pgmToken(file, magic) || (magic != "P5" && magic != "P2")) {
+    return false;
+  }
+  int values[3]; // width, height, maxval
+  for (int &value : values) {
+    if (!pgmToken(file, token) ||
+        token.find_first_not_of("0123456789") != std::string::npos) {
+      return false;
+    }
+    value = std::atoi(token.c_str());
+  }
+  int width = values[0], height = values[1], max_value = values[2];
+  if (width <= 0 || height <= 0 || max_value <= 0 || max_value > 65535) {
+    return false;
+  }
+  // a pixel is free if 1 - value / max_value < threshold
+  double free_above = (1.0 - free_threshold) * max_value;
+  OccupancyGrid result(height, width, CellStorage::BIT);
+  int sample_bytes = max_value > 255 ? 2 : 1;
+  std::vector<unsigned char> row(std::size_t(width) * sample_bytes);
+  bool complete = result.fillRows([&](int, uint8_t *cells) {
+    if (magic == "P5") {
+      // the single white space after maxval was consumed with the token
+      if (!file.read(reinterpret_cast<char *>(row.data()), row.size())) {
+        return false;
+      }
+    }
+    for (int x = 0; x < width; x++) {
+      int value;
+      if (magic == "P2") {
+        if (!(file >> value)) {
+          return false;
+        }
+      } else if (sample_bytes == 2) {
+        value = (row[2 * x] << 8) | row[2 * x + 1]; // most significant first
+      } else {
+        value = row[x];
+      }
+      cells[x] = value <= free_above ? 1 : 0;
+    }
+    return true;
+  });
+  if (!complete) {
+    return false;
+  }
+  grid = result;
+  return true;
+}
+
+bool MapFile::readMovingAi(const std::string &file_name, OccupancyGrid &grid) {
+  std::ifstream file(file_name);
+  std::string key, value;
+  int height = -1, width = -1;
+  // "type octile", "height H", "width W" in any order, then "map"
+  while (file >> key && key != "map") {
+    if (!(file >> value)) {
+      return false;
+    }
+    if (key == "height") {
+      height = std::atoi(value.c_str());
+    } else if (key == "width") {
+      width = std::atoi(value.c_str());
+    }
+  }
+  if (key != "map" || height <= 0 || width <= 0) {
+    return false;
+  }
+  OccupancyGrid result(height, width, CellStorage::BIT);
+  std::string line;
+  bool complete = result.fillRows([&](int, uint8_t *cells) {
+    if (!(file >> line) || int(line.size()) < width) {
+      return false;
+    }
+    for (int x = 0; x < width; x++) {
+      char terrain = line[x];
+      cells[x] = terrain != '.' && terrain != 'G' && terrain != 'S' ? 1 : 0;
+    }
+    return true;
+  });
+  if (!complete) {
+    return false;
+  }
+  grid = result;
+  return true;
+}
+
+bool MapFile::convertPgm(const std::string &pgm_name,
+                         const std::string &file_name, double resolution,
+                         double free_threshold) {
+  OccupancyGrid grid;
+  return readPgm(pgm_name, grid, free_threshold) &&
+         save(file_name, grid, resolution);
+}
+
+bool MapFile::convertMovingAi(const std::string &map_name,
+                              const std::string &file_name) {
+  OccupancyGrid grid;
+  return readMovingAi(map_name, grid) && save(file_name, grid, 1.0);
+}
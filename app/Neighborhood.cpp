@@ -0,0 +1,49 @@
+/* Copyright (C)
+ * 2019 - Bhargav Dandamudi
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the 'Software'), to deal in the Software without
+ * restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit
+ * persons to whom the Software is furnished to do so,subject to
+ * the following conditions:
+ * The above copyright notice and this permission notice shall
+ * be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED ''AS IS'', WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR
+ * ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM,OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+/**
+ * @file Neighborhood.cpp
+ * @brief  Storage of the neighborhood move tables
+ * @author Bhargav Dandamudi
+ * @version 1
+ * @date 2019-04-24
+ */
+#include "../include/Neighborhood.h"
+
+// the tables are indexed at run time and the constants may be bound to
+// references, both need a definition before C++17
+constexpr int FourConnected::SIZE;
+constexpr int FourConnected::DY[];
+constexpr int FourConnected::DX[];
+constexpr float FourConnected::COST[];
+constexpr bool FourConnected::UNIFORM;
+constexpr bool FourConnected::CUT_CORNERS;
+constexpr float EightConnected::DIAGONAL;
+constexpr int EightConnected::SIZE;
+constexpr int EightConnected::DY[];
+constexpr int EightConnected::DX[];
+constexpr float EightConnected::COST[];
+constexpr bool EightConnected::UNIFORM;
+constexpr bool EightConnected::CUT_CORNERS;
+constexpr bool EightConnectedCutCorners::CUT_CORNERS;
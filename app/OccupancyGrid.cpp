@@ -0,0 +1,112 @@
+/* Copyright (C)
+ * 2019 - Bhargav Dandamudi
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the 'Software'), to deal in the Software without
+ * restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit
+ * persons to whom the Software is furnished to do so,subject to
+ * the following conditions:
+ * The above copyright notice and this permission notice shall
+ * be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED ''AS IS'', WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR
+ * ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM,OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+/**
+ * @file OccupancyGrid.cpp
+ * @brief  Occupancy grid constructors and conversions
+ * @author Bhargav Dandamudi
+ * @version 1
+ * @date 2019-04-11
+ */
+#include "../include/OccupancyGrid.h"
+#include <atomic>
+
+uint64_t OccupancyGrid::nextVersion() {
+  // shared by all grids, so no two grids or edits ever get the same number
+  static std::atomic<uint64_t> counter(0);
+  return ++counter;
+}
+
+OccupancyGrid::OccupancyGrid()
+    : height_(0), width_(0), words_per_row_(0), storage_(CellStorage::BYTE),
+      version_(nextVersion()) {}
+
+OccupancyGrid::OccupancyGrid(int height, int width, CellStorage storage)
+    : height_(height), width_(width), words_per_row_((width + 63) / 64),
+      storage_(storage), version_(nextVersion()) {
+  if (storage == CellStorage::BYTE) {
+    this->bytes_.assign(std::size_t(height) * std::size_t(width), 0);
+  } else {
+    this->words_.assign(
+        std::size_t(height) * std::size_t(this->words_per_row_), 0);
+  }
+}
+
+OccupancyGrid::OccupancyGrid(const std::vector<std::vector<int>> &world_map,
+                             CellStorage storage)
+    : OccupancyGrid(int(world_map.size()),
+                    world_map.empty() ? 0 : int(world_map[0].size()),
+                    storage) {
+  for (int y = 0; y < this->height_; y++) {
+    for (int x = 0; x < this->width_; x++) {
+      storeValue(y * this->width_ + x, world_map[y][x]);
+    }
+  }
+}
+
+void OccupancyGrid::setValue(int index, int value) {
+  this->version_ = nextVersion();
+  storeValue(index, value);
+}
+
+bool OccupancyGrid::fillRows(
+    const std::function<bool(int, uint8_t *)> &read_row) {
+  std::vector<uint8_t> row(this->width_);
+  bool complete = true;
+  for (int y = 0; y < this->height_ && complete; y++) {
+    complete = read_row(y, row.data());
+    for (int x = 0; x < this->width_ && complete; x++) {
+      storeValue(y * this->width_ + x, row[x]);
+    }
+  }
+  this->version_ = nextVersion();
+  return complete;
+}
+
+void OccupancyGrid::storeValue(int index, int value) {
+  if (this->storage_ == CellStorage::BYTE) {
+    this->bytes_[index] = uint8_t(value);
+    return;
+  }
+  int y = index / this->width_;
+  int x = index - y * this->width_;
+  uint64_t &word = this->words_[y * this->words_per_row_ + (x >> 6)];
+  uint64_t bit = uint64_t(1) << (x & 63);
+  if (value == 1) {
+    word |= bit;
+  } else {
+    word &= ~bit;
+  }
+}
+
+std::vector<std::vector<int>> OccupancyGrid::toVector() const {
+  std::vector<std::vector<int>> world_map(this->height_,
+                                          std::vector<int>(this->width_, 0));
+  for (int y = 0; y < this->height_; y++) {
+    for (int x = 0; x < this->width_; x++) {
+      world_map[y][x] = getValue(y * this->width_ + x);
+    }
+  }
+  return world_map;
+}
@@ -0,0 +1,363 @@
+/* Copyright (C)
+ * 2019 - Bhargav Dandamudi
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the 'Software'), to deal in the Software without
+ * restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit
+ * persons to whom the Software is furnished to do so,subject to
+ * the following conditions:
+ * The above copyright notice and this permission notice shall
+ * be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED ''AS IS'', WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR
+ * ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM,OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+/**
+ * @file PathCache.cpp
+ * @brief  Definitions of PathCache
+ * @author Bhargav Dandamudi
+ * @version 1
+ * @date 2019-04-27
+ */
+#include "../include/PathCache.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+// octile distance, a lower bound of the path length for four and eight
+// connected moves
+static double lowerBound(std::pair<int, int> a, std::pair<int, int> b) {
+  int dy = std::abs(a.first - b.first);
+  int dx = std::abs(a.second - b.second);
+  return std::max(dy, dx) + (std::sqrt(2.0) - 1.0) * std::min(dy, dx);
+}
+
+std::size_t PathCache::KeyHash::operator()(const Key &key) const {
+  uint64_t start = uint64_t(uint32_t(key.start.first)) << 32 |
+                   uint32_t(key.start.second);
+  uint64_t goal = uint64_t(uint32_t(key.goal.first)) << 32 |
+                  uint32_t(key.goal.second);
+  uint64_t hash = 14695981039346656037ull;
+  for (uint64_t value : {start, goal, key.planner, key.version}) {
+    hash = (hash ^ value) * 1099511628211ull;
+  }
+  return std::size_t(hash);
+}
+
+PathCache::PathCache(std::size_t capacity)
+    : capacity_(capacity), cells_(0), hits_(0), misses_(0) {}
+
+/* ----------------------------------------------------------------*/
+/**
+ * @brief  Looks a path up and marks it as most recently used
+ *
+ * @param start
+ * @param goal
+ * @param planner
+ * @param version
+ * @param path
+ *
+ * @return true if the path was cached
+ */
+/* ----------------------------------------------------------------*/
+bool PathCache::find(std::pair<int, int> start, std::pair<int, int> goal,
+                     uint64_t planner, uint64_t version,
+                     std::stack<std::pair<int, int>> &path) {
+  std::lock_guard<std::mutex> lock(this->mutex_);
+  auto found = this->index_.find(Key{start, goal, planner, version});
+  if (found == this->index_.end()) {
+    this->misses_++;
+    return false;
+  }
+  this->hits_++;
+  auto entry = found->second;
+  this->entries_.splice(this->entries_.begin(), this->entries_, entry);
+  path = std::stack<std::pair<int, int>>();
+  for (const std::pair<int, int> &cell : entry->cells) {
+    path.push(cell);
+  }
+  return true;
+}
+
+/* ----------------------------------------------------------------*/
+/**
+ * @brief  Keeps a path, dropping the least recently used paths until its
+ *          cells fit. A path longer than the capacity is not kept.
+ *
+ * @param start
+ * @param goal
+ * @param planner
+ * @param version
+ * @param path
+ * @param cost_map
+ */
+/* ----------------------------------------------------------------*/
+void PathCache::insert(std::pair<int, int> start, std::pair<int, int> goal,
+                       uint64_t planner, uint64_t version,
+                       const std::stack<std::pair<int, int>> &path,
+                       const CostMap *cost_map) {
+  Entry entry;
+  entry.key = Key{start, goal, planner, version};
+  entry.cells.reserve(path.size());
+  std::stack<std::pair<int, int>> rest = path;
+  while (!rest.empty()) {
+    entry.cells.push_back(rest.top());
+    rest.pop();
+  }
+  std::reverse(entry.cells.begin(), entry.cells.end());
+  entry.reachable = start == goal || entry.cells.size() > 1;
+  entry.cost = 0;
+  entry.min_step = cost_map == nullptr ? 1.0 : 1.0 + cost_map->getMinCost();
+  entry.min_y = entry.max_y = start.first;
+  entry.min_x = entry.max_x = start.second;
+  for (std::size_t i = 0; i < entry.cells.size(); i++) {
+    const std::pair<int, int> &cell = entry.cells[i];
+    entry.min_y = std::min(entry.min_y, cell.first);
+    entry.max_y = std::max(entry.max_y, cell.first);
+    entry.min_x = std::min(entry.min_x, cell.second);
+    entry.max_x = std::max(entry.max_x, cell.second);
+    if (i > 0) {
+      bool diagonal = cell.first != entry.cells[i - 1].first &&
+                      cell.second != entry.cells[i - 1].second;
+      double step = cost_map == nullptr
+                        ? 1.0
+                        : 1.0 + cost_map->getCost(cell.first *
+                                                      cost_map->getWidth() +
+                                                  cell.second);
+      entry.cost += diagonal ? std::sqrt(2.0) * step : step;
+    }
+  }
+
+  std::lock_guard<std::mutex> lock(this->mutex_);
+  auto found = this->index_.find(entry.key);
+  if (found != this->index_.end()) {
+    erase(found->second);
+  }
+  if (entry.cells.size() > this->capacity_) {
+    return;
+  }
+  while (this->cells_ + entry.cells.size() > this->capacity_) {
+    erase(std::prev(this->entries_.end()));
+  }
+  this->cells_ += entry.cells.size();
+  this->entries_.push_front(std::move(entry));
+  this->index_[this->entries_.front().key] = this->entries_.begin();
+}
+
+/* ----------------------------------------------------------------*/
+/**
+ * @brief  Cached path of the query, planned and kept on a miss
+ *
+ * @param planner
+ * @param world_map
+ * @param start
+ * @param goal
+ * @param version
+ *
+ * @return Path
+ */
+/* ----------------------------------------------------------------*/
+std::stack<std::pair<int, int>>
+PathCache::search(optimalPlanner &planner, const GridView &world_map,
+                  std::pair<int, int> start, std::pair<int, int> goal,
+                  uint64_t version) {
+  uint64_t type = plannerType(planner);
+  std::stack<std::pair<int, int>> path;
+  if (!find(start, goal, type, version, path)) {
+    path = planner.search(world_map, start, goal);
+    // the planner ignores a cost map of another size
+    std::shared_ptr<const CostMap> cost_map = planner.getCostMap();
+    if (cost_map && (cost_map->getHeight() != world_map.getHeight() ||
+                     cost_map->getWidth() != world_map.getWidth())) {
+      cost_map = nullptr;
+    }
+    insert(start, goal, type, version, path, cost_map.get());
+  }
+  return path;
+}
+
+/* ----------------------------------------------------------------*/
+/**
+ * @brief  Connectivity in the low bits, the address of the cost map above,
+ *          so unit cost planners and those of every cost map differ
+ *
+ * @param planner
+ *
+ * @return planner type
+ */
+/* ----------------------------------------------------------------*/
+uint64_t PathCache::plannerType(optimalPlanner &planner) {
+  uint64_t cost_map = uint64_t(uintptr_t(planner.getCostMap().get()));
+  return cost_map << 4 | uint64_t(planner.getConnectivity());
+}
+
+/* ----------------------------------------------------------------*/
+/**
+ * @brief  A blocked cell breaks the paths through it only. A freed cell
+ *          may connect a failed query or shorten a path, when the shortest
+ *          way over the cell is shorter than the path. Without corner
+ *          cutting it also opens the diagonal steps between two of its
+ *          orthogonal neighbors, which pass its corner without entering
+ *          it; the shortest way over one of those steps is checked too.
+ *          Both ways are bounded by the octile distance times the lowest
+ *          step cost, compared with the cost of the path, as a detour over
+ *          cheaper cells may take more steps. Likewise a blocked cell
+ *          breaks the diagonal steps past its corner, unless the planner
+ *          cuts corners.
+ *
+ * @param entry
+ * @param cell
+ * @param freed
+ *
+ * @return true if the path has to be dropped
+ */
+/* ----------------------------------------------------------------*/
+bool PathCache::isAffected(const Entry &entry, std::pair<int, int> cell,
+                           bool freed) {
+  // neighbors in the order top, right, bottom, left: each two in a row
+  // are diagonal to each other
+  static const int DY[4] = {-1, 0, 1, 0};
+  static const int DX[4] = {0, 1, 0, -1};
+  if (freed) {
+    if (!entry.reachable) {
+      return true;
+    }
+    double over_cell = entry.min_step * (lowerBound(entry.key.start, cell) +
+                                         lowerBound(cell, entry.key.goal));
+    if (over_cell < entry.cost - 1e-9) {
+      return true;
+    }
+    for (int k = 0; k < 4; k++) {
+      std::pair<int, int> a(cell.first + DY[k], cell.second + DX[k]);
+      std::pair<int, int> b(cell.first + DY[(k + 1) % 4],
+                            cell.second + DX[(k + 1) % 4]);
+      double over_step =
+          entry.min_step * (std::sqrt(2.0) +
+                            std::min(lowerBound(entry.key.start, a) +
+                                         lowerBound(b, entry.key.goal),
+                                     lowerBound(entry.key.start, b) +
+                                         lowerBound(a, entry.key.goal)));
+      if (over_step < entry.cost - 1e-9) {
+        return true;
+      }
+    }
+  }
+  // the steps past the corner of the cell stay within one cell of it
+  if (cell.first < entry.min_y - 1 || cell.first > entry.max_y + 1 ||
+      cell.second < entry.min_x - 1 || cell.second > entry.max_x + 1) {
+    return false;
+  }
+  if (std::find(entry.cells.begin(), entry.cells.end(), cell) !=
+      entry.cells.end()) {
+    return true;
+  }
+  Connectivity connectivity = Connectivity(entry.key.planner & 15);
+  if (freed || connectivity == Connectivity::EIGHT_CONNECTED_CUT_CORNERS) {
+    return false;
+  }
+  for (std::size_t i = 1; i < entry.cells.size(); i++) {
+    const std::pair<int, int> &a = entry.cells[i - 1];
+    const std::pair<int, int> &b = entry.cells[i];
+    // a diagonal step passes the two cells sharing its corners
+    if (a.first != b.first && a.second != b.second &&
+        ((cell.first == a.first && cell.second == b.second) ||
+         (cell.first == b.first && cell.second == a.second))) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/* ----------------------------------------------------------------*/
+/**
+ * @brief  Drops the affected paths of the old version, the others are
+ *          keyed by the new version from now on
+ *
+ * @param world_map
+ * @param cells
+ * @param old_version
+ * @param new_version
+ *
+ * @return number of dropped paths
+ */
+/* ----------------------------------------------------------------*/
+int PathCache::updateCells(const GridView &world_map,
+                           const std::vector<std::pair<int, int>> &cells,
+                           uint64_t old_version, uint64_t new_version) {
+  std::vector<bool> freed(cells.size());
+  for (std::size_t i = 0; i < cells.size(); i++) {
+    freed[i] = world_map.isInside(cells[i]) && !world_map.isOccupied(cells[i]);
+  }
+  std::lock_guard<std::mutex> lock(this->mutex_);
+  int dropped = 0;
+  for (auto entry = this->entries_.begin(); entry != this->entries_.end();) {
+    auto next = std::next(entry);
+    if (entry->key.version == old_version) {
+      bool affected = false;
+      for (std::size_t i = 0; i < cells.size() && !affected; i++) {
+        affected = isAffected(*entry, cells[i], freed[i]);
+      }
+      if (affected) {
+        erase(entry);
+        dropped++;
+      } else {
+        // a path kept under the new version replaces a stale one there
+        this->index_.erase(entry->key);
+        entry->key.version = new_version;
+        auto stale = this->index_.find(entry->key);
+        if (stale != this->index_.end()) {
+          if (stale->second == next) {
+            ++next;
+          }
+          erase(stale->second);
+        }
+        this->index_[entry->key] = entry;
+      }
+    }
+    entry = next;
+  }
+  return dropped;
+}
+
+void PathCache::erase(std::list<Entry>::iterator entry) {
+  this->cells_ -= entry->cells.size();
+  this->index_.erase(entry->key);
+  this->entries_.erase(entry);
+}
+
+void PathCache::clear() {
+  std::lock_guard<std::mutex> lock(this->mutex_);
+  this->entries_.clear();
+  this->index_.clear();
+  this->cells_ = 0;
+}
+
+int PathCache::size() {
+  std::lock_guard<std::mutex> lock(this->mutex_);
+  return int(this->entries_.size());
+}
+
+std::size_t PathCache::getCellCount() {
+  std::lock_guard<std::mutex> lock(this->mutex_);
+  return this->cells_;
+}
+
+uint64_t PathCache::getHits() {
+  std::lock_guard<std::mutex> lock(this->mutex_);
+  return this->hits_;
+}
+
+uint64_t PathCache::getMisses() {
+  std::lock_guard<std::mutex> lock(this->mutex_);
+  return this->misses_;
+}
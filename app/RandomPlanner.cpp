@@ -31,6 +31,7 @@
  */
 #include "../include/RandomPlanner.h"
 #include "../include/Node.h"
+#include <random>
 
 /* ----------------------------------------------------------------*/
 /**
@@ -47,7 +48,51 @@ RandomPlanner::RandomPlanner() {}
  * @param goal goal location of robot
  */
 /* ----------------------------------------------------------------*/
-RandomPlanner::RandomPlanner(std::vector<std::vector<int>> map,
+RandomPlanner::RandomPlanner(const std::vector<std::vector<int>> &map,
+                             std::pair<int, int> robot_pose,
+                             std::pair<int, int> goal_pose)
+    : RandomPlanner(std::make_shared<const OccupancyGrid>(map), robot_pose,
+                    goal_pose) {}
+/* ----------------------------------------------------------------*/
+/**
+ * @brief  Parameterised constructor taking an occupancy grid, the grid is
+ *          copied once
+ *
+ * @param map
+ * @param robot_pose starting location of robot
+ * @param goal goal location of robot
+ */
+/* ----------------------------------------------------------------*/
+RandomPlanner::RandomPlanner(const OccupancyGrid &map,
+                             std::pair<int, int> robot_pose,
+                             std::pair<int, int> goal_pose)
+    : RandomPlanner(std::make_shared<const OccupancyGrid>(map), robot_pose,
+                    goal_pose) {}
+/* ----------------------------------------------------------------*/
+/**
+ * @brief  Constructor taking ownership of an already converted grid
+ *
+ * @param map
+ * @param robot_pose starting location of robot
+ * @param goal goal location of robot
+ */
+/* ----------------------------------------------------------------*/
+RandomPlanner::RandomPlanner(std::shared_ptr<const OccupancyGrid> map,
+                             std::pair<int, int> robot_pose,
+                             std::pair<int, int> goal_pose)
+    : RandomPlanner(GridView(*map), robot_pose, goal_pose) {
+  this->owned_map = map;
+}
+/* ----------------------------------------------------------------*/
+/**
+ * @brief  Parameterised constructor taking a map view, nothing is copied
+ *
+ * @param map
+ * @param robot_pose starting location of robot
+ * @param goal goal location of robot
+ */
+/* ----------------------------------------------------------------*/
+RandomPlanner::RandomPlanner(const GridView &map,
                              std::pair<int, int> robot_pose,
                              std::pair<int, int> goal_pose) {
   this->world_map = map;
@@ -55,9 +100,8 @@ RandomPlanner::RandomPlanner(std::vector<std::vector<int>> map,
   this->goal_pose = goal_pose;   // destination of the robot
   this->current_node.position_ = robot_pose;
   // variable containing moving robot position
-  this->x_length = int(world_map.size()) - 1; // size of map in x direction
-  this->y_length =
-      int(world_map[1].size()) - 1; /// size of the map in y direction
+  this->x_length = map.getWidth() - 1;  // size of map in x direction
+  this->y_length = map.getHeight() - 1; // size of the map in y direction
 
   this->setStartNode();
   this->setGoalNode();
@@ -71,13 +115,34 @@ RandomPlanner::RandomPlanner(std::vector<std::vector<int>> map,
  * 3 -> DOwn
  * 4 ->  Right
  *
+ * Drawn from the generator of this planner, so every call gives a new
+ * direction and planners on other threads are not affected.
+ *
  * @return  direction
  */
 /* ----------------------------------------------------------------*/
 int RandomPlanner::randomDirection() {
-  int direction;  // to generate random direction
-  srand(time(0)); // random number generation based on time
-  return direction = rand() % 4 + 1;
+  return int(this->random_.below(4)) + 1;
+}
+
+/* ----------------------------------------------------------------*/
+/**
+ * @brief  Restarts the random directions from a seed. The same seed and the
+ *          same queries in the same order replay the same walks.
+ *
+ * @param seed
+ */
+/* ----------------------------------------------------------------*/
+void RandomPlanner::setSeed(uint64_t seed) {
+  this->seed_ = seed;
+  this->random_.seed(seed);
+}
+
+uint64_t RandomPlanner::getSeed() { return this->seed_; }
+
+uint64_t RandomPlanner::newSeed() {
+  std::random_device device;
+  return (uint64_t(device()) << 32) | device();
 }
 
 // defining getter function for goal and starting location of therobot;
@@ -91,7 +156,7 @@ std::pair<int, int> RandomPlanner::getStart() { return this->robot_pose; }
  */
 /* ----------------------------------------------------------------*/
 void RandomPlanner::setGoalNode() {
-  this->goal_node.value_ = this->world_map[goal_pose.first][goal_pose.second];
+  this->goal_node.value_ = this->world_map.getValue(goal_pose);
   this->goal_node.position_ = this->goal_pose;
 }
 /* ----------------------------------------------------------------*/
@@ -100,8 +165,7 @@ void RandomPlanner::setGoalNode() {
  */
 /* ----------------------------------------------------------------*/
 void RandomPlanner::setStartNode() {
-  this->start_node.value_ =
-      this->world_map[robot_pose.first][robot_pose.second];
+  this->start_node.value_ = this->world_map.getValue(robot_pose);
   this->start_node.position_ = this->robot_pose;
   //  this->start_node.parent_ = &start_node;
 }
@@ -120,13 +184,22 @@ bool RandomPlanner::isObstacle(std::pair<int, int> to_be_checked) {
   if (to_be_checked.first > y_length || to_be_checked.first < 0 ||
       to_be_checked.second > x_length || to_be_checked.second < 0) {
     return true;
-  } else if (this->world_map[to_be_checked.first][to_be_checked.second] == 1) {
+  } else if (this->world_map.isOccupied(to_be_checked)) {
     return true;
   } else
     return false;
 }
 int RandomPlanner::getXLength() { return this->x_length; }
 int RandomPlanner::getYLength() { return this->y_length; }
+
+void RandomPlanner::setComponentIndex(
+    std::shared_ptr<const ComponentIndex> index) {
+  this->components = index;
+}
+
+std::shared_ptr<const ComponentIndex> RandomPlanner::getComponentIndex() {
+  return this->components;
+}
 /* ----------------------------------------------------------------*/
 /**
  * @brief  Update Last steps with new Node, remove first in and add new element
@@ -201,8 +274,7 @@ Node RandomPlanner::moveUp(Node someNode) {
   // tempNode.parent_ = &someNode;
   tempNode.position_.first = someNode.position_.first - 1;
   tempNode.position_.second = someNode.position_.second;
-  tempNode.value_ =
-      this->world_map[tempNode.position_.first][tempNode.position_.second];
+  tempNode.value_ = this->world_map.getValue(tempNode.position_);
 
   return tempNode;
 }
@@ -220,8 +292,7 @@ Node RandomPlanner::moveLeft(Node someNode) {
   // tempNode.parent_ = &someNode;
   tempNode.position_.first = someNode.position_.first;
   tempNode.position_.second = someNode.position_.second - 1;
-  tempNode.value_ =
-      this->world_map[tempNode.position_.first][tempNode.position_.second];
+  tempNode.value_ = this->world_map.getValue(tempNode.position_);
   return tempNode;
 }
 
@@ -239,8 +310,7 @@ Node RandomPlanner::moveDown(Node someNode) {
   // tempNode.parent_ = &someNode;
   tempNode.position_.first = someNode.position_.first + 1;
   tempNode.position_.second = someNode.position_.second;
-  tempNode.value_ =
-      this->world_map[tempNode.position_.first][tempNode.position_.second];
+  tempNode.value_ = this->world_map.getValue(tempNode.position_);
   return tempNode;
 }
 
@@ -258,10 +328,23 @@ Node RandomPlanner::moveRight(Node someNode) {
   // tempNode.parent_ = &someNode;
   tempNode.position_.first = someNode.position_.first;
   tempNode.position_.second = someNode.position_.second + 1;
-  tempNode.value_ =
-      this->world_map[tempNode.position_.first][tempNode.position_.second];
+  tempNode.value_ = this->world_map.getValue(tempNode.position_);
   return tempNode;
 }
+/* ----------------------------------------------------------------*/
+/**
+ * @brief  Moves the robot to a free location, updating memory and path
+ *
+ * @param position location to move to
+ */
+/* ----------------------------------------------------------------*/
+void RandomPlanner::stepTo(std::pair<int, int> position) {
+  this->current_node.position_ = position;
+  this->current_node.value_ = this->world_map.getValue(position);
+  this->updateLastSteps(this->current_node); // updated node to memory
+  this->path_.push_back(position); // as we moved to new location, updating
+                                   // to keep track of path
+}
 /*
  * Directions
  * 1- Up
@@ -283,22 +366,13 @@ Node RandomPlanner::moveRight(Node someNode) {
 std::vector<std::pair<int, int>>
 RandomPlanner::findNeighbors(std::pair<int, int> position) {
   // possible neighbors if moved in orthogonal direction
-  std::pair<int, int> up(position.first - 1, position.second);
-  std::pair<int, int> left(position.first, position.second - 1);
-  std::pair<int, int> down(position.first + 1, position.second);
-  std::pair<int, int> right(position.first, position.second + 1);
   std::vector<std::pair<int, int>> neighbors;
-  if (!this->isObstacle(up)) {
-    neighbors.push_back(up);
-  }
-  if (!this->isObstacle(left)) {
-    neighbors.push_back(left);
-  }
-  if (!this->isObstacle(down)) {
-    neighbors.push_back(down);
-  }
-  if (!this->isObstacle(right)) {
-    neighbors.push_back(right);
+  for (int k = 0; k < FourConnected::SIZE; k++) {
+    std::pair<int, int> neighbor(position.first + FourConnected::DY[k],
+                                 position.second + FourConnected::DX[k]);
+    if (!this->isObstacle(neighbor)) {
+      neighbors.push_back(neighbor);
+    }
   }
   return neighbors;
 }
@@ -331,9 +405,21 @@ bool RandomPlanner::allNeighborsInMemory(std::pair<int, int> position) {
  */
 /* ----------------------------------------------------------------*/
 std::vector<std::pair<int, int>>
-RandomPlanner::search(std::vector<std::vector<int>> map,
+RandomPlanner::search(const std::vector<std::vector<int>> &map,
                       std::pair<int, int> robot_pose,
                       std::pair<int, int> goal_pose) {
+  // the nested vector has to be converted once, the planner owns the result
+  this->owned_map = std::make_shared<const OccupancyGrid>(map);
+  return search(GridView(*this->owned_map), robot_pose, goal_pose);
+}
+/* ----------------------------------------------------------------*/
+/**
+ * @brief  Random search on a map view, the map is not copied
+ */
+/* ----------------------------------------------------------------*/
+std::vector<std::pair<int, int>>
+RandomPlanner::search(const GridView &map, std::pair<int, int> robot_pose,
+                      std::pair<int, int> goal_pose) {
   // updating all this variables as in constructor to maintain
   // common interface for all planners
 
@@ -341,140 +427,74 @@ RandomPlanner::search(std::vector<std::vector<int>> map,
   this->robot_pose = robot_pose;
   this->goal_pose = goal_pose;
   this->current_node.position_ = robot_pose;
-  this->x_length = int(world_map.size()) - 1; // size of map in x direction
-  this->y_length = int(world_map[1].size()) - 1;
+  this->x_length = map.getWidth() - 1;  // size of map in x direction
+  this->y_length = map.getHeight() - 1; // size of map in y direction
 
-  this->setStartNode();
-  this->setGoalNode();
-  this->current_node = this->start_node;
-  this->path_.push_back(start_node.position_);
+  // every search walks a new path with a fresh memory
+  this->path_.clear();
+  this->last_steps.clear();
+  this->path_.push_back(robot_pose);
   int steps_taken = 0;
 
-  //  Sanity checks for goal and starting locaition
-
-  if (this->start_node.position_ == this->goal_node.position_) {
-    std::cout << "start node and goal node are same" << std::endl;
+  //  Sanity checks for goal and starting locaition, checked before the
+  //  cells are read
+  if (!map.isInside(robot_pose)) {
+    this->status_ = PlanStatus::INVALID_START;
+    return path_;
   }
-
+  if (!map.isInside(goal_pose)) {
+    this->status_ = PlanStatus::INVALID_GOAL;
+    return path_;
+  }
+  this->setStartNode();
+  this->setGoalNode();
+  this->current_node = this->start_node;
   if (isObstacle(this->start_node.position_)) {
-    std::cout << "start node is Obstacle" << std::endl;
+    this->status_ = PlanStatus::BLOCKED_START;
+    return path_;
   }
   if (isObstacle(this->goal_node.position_)) {
-    std::cout << "goal node is Obstacle" << std::endl;
+    this->status_ = PlanStatus::BLOCKED_GOAL;
+    return path_;
+  }
+  if (this->start_node.position_ == this->goal_node.position_) {
+    this->status_ = PlanStatus::SUCCESS;
+    return path_;
+  }
+  // no number of random steps reaches a goal in another region
+  if (this->components && this->components->matches(map) &&
+      !this->components->isConnected(this->start_node.position_,
+                                     this->goal_node.position_)) {
+    this->status_ = PlanStatus::UNREACHABLE;
+    return path_;
   }
   //
   // Starting loop for robot to move in random direction
   //
   //
   while (steps_taken <= this->max_step_number) {
-    int dir = randomDirection();
-    // std::cout << "random direction: " << dir << std::endl;
+    // directions 1-4 are the orthogonal moves of FourConnected in order
+    int dir = randomDirection() - 1;
 
-    if (dir == 1) {
-      std::pair<int, int> cu_pose = this->current_node.position_;
-      cu_pose.first = cu_pose.first - 1;
-      if (!isObstacle(cu_pose)) { // validity of node
-        Node tempNode = this->moveUp(current_node);
-        // upFlag = true;
-        if (!checkLastNSteps(tempNode)) { // if its not in memory
-          this->current_node = tempNode;
-          this->updateLastSteps(this->current_node); // updated node to memory
-          this->path_.push_back(
-              this->current_node.position_); // as we moved to new
-                                             // location , updating
-                                             // to keep track of
-                                             // path
-          steps_taken++;                     // iupdating number of steps taken
-        }
-      }
-    }
-    if (dir == 2) {
-      std::pair<int, int> cu_pose = this->current_node.position_;
-      cu_pose.second = cu_pose.second - 1;
-      if (!isObstacle(cu_pose)) {
-        Node tempNode = this->moveLeft(current_node);
-        if (!checkLastNSteps(tempNode)) {
-          this->current_node = tempNode;
-          this->updateLastSteps(this->current_node);
-          this->path_.push_back(this->current_node.position_);
-          steps_taken++;
-        }
-      }
-    }
-    if (dir == 3) {
-      std::pair<int, int> cu_pose = this->current_node.position_;
-      cu_pose.first = cu_pose.first + 1;
-      if (!isObstacle(cu_pose)) {
-        Node tempNode = this->moveDown(current_node);
-        if (!checkLastNSteps(tempNode)) {
-          this->current_node = tempNode;
-          this->updateLastSteps(this->current_node);
-          this->path_.push_back(this->current_node.position_);
-          steps_taken++;
-        }
-      }
-    }
-    if (dir == 4) {
-      std::pair<int, int> cu_pose = this->current_node.position_;
-      cu_pose.second = cu_pose.second + 1;
-      if (!isObstacle(cu_pose)) {
-        Node tempNode = this->moveRight(current_node);
-        if (!checkLastNSteps(tempNode)) {
-          this->current_node = tempNode;
-          this->updateLastSteps(this->current_node);
-          this->path_.push_back(this->current_node.position_);
-          steps_taken++;
-        }
-      }
+    std::pair<int, int> cu_pose(
+        this->current_node.position_.first + FourConnected::DY[dir],
+        this->current_node.position_.second + FourConnected::DX[dir]);
+    // validity of node, and not in memory
+    if (!isObstacle(cu_pose) && !checkLastNPositions(cu_pose)) {
+      this->stepTo(cu_pose);
+      steps_taken++; // updating number of steps taken
     }
     // if robot cannot move in any direction,all flags are 0 as all nodes
     // are visited before or blocked , then it can move in random direction
     // as produced by random direction generator function above
     //
     if (allNeighborsInMemory(current_node.position_)) {
-      if (dir == 1) {
-        std::pair<int, int> cu_pose = this->current_node.position_;
-        cu_pose.first = cu_pose.first - 1;
-        if (!isObstacle(cu_pose)) {
-          Node tempNode = this->moveUp(current_node);
-          this->current_node = tempNode;
-          this->updateLastSteps(this->current_node);
-          this->path_.push_back(this->current_node.position_);
-          steps_taken++;
-        }
-      }
-      if (dir == 2) {
-        std::pair<int, int> cu_pose = this->current_node.position_;
-        cu_pose.second = cu_pose.second - 1;
-        if (!isObstacle(cu_pose)) {
-          Node tempNode = this->moveLeft(current_node);
-          this->current_node = tempNode;
-          this->updateLastSteps(this->current_node);
-          this->path_.push_back(this->current_node.position_);
-          steps_taken++;
-        }
-      }
-      if (dir == 3) {
-        std::pair<int, int> cu_pose = this->current_node.position_;
-        cu_pose.first = cu_pose.first + 1;
-        if (!isObstacle(cu_pose)) {
-          Node tempNode = this->moveDown(current_node);
-          this->current_node = tempNode;
-          this->updateLastSteps(this->current_node);
-          this->path_.push_back(this->current_node.position_);
-          steps_taken++;
-        }
-      }
-      if (dir == 4) {
-        std::pair<int, int> cu_pose = this->current_node.position_;
-        cu_pose.second = cu_pose.second + 1;
-        if (!isObstacle(cu_pose)) {
-          Node tempNode = this->moveRight(current_node);
-          this->current_node = tempNode;
-          this->updateLastSteps(this->current_node);
-          this->path_.push_back(this->current_node.position_);
-          steps_taken++;
-        }
+      cu_pose = std::make_pair(
+          this->current_node.position_.first + FourConnected::DY[dir],
+          this->current_node.position_.second + FourConnected::DX[dir]);
+      if (!isObstacle(cu_pose)) {
+        this->stepTo(cu_pose);
+        steps_taken++;
       }
     }
     // break the loop before hand if we reach goal
@@ -482,23 +502,40 @@ RandomPlanner::search(std::vector<std::vector<int>> map,
       break;
     }
   }
-  // if we cannot reach goal in required number of steps then print the
-  // following
-  if (this->current_node.position_ != this->goal_node.position_) {
-    std::cout << "goal not found" << std::endl;
-  }
+  // the goal may not be reached in the required number of steps
+  this->status_ = this->current_node.position_ == this->goal_node.position_
+                      ? PlanStatus::SUCCESS
+                      : PlanStatus::STEP_LIMIT;
+  return path_;
+}
 
-  // printing path if found
-  if (this->current_node.position_ == this->goal_node.position_) {
-    for (int i = 0; i < int(path_.size()); i++) {
-      if (i != int(path_.size()) - 1) {
-        std::cout << "(" << path_[i].first << "," << path_[i].second << ") "
-                  << ",";
-      } else {
-        std::cout << "(" << path_[i].first << "," << path_[i].second << ")"
-                  << std::endl;
-      }
-    }
+/* ----------------------------------------------------------------*/
+/**
+ * @brief  Random search returning status, path and statistics, the steps
+ *          taken count as expansions
+ *
+ * @param map
+ * @param robot_pose
+ * @param goal_pose
+ *
+ * @return result of the walk
+ */
+/* ----------------------------------------------------------------*/
+PlanResult RandomPlanner::plan(const GridView &map,
+                               std::pair<int, int> robot_pose,
+                               std::pair<int, int> goal_pose) {
+  StatsTimer timer;
+  PlanResult result;
+  std::vector<std::pair<int, int>> path = search(map, robot_pose, goal_pose);
+  result.stats.search_ms = timer.lap();
+  result.stats.searches = 1;
+  result.stats.expansions = uint64_t(path.size() - 1);
+  result.status = this->status_;
+  if (this->status_ == PlanStatus::SUCCESS ||
+      this->status_ == PlanStatus::STEP_LIMIT) {
+    result.path = std::move(path);
   }
-  return path_;
+  return result;
 }
+
+PlanStatus RandomPlanner::getStatus() { return this->status_; }
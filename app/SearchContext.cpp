@@ -0,0 +1,101 @@
+/* Copyright (C)
+ * 2019 - Bhargav Dandamudi
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the 'Software'), to deal in the Software without
+ * restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit
+ * persons to whom the Software is furnished to do so,subject to
+ * the following conditions:
+ * The above copyright notice and this permission notice shall
+ * be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED ''AS IS'', WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR
+ * ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM,OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+/**
+ * @file SearchContext.cpp
+ * @brief  Reusable search state definitions
+ * @author Bhargav Dandamudi
+ * @version 1
+ * @date 2019-04-13
+ */
+#include "../include/SearchContext.h"
+#include <limits>
+
+// generations are stored shifted left by one next to the closed flag
+static const uint32_t MAX_GENERATION = 0x7fffffffu;
+
+SearchContext::SearchContext(NodeLayout layout)
+    : layout_(layout), allocated_layout_(layout), cell_count_(0),
+      generation_(0) {}
+
+void SearchContext::beginSearch(int cell_count) {
+  if (cell_count != this->cell_count_ ||
+      this->layout_ != this->allocated_layout_ ||
+      this->generation_ == MAX_GENERATION) {
+    // state 0 never matches a running generation
+    CompactNode unreached = {FLT_MAX, -1, 0};
+    this->nodes_.clear();
+    this->g_costs_.clear();
+    this->parents_.clear();
+    this->states_.clear();
+    if (this->layout_ == NodeLayout::ARRAY_OF_STRUCTS) {
+      this->nodes_.assign(cell_count, unreached);
+    } else {
+      this->g_costs_.assign(cell_count, FLT_MAX);
+      this->parents_.assign(cell_count, -1);
+      this->states_.assign(cell_count, 0);
+    }
+    this->nodes_.shrink_to_fit();
+    this->g_costs_.shrink_to_fit();
+    this->parents_.shrink_to_fit();
+    this->states_.shrink_to_fit();
+    this->cell_count_ = cell_count;
+    this->allocated_layout_ = this->layout_;
+    this->generation_ = 0;
+  }
+  this->generation_++;
+}
+
+std::size_t SearchContext::getMemoryUsage() const {
+  return this->nodes_.capacity() * sizeof(CompactNode) +
+         this->g_costs_.capacity() * sizeof(float) +
+         this->parents_.capacity() * sizeof(int32_t) +
+         this->states_.capacity() * sizeof(uint32_t);
+}
+
+PublishedCosts::PublishedCosts() : size_(0), generation_(0) {}
+
+PublishedCosts::PublishedCosts(const PublishedCosts &)
+    : size_(0), generation_(0) {}
+
+PublishedCosts &PublishedCosts::operator=(const PublishedCosts &) {
+  this->costs_.reset();
+  this->size_ = 0;
+  this->generation_ = 0;
+  return *this;
+}
+
+void PublishedCosts::beginSearch(int cell_count) {
+  if (cell_count != this->size_ ||
+      this->generation_ == std::numeric_limits<uint32_t>::max()) {
+    // generation 0 is never used by a running search
+    this->costs_.reset(new std::atomic<uint64_t>[cell_count]);
+    for (int i = 0; i < cell_count; i++) {
+      this->costs_[i].store(0, std::memory_order_relaxed);
+    }
+    this->size_ = cell_count;
+    this->generation_ = 0;
+  }
+  this->generation_++;
+}
@@ -0,0 +1,289 @@
+/* Copyright (C)
+ * 2019 - Bhargav Dandamudi
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the 'Software'), to deal in the Software without
+ * restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit
+ * persons to whom the Software is furnished to do so,subject to
+ * the following conditions:
+ * The above copyright notice and this permission notice shall
+ * be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED ''AS IS'', WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR
+ * ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM,OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+/**
+ * @file TiledGrid.cpp
+ * @brief  Definitions of TiledGrid and TiledSearchContext
+ * @author Bhargav Dandamudi
+ * @version 1
+ * @date 2019-04-27
+ */
+#include "../include/TiledGrid.h"
+#include <algorithm>
+#include <cfloat>
+#include <cstring>
+
+constexpr int TiledGrid::TILE_SIZE;
+constexpr uint8_t TiledSearchContext::NO_MOVE;
+constexpr int TiledSearchContext::CELLS;
+
+/* ----------------------------------------------------------------*/
+/**
+ * @brief  Constructor, empty map
+ *
+ * @param capacity
+ */
+/* ----------------------------------------------------------------*/
+TiledGrid::TiledGrid(int capacity)
+    : tile_rows_(0), tile_columns_(0), capacity_(capacity < 1 ? 1 : capacity),
+      newest_(-1), oldest_(-1), last_id_(-1), last_cells_(nullptr),
+      loads_(0) {}
+
+/* ----------------------------------------------------------------*/
+/**
+ * @brief  Maps a map file and pages its cells from there
+ *
+ * @param name
+ *
+ * @return false if the file is not a valid map file
+ */
+/* ----------------------------------------------------------------*/
+bool TiledGrid::open(const std::string &name) {
+  std::unique_ptr<MapFile> file(new MapFile());
+  if (!file->open(name)) {
+    return false;
+  }
+  assign(file->getView());
+  this->file_ = std::move(file);
+  return true;
+}
+
+/* ----------------------------------------------------------------*/
+/**
+ * @brief  Pages the cells from a view
+ *
+ * @param world_map
+ */
+/* ----------------------------------------------------------------*/
+void TiledGrid::assign(const GridView &world_map) {
+  this->file_.reset();
+  this->source_ = world_map;
+  this->tile_rows_ = (world_map.getHeight() + TILE_SIZE - 1) / TILE_SIZE;
+  this->tile_columns_ = (world_map.getWidth() + TILE_SIZE - 1) / TILE_SIZE;
+  this->loads_ = 0;
+  clear();
+}
+
+void TiledGrid::clear() {
+  this->tiles_.clear();
+  this->slots_.clear();
+  this->newest_ = -1;
+  this->oldest_ = -1;
+  this->last_id_ = -1;
+  this->last_cells_ = nullptr;
+}
+
+void TiledGrid::setCapacity(int capacity) {
+  this->capacity_ = capacity < 1 ? 1 : capacity;
+  clear();
+}
+
+/* ----------------------------------------------------------------*/
+/**
+ * @brief  Cells of a tile. A missing tile goes into a new slot while the
+ *          cache is below capacity, else it replaces the least recently
+ *          used one.
+ *
+ * @param id tile row * tile columns + tile column
+ *
+ * @return TILE_SIZE words of cells
+ */
+/* ----------------------------------------------------------------*/
+const uint64_t *TiledGrid::findTile(int64_t id) {
+  auto found = this->slots_.find(id);
+  int slot;
+  if (found != this->slots_.end()) {
+    slot = found->second;
+    if (slot != this->newest_) {
+      unlink(slot);
+      pushFront(slot);
+    }
+    return this->tiles_[slot].cells;
+  }
+  if (int(this->tiles_.size()) < this->capacity_) {
+    slot = int(this->tiles_.size());
+    this->tiles_.emplace_back();
+  } else {
+    slot = this->oldest_;
+    unlink(slot);
+    this->slots_.erase(this->tiles_[slot].id);
+  }
+  Tile &tile = this->tiles_[slot];
+  tile.id = id;
+  loadTile(tile);
+  this->loads_++;
+  this->slots_[id] = slot;
+  pushFront(slot);
+  return tile.cells;
+}
+
+/* ----------------------------------------------------------------*/
+/**
+ * @brief  Copies the cells of a tile out of the source. Offsets are
+ *          computed in 64 bit, the source may hold more cells than an int
+ *          counts.
+ *
+ * @param tile
+ */
+/* ----------------------------------------------------------------*/
+void TiledGrid::loadTile(Tile &tile) const {
+  int y0 = int(tile.id / this->tile_columns_) * TILE_SIZE;
+  int x0 = int(tile.id % this->tile_columns_) * TILE_SIZE;
+  int rows = std::min(TILE_SIZE, this->source_.getHeight() - y0);
+  int columns = std::min(TILE_SIZE, this->source_.getWidth() - x0);
+  // cells right of the map are obstacles
+  uint64_t outside = columns == TILE_SIZE ? 0 : ~uint64_t(0) << columns;
+  std::size_t stride = std::size_t(this->source_.getStride());
+  for (int r = 0; r < rows; r++) {
+    std::size_t y = std::size_t(y0 + r);
+    uint64_t bits = 0;
+    if (this->source_.getStorage() == CellStorage::BIT) {
+      // tiles are word aligned in a BIT row
+      bits = this->source_.getWords()[y * stride + std::size_t(x0) / 64];
+    } else {
+      const uint8_t *row = this->source_.getBytes() + y * stride + x0;
+      for (int c = 0; c < columns; c++) {
+        bits |= uint64_t(row[c] == 1) << c;
+      }
+    }
+    tile.cells[r] = bits | outside;
+  }
+  for (int r = rows; r < TILE_SIZE; r++) {
+    tile.cells[r] = ~uint64_t(0);
+  }
+}
+
+void TiledGrid::unlink(int slot) {
+  Tile &tile = this->tiles_[slot];
+  if (tile.newer >= 0) {
+    this->tiles_[tile.newer].older = tile.older;
+  } else {
+    this->newest_ = tile.older;
+  }
+  if (tile.older >= 0) {
+    this->tiles_[tile.older].newer = tile.newer;
+  } else {
+    this->oldest_ = tile.newer;
+  }
+}
+
+void TiledGrid::pushFront(int slot) {
+  Tile &tile = this->tiles_[slot];
+  tile.newer = -1;
+  tile.older = this->newest_;
+  if (this->newest_ >= 0) {
+    this->tiles_[this->newest_].newer = slot;
+  }
+  this->newest_ = slot;
+  if (this->oldest_ < 0) {
+    this->oldest_ = slot;
+  }
+}
+
+/* ----------------------------------------------------------------*/
+/**
+ * @brief  Constructor, empty context
+ */
+/* ----------------------------------------------------------------*/
+TiledSearchContext::TiledSearchContext()
+    : used_(0), tile_columns_(0), generation_(0), last_id_(-1),
+      last_block_(nullptr) {}
+
+/* ----------------------------------------------------------------*/
+/**
+ * @brief  Starts a new search, the blocks go back to the pool
+ *
+ * @param tile_columns
+ */
+/* ----------------------------------------------------------------*/
+void TiledSearchContext::beginSearch(int tile_columns) {
+  this->tile_columns_ = tile_columns;
+  this->tiles_.clear();
+  this->used_ = 0;
+  this->last_id_ = -1;
+  this->last_block_ = nullptr;
+  // the state keeps 31 bits of the generation, stamps of the wrapped
+  // around number would read as reached
+  if (++this->generation_ >= (1u << 31)) {
+    for (auto &block : this->blocks_) {
+      std::memset(block->state, 0, sizeof(block->state));
+    }
+    this->generation_ = 1;
+  }
+}
+
+void TiledSearchContext::release() {
+  this->blocks_.clear();
+  this->tiles_.clear();
+  this->used_ = 0;
+  this->last_id_ = -1;
+  this->last_block_ = nullptr;
+}
+
+float TiledSearchContext::getGCost(int y, int x) {
+  const Block *block = findBlock(y, x, false);
+  int i = cell(y, x);
+  if (block == nullptr || (block->state[i] >> 1) != this->generation_) {
+    return FLT_MAX;
+  }
+  return block->g_cost[i];
+}
+
+uint8_t TiledSearchContext::getMove(int y, int x) {
+  const Block *block = findBlock(y, x, false);
+  int i = cell(y, x);
+  if (block == nullptr || (block->state[i] >> 1) != this->generation_) {
+    return NO_MOVE;
+  }
+  return block->move[i];
+}
+
+/* ----------------------------------------------------------------*/
+/**
+ * @brief  Block of a tile. A block of an earlier search holds older
+ *          generation stamps only, so it is handed out without clearing.
+ *
+ * @param id tile row * tile columns + tile column
+ * @param create take a block if the tile has none
+ *
+ * @return block, nullptr if the tile has none and create is not set
+ */
+/* ----------------------------------------------------------------*/
+TiledSearchContext::Block *TiledSearchContext::lookupBlock(int64_t id,
+                                                           bool create) {
+  auto found = this->tiles_.find(id);
+  Block *block = nullptr;
+  if (found != this->tiles_.end()) {
+    block = found->second;
+  } else if (create) {
+    if (this->used_ == this->blocks_.size()) {
+      this->blocks_.emplace_back(new Block());
+    }
+    block = this->blocks_[this->used_++].get();
+    this->tiles_[id] = block;
+  }
+  this->last_id_ = id;
+  this->last_block_ = block;
+  return block;
+}
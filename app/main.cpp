@@ -33,35 +33,37 @@
 #include "../include/RandomPlanner.h"
 #include "../include/node.h"
 #include "../include/optimalPlanner.h"
+#include <iostream>
+
+// the planners do no I/O, results are reported here
+static void printResult(const std::string &planner, const PlanResult &result) {
+  std::cout << planner << ": " << toString(result.status) << std::endl;
+  for (std::size_t i = 0; i < result.path.size(); i++) {
+    std::cout << "(" << result.path[i].first << "," << result.path[i].second
+              << ")" << (i + 1 < result.path.size() ? "," : "");
+  }
+  std::cout << std::endl;
+  std::cout << "expanded " << result.stats.expansions << " nodes in "
+            << result.stats.setup_ms + result.stats.search_ms +
+                   result.stats.track_path_ms
+            << " ms" << std::endl;
+}
 
 int main() {
   std::vector<std::vector<int>> world_state{
       {0, 0, 1, 0, 0, 0}, {0, 0, 1, 0, 0, 0}, {0, 0, 0, 0, 1, 0},
       {0, 0, 0, 0, 1, 0}, {0, 0, 1, 1, 1, 0}, {0, 0, 0, 0, 0, 0}};
+  OccupancyGrid grid(world_state);
 
   std::pair<int, int> robot_pose(2, 0);
   std::pair<int, int> goal_pose(5, 5);
   // calling Random PLanner object and searching for path
   RandomPlanner rp;
-  std::cout << " This is the path found by random planner: " << std::endl;
-
-  std::vector<std::pair<int, int>> path =
-      rp.search(world_state, robot_pose, goal_pose);
+  printResult("random planner", rp.plan(grid, robot_pose, goal_pose));
 
   // calling optimal planner for the map
   optimalPlanner optimalPlan;
-  std::stack<std::pair<int, int>> optimal_path_ =
-      optimalPlan.search(world_state, robot_pose, goal_pose);
-  std::cout << "   " << std::endl;
-  std::cout << "This is the path found by optimal planner " << std::endl;
-
-  // tracing and printing the path as found by optimal planner
-  while (!optimal_path_.empty()) {
-    std::pair<int, int> p = optimal_path_.top();
-    optimal_path_.pop();
-    std::cout << "(" << p.first << "," << p.second << ")"
-              << ",";
-  }
+  printResult("optimal planner", optimalPlan.plan(grid, robot_pose, goal_pose));
 
   return 0;
 }
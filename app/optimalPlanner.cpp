@@ -78,6 +78,8 @@ to its parent node until you reach the starting node. That is your path.
 // ********************************************************** */
 #include "../include/optimalPlanner.h"
 #include "../include/node.h"
+#include <cstring>
+#include <thread>
 
 /* ----------------------------------------------------------------*/
 /**
@@ -94,14 +96,54 @@ optimalPlanner::optimalPlanner() {}
  * @param goal_pose
  */
 /* ----------------------------------------------------------------*/
-optimalPlanner::optimalPlanner(std::vector<std::vector<int>> world_map,
+optimalPlanner::optimalPlanner(const std::vector<std::vector<int>> &world_map,
+                               std::pair<int, int> robot_pose,
+                               std::pair<int, int> goal_pose)
+    : owned_map_(std::make_shared<const OccupancyGrid>(world_map)) {
+  this->world_map_ = GridView(*this->owned_map_);
+  this->start_position_ = robot_pose;
+  this->goal_position_ = goal_pose;
+  this->y_length = this->world_map_.getHeight() - 1;
+  this->x_length = this->world_map_.getWidth() - 1;
+}
+
+/* ----------------------------------------------------------------*/
+/**
+ * @brief  Parameterised Constructor taking an occupancy grid, the planner
+ *          keeps its own copy of the grid
+ *
+ * @param world_map
+ * @param robot_pose
+ * @param goal_pose
+ */
+/* ----------------------------------------------------------------*/
+optimalPlanner::optimalPlanner(const OccupancyGrid &world_map,
+                               std::pair<int, int> robot_pose,
+                               std::pair<int, int> goal_pose)
+    : optimalPlanner(GridView(), robot_pose, goal_pose) {
+  this->owned_map_ = std::make_shared<const OccupancyGrid>(world_map);
+  this->world_map_ = GridView(*this->owned_map_);
+  this->y_length = this->world_map_.getHeight() - 1;
+  this->x_length = this->world_map_.getWidth() - 1;
+}
+
+/* ----------------------------------------------------------------*/
+/**
+ * @brief  Parameterised Constructor taking a view, nothing is copied
+ *
+ * @param world_map
+ * @param robot_pose
+ * @param goal_pose
+ */
+/* ----------------------------------------------------------------*/
+optimalPlanner::optimalPlanner(const GridView &world_map,
                                std::pair<int, int> robot_pose,
                                std::pair<int, int> goal_pose) {
   this->world_map_ = world_map;
   this->start_position_ = robot_pose;
   this->goal_position_ = goal_pose;
-  this->y_length = int(world_map.size()) - 1;
-  this->x_length = int(world_map[1].size()) - 1;
+  this->y_length = world_map.getHeight() - 1;
+  this->x_length = world_map.getWidth() - 1;
 }
 
 // getter functions
@@ -144,11 +186,10 @@ bool optimalPlanner::isValid(std::pair<int, int> position) {
  */
 /* ----------------------------------------------------------------*/
 bool optimalPlanner::isBlocked(std::pair<int, int> position) {
-  if (this->world_map_[position.first][position.second] == 1) {
-    return true;
-  } else {
-    return false;
-  }
+  return this->world_map_.isOccupied(position) ||
+         (this->step_costs_ != nullptr &&
+          this->step_costs_[this->world_map_.toIndex(position)] ==
+              CostMap::LETHAL);
 }
 
 /* ----------------------------------------------------------------*/
@@ -177,10 +218,26 @@ bool optimalPlanner::isItGoalYet(std::pair<int, int> position) {
  */
 /* ----------------------------------------------------------------*/
 double optimalPlanner::calculateHCost(std::pair<int, int> position) {
-  double hcost = abs(position.first - this->goal_position_.first) +
-                 abs(position.second - this->goal_position_.second);
+  return calculateHCost(position, this->goal_position_);
+}
 
-  return hcost;
+/* ----------------------------------------------------------------*/
+/**
+ * @brief  Heuristic from the location to any target, used by the backward
+ *          frontier of bidirectional search
+ *
+ * @param position
+ * @param target
+ *
+ * @return double , Hcost value
+ */
+/* ----------------------------------------------------------------*/
+double optimalPlanner::calculateHCost(std::pair<int, int> position,
+                                      std::pair<int, int> target) {
+  if (this->connectivity_ != Connectivity::FOUR_CONNECTED) {
+    return heuristic<EightConnected>(position, target);
+  }
+  return heuristic<FourConnected>(position, target);
 }
 
 /* ----------------------------------------------------------------*/
@@ -193,7 +250,21 @@ double optimalPlanner::calculateHCost(std::pair<int, int> position) {
  */
 /* ----------------------------------------------------------------*/
 node optimalPlanner::getNodeInformation(std::pair<int, int> position) {
-  return this->node_information[position.first][position.second];
+  // the context keeps only g cost and parent, rebuild the full node
+  int index = this->world_map_.toIndex(position);
+  node info;
+  info.location_ = position;
+  info.parent = std::make_pair(-1, -1);
+  info.g_cost = FLT_MAX;
+  info.h_cost = FLT_MAX;
+  info.f_cost = FLT_MAX;
+  if (this->context_.isReached(index)) {
+    info.parent = this->world_map_.toPosition(this->context_.getParent(index));
+    info.g_cost = this->context_.getGCost(index);
+    info.h_cost = calculateHCost(position);
+    info.f_cost = info.g_cost + info.h_cost;
+  }
+  return info;
 }
 /* ----------------------------------------------------------------*/
 /**
@@ -201,11 +272,27 @@ node optimalPlanner::getNodeInformation(std::pair<int, int> position) {
  */
 /* ----------------------------------------------------------------*/
 void optimalPlanner::trackPath() {
-  std::pair<int, int> g = this->goal_position_;
-  while (!(this->node_information[g.first][g.second].parent == g)) {
-    this->path_.push(std::make_pair(g.first, g.second));
-    g = this->node_information[g.first][g.second].parent;
+  StatsTimer timer;
+  int g = this->world_map_.toIndex(this->goal_position_);
+  while (this->context_.getParent(g) != g) {
+    std::pair<int, int> cell = this->world_map_.toPosition(g);
+    std::pair<int, int> parent =
+        this->world_map_.toPosition(this->context_.getParent(g));
+    // jump point search links nodes on a straight line, fill the cells
+    // in between so both modes return every step of the path. Moves of
+    // other searches are steps of their own (e.g. knight moves)
+    if (!this->jump_links_) {
+      this->path_.push(cell);
+    }
+    while (this->jump_links_ && cell != parent) {
+      this->path_.push(cell);
+      cell.first += (parent.first > cell.first) - (parent.first < cell.first);
+      cell.second +=
+          (parent.second > cell.second) - (parent.second < cell.second);
+    }
+    g = this->context_.getParent(g);
   }
+  this->stats_.track_path_ms += timer.lap();
 }
 
 /* ----------------------------------------------------------------*/
@@ -269,20 +356,19 @@ void optimalPlanner::moveAndUpdateNodes(std::pair<int, int> child,
                                         std::pair<int, int> parent) {
   // Ignore if child is not valid
   if (isValid(child)) {
+    int child_index = this->world_map_.toIndex(child);
+    int parent_index = this->world_map_.toIndex(parent);
+    float g_new = this->context_.getGCost(parent_index) + stepCost(child_index);
     // check if we reached goal or not
     if (isItGoalYet(child)) {
-      this->node_information[child.first][child.second].parent = parent;
+      this->context_.reach(child_index, g_new, parent_index);
       this->found_goal = true;
       return;
       // if we didnot reach goal , check if it was visited before as in
       // closed list
       // and if the child is blocked
-    } else if (!(this->closed_list[child.first][child.second]) &&
-               !isBlocked(child)) {
-      double g_new =
-          this->node_information[parent.first][parent.second].g_cost + 1;
-      double h_new = this->calculateHCost(child);
-      double f_new = g_new + h_new;
+    } else if (!this->context_.isClosed(child_index) && !isBlocked(child)) {
+      double f_new = g_new + this->calculateHCost(child);
       //
       // Update the least cost to the respective location
       //
@@ -293,18 +379,600 @@ void optimalPlanner::moveAndUpdateNodes(std::pair<int, int> child,
       //                OR
       // If it is on the open list already, check
       // to see if this path to that location  is better,
-      // using 'f' cost as the measure. /
-      if (this->node_information[child.first][child.second].f_cost == FLT_MAX ||
-          this->node_information[child.first][child.second].f_cost < f_new) {
-        this->open_list.insert(std::make_pair(f_new, child));
-        this->node_information[child.first][child.second].f_cost = f_new;
-        this->node_information[child.first][child.second].g_cost = g_new;
-        this->node_information[child.first][child.second].h_cost = h_new;
-        this->node_information[child.first][child.second].parent = parent;
+      // using 'f' cost as the measure. h is the same for every way into
+      // the location, so comparing g is enough (unreached cells are FLT_MAX)
+      if (g_new < this->context_.getGCost(child_index)) {
+        pushOpenList(f_new, child);
+        this->context_.reach(child_index, g_new, parent_index);
+      }
+    }
+  }
+}
+/* ----------------------------------------------------------------*/
+/**
+ * @brief  Selects the open list implementation used by search
+ *
+ * @param type
+ */
+/* ----------------------------------------------------------------*/
+void optimalPlanner::setOpenListType(OpenListType type) {
+  this->open_list_type_ = type;
+}
+
+OpenListType optimalPlanner::getOpenListType() { return this->open_list_type_; }
+
+/* ----------------------------------------------------------------*/
+/**
+ * @brief  Selects the memory layout of the per-cell search state, used from
+ *          the next search on
+ *
+ * @param layout
+ */
+/* ----------------------------------------------------------------*/
+void optimalPlanner::setNodeLayout(NodeLayout layout) {
+  this->node_layout_ = layout;
+}
+
+NodeLayout optimalPlanner::getNodeLayout() { return this->node_layout_; }
+
+/* ----------------------------------------------------------------*/
+/**
+ * @brief  Selects astar or jump point search for the next searches
+ *
+ * @param mode
+ */
+/* ----------------------------------------------------------------*/
+void optimalPlanner::setSearchMode(SearchMode mode) {
+  this->search_mode_ = mode;
+}
+
+SearchMode optimalPlanner::getSearchMode() { return this->search_mode_; }
+
+void optimalPlanner::setConnectivity(Connectivity connectivity) {
+  this->connectivity_ = connectivity;
+  this->use_landmarks_ = landmarksFit();
+}
+
+Connectivity optimalPlanner::getConnectivity() { return this->connectivity_; }
+
+int optimalPlanner::getExpandedNodes() { return this->expanded_nodes_; }
+
+SearchStats optimalPlanner::getSearchStats() { return this->stats_; }
+
+PlanStatus optimalPlanner::getStatus() { return this->status_; }
+
+int optimalPlanner::getSearchedTiles() {
+  return this->tiled_context_.getTileCount();
+}
+
+std::size_t optimalPlanner::getMemoryUsage() const {
+  // a std::set node holds the entry and three links next to its color
+  std::size_t set_node = sizeof(DoublePair) + 4 * sizeof(void *);
+  return this->context_.getMemoryUsage() +
+         this->backward_context_.getMemoryUsage() +
+         this->forward_open_.getMemoryUsage() +
+         this->backward_open_.getMemoryUsage() +
+         this->open_list.size() * set_node +
+         this->binary_heap_.getMemoryUsage() +
+         this->quaternary_heap_.getMemoryUsage() +
+         this->bucket_queue_.getMemoryUsage() +
+         this->tiled_context_.getMemoryUsage() +
+         this->wavefront_.getMemoryUsage();
+}
+
+/* ----------------------------------------------------------------*/
+/**
+ * @brief  Selects one or two threads for bidirectional search
+ *
+ * @param parallel
+ */
+/* ----------------------------------------------------------------*/
+void optimalPlanner::setParallelFrontiers(bool parallel) {
+  this->parallel_frontiers_ = parallel;
+}
+
+bool optimalPlanner::getParallelFrontiers() {
+  return this->parallel_frontiers_;
+}
+
+void optimalPlanner::setLandmarks(
+    std::shared_ptr<const LandmarkHeuristic> landmarks) {
+  this->landmarks_ = landmarks;
+  this->landmarks_checked_ = nullptr;
+  this->use_landmarks_ = landmarksFit();
+}
+
+void optimalPlanner::setCostMap(std::shared_ptr<const CostMap> cost_map) {
+  this->cost_map_ = cost_map;
+}
+
+std::shared_ptr<const CostMap> optimalPlanner::getCostMap() {
+  return this->cost_map_;
+}
+
+void optimalPlanner::setComponentIndex(
+    std::shared_ptr<const ComponentIndex> components) {
+  this->components_ = components;
+}
+
+std::shared_ptr<const ComponentIndex> optimalPlanner::getComponentIndex() {
+  return this->components_;
+}
+
+void optimalPlanner::setReachabilityCheck(bool check) {
+  this->reachability_check_ = check;
+}
+
+bool optimalPlanner::getReachabilityCheck() {
+  return this->reachability_check_;
+}
+
+// packs the free cells again when the map version changed; versions are
+// unique across grids and opened map files, only version 0 views repack
+// on every search
+bool optimalPlanner::wavefrontReaches() {
+  uint64_t version = this->world_map_.getVersion();
+  if (version == 0 || version != this->wavefront_version_ ||
+      this->wavefront_.getHeight() != this->world_map_.getHeight() ||
+      this->wavefront_.getWidth() != this->world_map_.getWidth()) {
+    this->wavefront_.build(this->world_map_);
+    this->wavefront_version_ = version;
+  }
+  return this->wavefront_.isReachable(this->start_position_,
+                                      this->goal_position_);
+}
+
+// tables of another map make the heuristic inadmissible, so size and
+// checksum have to match. The checksum costs a pass over the map and is
+// compared once per map version, MapFile views included; raw views without
+// a version are checked on every search. The tables hold four connected
+// distances, which diagonal moves undercut
+bool optimalPlanner::landmarksFit() {
+  if (this->connectivity_ != Connectivity::FOUR_CONNECTED ||
+      !this->landmarks_ || this->landmarks_->getLandmarkCount() == 0) {
+    return false;
+  }
+  uint64_t version = this->world_map_.getVersion();
+  if (version == 0 || this->landmarks_checked_ != this->landmarks_.get() ||
+      this->landmarks_version_ != version) {
+    this->landmarks_match_ = this->landmarks_->matches(this->world_map_);
+    this->landmarks_checked_ = this->landmarks_.get();
+    this->landmarks_version_ = version;
+  }
+  return this->landmarks_match_;
+}
+
+std::shared_ptr<const LandmarkHeuristic> optimalPlanner::getLandmarks() {
+  return this->landmarks_;
+}
+
+/* ----------------------------------------------------------------*/
+/**
+ * @brief  To check if (y,x) is inside the map and free
+ *
+ * @param y
+ * @param x
+ *
+ * @return true if the robot can stand on the cell
+ */
+/* ----------------------------------------------------------------*/
+bool optimalPlanner::isFree(int y, int x) {
+  std::pair<int, int> position = std::make_pair(y, x);
+  return isValid(position) && !isBlocked(position);
+}
+
+/* ----------------------------------------------------------------*/
+/**
+ * @brief  Moves from a node in a straight line until a jump point is found.
+ *          With orthogonal moves only a cell is a jump point if it is the
+ *          goal, if it has a forced neighbor (a side cell which was blocked
+ *          one step back, so a shortest path may have to turn there) or,
+ *          when moving vertically, if a horizontal jump from it succeeds.
+ *
+ * @param from node the jump starts from (not checked itself)
+ * @param dy vertical step, -1, 0 or 1
+ * @param dx horizontal step, -1, 0 or 1
+ * @param jump_point found jump point
+ *
+ * @return false if the jump ran into an obstacle or the map border
+ */
+/* ----------------------------------------------------------------*/
+bool optimalPlanner::jump(std::pair<int, int> from, int dy, int dx,
+                          std::pair<int, int> &jump_point) {
+  int y = from.first;
+  int x = from.second;
+  std::pair<int, int> side;
+  while (true) {
+    y += dy;
+    x += dx;
+    if (!isFree(y, x)) {
+      return false;
+    }
+    jump_point = std::make_pair(y, x);
+    if (isItGoalYet(jump_point)) {
+      return true;
+    }
+    if (dx != 0) {
+      if ((isFree(y - 1, x) && !isFree(y - 1, x - dx)) ||
+          (isFree(y + 1, x) && !isFree(y + 1, x - dx))) {
+        return true;
+      }
+    } else {
+      if ((isFree(y, x - 1) && !isFree(y - dy, x - 1)) ||
+          (isFree(y, x + 1) && !isFree(y - dy, x + 1))) {
+        return true;
+      }
+      // the path may turn here towards a jump point found sideways
+      if (jump(jump_point, 0, 1, side) || jump(jump_point, 0, -1, side)) {
+        jump_point = std::make_pair(y, x);
+        return true;
+      }
+    }
+  }
+}
+
+/* ----------------------------------------------------------------*/
+/**
+ * @brief  Jump point search over the open list prepared by search. Nodes
+ *          keep the jump point they were reached from as parent, trackPath
+ *          fills in the straight segments between them.
+ */
+/* ----------------------------------------------------------------*/
+void optimalPlanner::jumpPointSearch() {
+  this->jump_links_ = true;
+  int goal_index = this->world_map_.toIndex(this->goal_position_);
+  while (!isOpenListEmpty()) {
+    std::pair<int, int> current = popOpenList();
+    int index = this->world_map_.toIndex(current);
+    if (this->context_.isClosed(index)) {
+      this->stats_.countStalePop();
+      continue;
+    }
+    this->context_.close(index);
+    this->expanded_nodes_++;
+    // jumps span several cells, the path is only known to be optimal once
+    // the goal leaves the open list
+    if (index == goal_index) {
+      this->found_goal = true;
+      trackPath();
+      return;
+    }
+    // direction of travel into this node, (0,0) for the start node
+    std::pair<int, int> parent =
+        this->world_map_.toPosition(this->context_.getParent(index));
+    int dy = (current.first > parent.first) - (current.first < parent.first);
+    int dx =
+        (current.second > parent.second) - (current.second < parent.second);
+    float g_current = this->context_.getGCost(index);
+
+    // moves in the same order as astar
+    for (int k = 0; k < FourConnected::SIZE; k++) {
+      int move_y = FourConnected::DY[k];
+      int move_x = FourConnected::DX[k];
+      // going back to the parent can never shorten the path
+      if ((dy != 0 || dx != 0) && move_y == -dy && move_x == -dx) {
+        continue;
+      }
+      std::pair<int, int> jump_point;
+      if (!jump(current, move_y, move_x, jump_point)) {
+        continue;
+      }
+      int jump_index = this->world_map_.toIndex(jump_point);
+      if (this->context_.isClosed(jump_index)) {
+        continue;
+      }
+      float g_new = g_current + abs(jump_point.first - current.first) +
+                    abs(jump_point.second - current.second);
+      float g_old = this->context_.getGCost(jump_index);
+      if (g_new < g_old) {
+        if (g_old < FLT_MAX) {
+          this->stats_.countReopening();
+        }
+        pushOpenList(g_new + calculateHCost(jump_point), jump_point);
+        this->context_.reach(jump_index, g_new, index);
+      }
+    }
+  }
+}
+
+/* ----------------------------------------------------------------*/
+/**
+ * @brief  Empties the open list and sizes the heaps to the current map
+ */
+/* ----------------------------------------------------------------*/
+void optimalPlanner::clearOpenList() {
+  int cells = this->world_map_.getCellCount();
+  this->open_list.clear();
+  switch (this->open_list_in_use_) {
+  case OpenListType::SET:
+    break;
+  case OpenListType::BINARY_HEAP:
+    if (this->binary_heap_.capacity() != cells) {
+      this->binary_heap_.resize(cells);
+    }
+    this->binary_heap_.clear();
+    break;
+  case OpenListType::QUATERNARY_HEAP:
+    if (this->quaternary_heap_.capacity() != cells) {
+      this->quaternary_heap_.resize(cells);
+    }
+    this->quaternary_heap_.clear();
+    break;
+  case OpenListType::BUCKET_QUEUE:
+    this->bucket_queue_.clear();
+    break;
+  }
+}
+
+/* ----------------------------------------------------------------*/
+/**
+ * @brief  Adds a location to the open list. The heaps lower the f cost of an
+ *          already queued location in place, the set and the bucket queue
+ *          keep the old entry.
+ *
+ * @param f_cost
+ * @param position
+ */
+/* ----------------------------------------------------------------*/
+void optimalPlanner::pushOpenList(double f_cost, std::pair<int, int> position) {
+  int index = this->world_map_.toIndex(position);
+  switch (this->open_list_in_use_) {
+  case OpenListType::SET:
+    this->open_list.insert(std::make_pair(f_cost, position));
+    break;
+  case OpenListType::BINARY_HEAP:
+    this->binary_heap_.push(index, f_cost);
+    break;
+  case OpenListType::QUATERNARY_HEAP:
+    this->quaternary_heap_.push(index, f_cost);
+    break;
+  case OpenListType::BUCKET_QUEUE:
+    this->bucket_queue_.push(index, int(std::lround(f_cost)));
+    break;
+  }
+  if (SearchStats::ENABLED) {
+    this->stats_.countPush(uint64_t(openListSize()));
+  }
+}
+
+bool optimalPlanner::isOpenListEmpty() {
+  switch (this->open_list_in_use_) {
+  case OpenListType::BINARY_HEAP:
+    return this->binary_heap_.empty();
+  case OpenListType::QUATERNARY_HEAP:
+    return this->quaternary_heap_.empty();
+  case OpenListType::BUCKET_QUEUE:
+    return this->bucket_queue_.empty();
+  default:
+    return this->open_list.empty();
+  }
+}
+
+/* ----------------------------------------------------------------*/
+/**
+ * @brief  Removes the location with the lowest f cost from the open list
+ *
+ * @return location
+ */
+/* ----------------------------------------------------------------*/
+std::pair<int, int> optimalPlanner::popOpenList() {
+  this->stats_.countPop();
+  int index;
+  switch (this->open_list_in_use_) {
+  case OpenListType::BINARY_HEAP:
+    index = this->binary_heap_.pop();
+    break;
+  case OpenListType::QUATERNARY_HEAP:
+    index = this->quaternary_heap_.pop();
+    break;
+  case OpenListType::BUCKET_QUEUE:
+    index = this->bucket_queue_.pop();
+    break;
+  default: {
+    std::pair<int, int> position = this->open_list.begin()->second;
+    this->open_list.erase(this->open_list.begin());
+    return position;
+  }
+  }
+  return this->world_map_.toPosition(index);
+}
+
+int optimalPlanner::openListSize() {
+  switch (this->open_list_in_use_) {
+  case OpenListType::BINARY_HEAP:
+    return this->binary_heap_.size();
+  case OpenListType::QUATERNARY_HEAP:
+    return this->quaternary_heap_.size();
+  case OpenListType::BUCKET_QUEUE:
+    return this->bucket_queue_.size();
+  default:
+    return int(this->open_list.size());
+  }
+}
+
+// The best meeting found so far is one atomic word: the float bits of the
+// path cost (non negative, so they order like the cost) above the index of
+// the cell where the frontiers met. Both frontier threads lower it with CAS.
+static const uint32_t NO_MEETING = 0xffffffffu;
+
+static uint64_t packMeeting(float cost, uint32_t index) {
+  uint32_t bits;
+  std::memcpy(&bits, &cost, sizeof(bits));
+  return (uint64_t(bits) << 32) | index;
+}
+
+static float meetingCost(uint64_t meeting) {
+  uint32_t bits = uint32_t(meeting >> 32);
+  float cost;
+  std::memcpy(&cost, &bits, sizeof(cost));
+  return cost;
+}
+
+static void offerMeeting(std::atomic<uint64_t> &best, float cost, int index) {
+  uint64_t offer = packMeeting(cost, uint32_t(index));
+  uint64_t current = best.load();
+  while (offer < current && !best.compare_exchange_weak(current, offer)) {
+  }
+}
+
+/* ----------------------------------------------------------------*/
+/**
+ * @brief  Expands the lowest f cost node of one frontier and offers every
+ *          cell the other frontier has reached as a meeting point.
+ *
+ *          A frontier stops once its lowest f cost is not below the best
+ *          meeting cost: with a consistent heuristic every cheaper path
+ *          would still have a node on this frontier with f below its cost.
+ *          It also stops when its open list runs empty, every cell it can
+ *          reach has then been offered.
+ *
+ * @param self frontier to grow
+ * @param other frontier growing from the other end
+ * @param best best meeting found so far
+ *
+ * @return false once the frontier has to stop
+ */
+/* ----------------------------------------------------------------*/
+bool optimalPlanner::expandFrontier(Frontier &self, const Frontier &other,
+                                    std::atomic<uint64_t> &best) {
+  if (self.open->empty() ||
+      self.open->topPriority() >= meetingCost(best.load())) {
+    return false;
+  }
+  int index = self.open->pop();
+  self.stats.countPop();
+  self.context->close(index);
+  self.expanded++;
+
+  std::pair<int, int> current = this->world_map_.toPosition(index);
+  float g_new = self.context->getGCost(index) + 1;
+  for (int k = 0; k < FourConnected::SIZE; k++) {
+    std::pair<int, int> child(current.first + FourConnected::DY[k],
+                              current.second + FourConnected::DX[k]);
+    if (!isValid(child) || isBlocked(child)) {
+      continue;
+    }
+    int child_index = this->world_map_.toIndex(child);
+    float g_old = self.context->getGCost(child_index);
+    if (self.context->isClosed(child_index) || !(g_new < g_old)) {
+      continue;
+    }
+    if (g_old < FLT_MAX) {
+      self.stats.countReopening();
+    }
+    self.context->reach(child_index, g_new, index);
+    self.open->push(child_index, g_new + calculateHCost(child, self.target));
+    self.stats.countPush(uint64_t(self.open->size()));
+    // with two threads the other context may be written concurrently, read
+    // the costs it published instead. Each side publishes before it reads,
+    // so of two threads reaching the same cell at least one sees the other
+    float g_other;
+    if (self.published != nullptr) {
+      self.published->publish(child_index, g_new);
+      g_other = other.published->read(child_index);
+    } else {
+      g_other = other.context->getGCost(child_index);
+    }
+    if (g_other < FLT_MAX) {
+      offerMeeting(best, g_new + g_other, child_index);
+    }
+  }
+  return true;
+}
+
+/* ----------------------------------------------------------------*/
+/**
+ * @brief  Bidirectional astar: a forward frontier in the planner context
+ *          and a backward frontier from the goal grow until neither can
+ *          improve the best meeting point, then the path is joined there.
+ */
+/* ----------------------------------------------------------------*/
+void optimalPlanner::bidirectionalSearch() {
+  int cells = this->world_map_.getCellCount();
+  int start_index = this->world_map_.toIndex(this->start_position_);
+  int goal_index = this->world_map_.toIndex(this->goal_position_);
+
+  // search() already started the forward context at the start node
+  this->backward_context_.setLayout(this->node_layout_);
+  this->backward_context_.beginSearch(cells);
+  this->backward_context_.reach(goal_index, 0.0f, goal_index);
+  if (this->forward_open_.capacity() != cells) {
+    this->forward_open_.resize(cells);
+    this->backward_open_.resize(cells);
+  }
+  this->forward_open_.clear();
+  this->backward_open_.clear();
+  this->forward_open_.push(start_index, calculateHCost(this->start_position_));
+  this->backward_open_.push(
+      goal_index, calculateHCost(this->goal_position_, this->start_position_));
+
+  Frontier forward = {&this->context_, &this->forward_open_, nullptr,
+                      this->goal_position_, 0, SearchStats()};
+  Frontier backward = {&this->backward_context_, &this->backward_open_,
+                       nullptr, this->start_position_, 0, SearchStats()};
+  std::atomic<uint64_t> best(packMeeting(FLT_MAX, NO_MEETING));
+  if (start_index == goal_index) {
+    best = packMeeting(0.0f, uint32_t(start_index));
+  }
+
+  if (this->parallel_frontiers_) {
+    this->forward_costs_.beginSearch(cells);
+    this->backward_costs_.beginSearch(cells);
+    this->forward_costs_.publish(start_index, 0.0f);
+    this->backward_costs_.publish(goal_index, 0.0f);
+    forward.published = &this->forward_costs_;
+    backward.published = &this->backward_costs_;
+    // either frontier stopping ends the search, see expandFrontier
+    std::atomic<bool> done(false);
+    auto grow = [this, &done, &best](Frontier &self, const Frontier &other) {
+      while (!done.load() && expandFrontier(self, other, best)) {
+      }
+      done.store(true);
+    };
+    std::thread backward_thread(grow, std::ref(backward), std::cref(forward));
+    grow(forward, backward);
+    backward_thread.join();
+  } else {
+    // grow the smaller frontier to keep both about the same size
+    while (true) {
+      bool forward_turn =
+          this->forward_open_.size() <= this->backward_open_.size();
+      Frontier &self = forward_turn ? forward : backward;
+      Frontier &other = forward_turn ? backward : forward;
+      if (!expandFrontier(self, other, best)) {
+        break;
       }
     }
   }
+  this->expanded_nodes_ = forward.expanded + backward.expanded;
+  this->stats_ += forward.stats;
+  this->stats_ += backward.stats;
+  this->stats_.searches = 1;
+
+  uint32_t meeting = uint32_t(best.load());
+  if (meeting == NO_MEETING) {
+    return;
+  }
+  this->found_goal = true;
+  StatsTimer timer;
+  // goal side first, the path stack is popped from the start
+  std::vector<int> backward_half;
+  int cell = int(meeting);
+  while (cell != goal_index) {
+    cell = this->backward_context_.getParent(cell);
+    backward_half.push_back(cell);
+  }
+  for (auto it = backward_half.rbegin(); it != backward_half.rend(); ++it) {
+    this->path_.push(this->world_map_.toPosition(*it));
+  }
+  cell = int(meeting);
+  while (cell != start_index) {
+    this->path_.push(this->world_map_.toPosition(cell));
+    cell = this->context_.getParent(cell);
+  }
+  this->stats_.track_path_ms += timer.lap();
 }
+
 /* ----------------------------------------------------------------*/
 /**
  * @brief  TO search using Astar Algorithm
@@ -317,109 +985,338 @@ void optimalPlanner::moveAndUpdateNodes(std::pair<int, int> child,
  */
 /* ----------------------------------------------------------------*/
 std::stack<std::pair<int, int>>
-optimalPlanner::search(std::vector<std::vector<int>> world_map,
+optimalPlanner::search(const std::vector<std::vector<int>> &world_map,
                        std::pair<int, int> robot_pose,
                        std::pair<int, int> goal_pose) {
+  // the nested vector has to be converted once, the planner owns the result
+  this->owned_map_ = std::make_shared<const OccupancyGrid>(world_map);
+  return search(GridView(*this->owned_map_), robot_pose, goal_pose);
+}
+
+/* ----------------------------------------------------------------*/
+/**
+ * @brief  TO search using Astar Algorithm on a map view. The map is not
+ *          copied, it has to stay alive while the planner uses it.
+ *
+ * @param world_map
+ * @param robot_pose
+ * @param goal_pose
+ *
+ * @return Path
+ */
+/* ----------------------------------------------------------------*/
+bool optimalPlanner::beginSearch(const GridView &world_map,
+                                 std::pair<int, int> robot_pose,
+                                 std::pair<int, int> goal_pose,
+                                 bool uniform_moves,
+                                 bool orthogonal_regions) {
+  this->search_timer_.restart();
+  this->jump_links_ = false;
+  this->stats_ = SearchStats();
+  this->stats_.searches = 1;
   // Update all this members and do sanity checks
 
   this->world_map_ = world_map;
   this->start_position_ = robot_pose;
   this->goal_position_ = goal_pose;
-  this->y_length = int(world_map.size()) - 1;
-  this->x_length = int(world_map[1].size()) - 1;
-
-  // Sanity checks for the start and goal position
-  if (!isValid(this->start_position_)) {
-    std::cout << "invalid robot pose" << std::endl;
-  }
-  if (!isValid(this->goal_position_)) {
-    std::cout << "invalid goal pose" << std::endl;
+  // cell indices of the search state are int, larger maps (mapped files
+  // above 2^31 cells) are searched as a TiledGrid
+  bool too_large = int64_t(world_map.getHeight()) * world_map.getWidth() >
+                   int64_t(INT_MAX);
+  this->use_landmarks_ = !too_large && landmarksFit();
+  this->step_costs_ = nullptr;
+  this->heuristic_scale_ = 1.0;
+  if (this->cost_map_ &&
+      this->cost_map_->getHeight() == world_map.getHeight() &&
+      this->cost_map_->getWidth() == world_map.getWidth()) {
+    this->step_costs_ = this->cost_map_->getCosts();
+    this->heuristic_scale_ = 1.0 + this->cost_map_->getMinCost();
   }
+  this->y_length = world_map.getHeight() - 1;
+  this->x_length = world_map.getWidth() - 1;
 
-  if (isBlocked(this->start_position_) || isBlocked(this->goal_position_)) {
-    std::cout << "wrong start/goal coordinates entered" << std::endl;
+  // Sanity checks for the start and goal position, a rejected query and
+  // a goal outside the region of the start are answered without searching
+  this->expanded_nodes_ = 0;
+  this->path_ = std::stack<std::pair<int, int>>();
+  if (too_large) {
+    this->status_ = PlanStatus::MAP_TOO_LARGE;
+  } else if (!isValid(this->start_position_)) {
+    this->status_ = PlanStatus::INVALID_START;
+  } else if (!isValid(this->goal_position_)) {
+    this->status_ = PlanStatus::INVALID_GOAL;
+  } else if (isBlocked(this->start_position_)) {
+    this->status_ = PlanStatus::BLOCKED_START;
+  } else if (isBlocked(this->goal_position_)) {
+    this->status_ = PlanStatus::BLOCKED_GOAL;
+  } else if (this->components_ && orthogonal_regions &&
+             this->components_->matches(this->world_map_) &&
+             !this->components_->isConnected(this->start_position_,
+                                             this->goal_position_)) {
+    this->status_ = PlanStatus::UNREACHABLE;
+  } else if (this->reachability_check_ && orthogonal_regions &&
+             !wavefrontReaches()) {
+    this->status_ = PlanStatus::UNREACHABLE;
+  } else {
+    this->status_ = PlanStatus::SUCCESS;
   }
-
-  if (isItGoalYet(this->start_position_)) {
-    std::cout << "Already at goal position" << std::endl;
+  if (this->status_ != PlanStatus::SUCCESS) {
+    this->path_.push(start_position_);
+    this->stats_.setup_ms = this->search_timer_.lap();
+    return false;
   }
-  // Inistialise closed list with false of size same as map
-  // to store if location is visited or not
-  //
-  std::vector<std::vector<bool>> v(y_length + 1,
-                                   std::vector<bool>(x_length + 1, false));
-
-  this->closed_list = v;
-  // INitialising all nodes in nodesInformation member to acess them
-  // individually
+  // Start a new generation of the search context, nodes and closed list
+  // entries of earlier searches read as unvisited without clearing the map
+  // sized arrays
   //
-  node fake_node;
-  fake_node.f_cost = FLT_MAX;
-  fake_node.g_cost = FLT_MAX;
-  fake_node.h_cost = FLT_MAX;
-  fake_node.location_ = std::make_pair(-1, -1);
-  fake_node.parent = std::make_pair(-1, -1);
-  std::vector<std::vector<node>> fake_info(
-      y_length + 1, std::vector<node>(x_length + 1, fake_node));
-  this->node_information = fake_info;
+  this->context_.setLayout(this->node_layout_);
+  this->context_.beginSearch(this->world_map_.getCellCount());
 
   // Initialising the search by storing first/start node in nodeinfo and
   // in openlist
-  int i = this->start_position_.first;
-  int j = this->start_position_.second;
-  this->node_information[i][j].f_cost = 0.0;
-  this->node_information[i][j].g_cost = 0.0;
-  this->node_information[i][j].h_cost = 0.0;
-  this->node_information[i][j].parent = this->start_position_;
-
-  this->open_list.insert(std::make_pair(0.0, this->start_position_));
+  int start_index = this->world_map_.toIndex(this->start_position_);
+  this->context_.reach(start_index, 0.0f, start_index);
+
+  // diagonal steps give f costs between the buckets
+  this->open_list_in_use_ = this->open_list_type_;
+  if (this->open_list_type_ == OpenListType::BUCKET_QUEUE && !uniform_moves) {
+    this->open_list_in_use_ = OpenListType::QUATERNARY_HEAP;
+  }
+  clearOpenList();
+  pushOpenList(0.0, this->start_position_);
   this->found_goal = false;
+  this->stats_.setup_ms = this->search_timer_.lap();
+  return true;
+}
 
+/* ----------------------------------------------------------------*/
+/**
+ * @brief  Counts the search, sets the status and completes the path with
+ *          the start
+ *
+ * @return Path
+ */
+/* ----------------------------------------------------------------*/
+std::stack<std::pair<int, int>> optimalPlanner::finishSearch() {
+  this->stats_.search_ms =
+      this->search_timer_.lap() - this->stats_.track_path_ms;
+  this->stats_.expansions = uint64_t(this->expanded_nodes_);
+  // check if goal is reached or not using found_goal flag
+  if (found_goal == false) {
+    this->status_ = PlanStatus::UNREACHABLE;
+  }
+  this->path_.push(start_position_);
+  return this->path_;
+}
+
+/* ----------------------------------------------------------------*/
+/**
+ * @brief  TO search using Astar Algorithm on a map view. The map is not
+ *          copied, it has to stay alive while the planner uses it.
+ *
+ * @param world_map
+ * @param robot_pose
+ * @param goal_pose
+ *
+ * @return Path
+ */
+/* ----------------------------------------------------------------*/
+std::stack<std::pair<int, int>>
+optimalPlanner::search(const GridView &world_map,
+                       std::pair<int, int> robot_pose,
+                       std::pair<int, int> goal_pose) {
+  bool diagonal = this->connectivity_ != Connectivity::FOUR_CONNECTED;
+  bool cut_corners =
+      this->connectivity_ == Connectivity::EIGHT_CONNECTED_CUT_CORNERS;
+  if (!beginSearch(world_map, robot_pose, goal_pose, !diagonal,
+                   !cut_corners)) {
+    return this->path_;
+  }
   // checking all the elements in openlist until goal is reached
   //
-  while (!open_list.empty()) {
-    DoublePair first_element = *this->open_list.begin();
-    this->open_list.erase(this->open_list.begin());
-
-    i = first_element.second.first;
-    j = first_element.second.second;
-    //
-    // moving in all locations and updating nodes in nodesinformation
-    // and checking if goal is reached
-    //
-    this->closed_list[i][j] = true;
-    std::pair<int, int> temp = goTop(first_element.second);
-    moveAndUpdateNodes(temp, first_element.second);
-    if (found_goal == true) {
-      trackPath();
-      break;
+  // jump points and the meeting rule of the two frontiers assume unit
+  // orthogonal steps, otherwise both modes search like plain astar
+  bool unit_steps = this->step_costs_ == nullptr && !diagonal;
+  if (this->search_mode_ == SearchMode::JUMP_POINT && unit_steps) {
+    jumpPointSearch();
+  } else if (this->search_mode_ == SearchMode::BIDIRECTIONAL && unit_steps) {
+    bidirectionalSearch();
+  } else if (this->connectivity_ == Connectivity::EIGHT_CONNECTED) {
+    astarSearch<EightConnected>();
+  } else if (this->connectivity_ ==
+             Connectivity::EIGHT_CONNECTED_CUT_CORNERS) {
+    astarSearch<EightConnectedCutCorners>();
+  } else {
+    astarSearch<FourConnected>();
+  }
+  return finishSearch();
+}
+/* ----------------------------------------------------------------*/
+/**
+ * @brief  Astar on a tiled map, the loop of astarSearch with the state kept
+ *          per tile. Cells are addressed by (y,x) since the map may hold
+ *          more cells than an int counts. The goal is tested when it is
+ *          popped, which is exact for the diagonal step costs as well.
+ *
+ * @param world_map
+ */
+/* ----------------------------------------------------------------*/
+template <class Neighborhood>
+void optimalPlanner::tiledSearch(TiledGrid &world_map) {
+  while (!this->tiled_open_.empty()) {
+    std::pair<int, int> current = this->tiled_open_.top().second;
+    this->tiled_open_.pop();
+    this->stats_.countPop();
+    int y = current.first;
+    int x = current.second;
+    // improved nodes leave stale entries behind, skip them
+    if (this->tiled_context_.isClosed(y, x)) {
+      this->stats_.countStalePop();
+      continue;
     }
-
-    temp = goLeft(first_element.second);
-    moveAndUpdateNodes(temp, first_element.second);
-    if (found_goal == true) {
-      trackPath();
+    this->tiled_context_.close(y, x);
+    this->expanded_nodes_++;
+    if (current == this->goal_position_) {
+      this->found_goal = true;
       break;
     }
-
-    temp = goBottom(first_element.second);
-    moveAndUpdateNodes(temp, first_element.second);
-    if (found_goal == true) {
-      trackPath();
-      break;
+    float g_current = this->tiled_context_.getGCost(y, x);
+    for (int k = 0; k < Neighborhood::SIZE; k++) {
+      int dy = Neighborhood::DY[k];
+      int dx = Neighborhood::DX[k];
+      // cells outside the map read as obstacles
+      if (world_map.isOccupied(y + dy, x + dx)) {
+        continue;
+      }
+      if (!Neighborhood::CUT_CORNERS && dy != 0 && dx != 0 &&
+          (world_map.isOccupied(y + dy, x) ||
+           world_map.isOccupied(y, x + dx))) {
+        continue;
+      }
+      float g_new = g_current + Neighborhood::COST[k];
+      float g_old = this->tiled_context_.getGCost(y + dy, x + dx);
+      if (this->tiled_context_.isClosed(y + dy, x + dx) || !(g_new < g_old)) {
+        continue;
+      }
+      if (g_old < FLT_MAX) {
+        this->stats_.countReopening();
+      }
+      this->tiled_context_.reach(y + dy, x + dx, g_new, uint8_t(k));
+      this->tiled_open_.push(DoublePair(
+          g_new + Neighborhood::distance(
+                      std::abs(this->goal_position_.first - y - dy),
+                      std::abs(this->goal_position_.second - x - dx)),
+          std::make_pair(y + dy, x + dx)));
+      this->stats_.countPush(uint64_t(this->tiled_open_.size()));
     }
+  }
+  this->tiled_open_ = decltype(this->tiled_open_)();
+  if (!this->found_goal) {
+    return;
+  }
+  // walk back along the recorded moves
+  StatsTimer timer;
+  std::pair<int, int> cell = this->goal_position_;
+  uint8_t move;
+  while ((move = this->tiled_context_.getMove(cell.first, cell.second)) !=
+         TiledSearchContext::NO_MOVE) {
+    this->path_.push(cell);
+    cell.first -= Neighborhood::DY[move];
+    cell.second -= Neighborhood::DX[move];
+  }
+  this->stats_.track_path_ms += timer.lap();
+}
 
-    temp = goRight(first_element.second);
-    moveAndUpdateNodes(temp, first_element.second);
-    if (found_goal == true) {
-      trackPath();
-      break;
+/* ----------------------------------------------------------------*/
+/**
+ * @brief  TO search using Astar Algorithm on a tiled map
+ *
+ * @param world_map
+ * @param robot_pose
+ * @param goal_pose
+ *
+ * @return Path
+ */
+/* ----------------------------------------------------------------*/
+std::stack<std::pair<int, int>>
+optimalPlanner::search(TiledGrid &world_map, std::pair<int, int> robot_pose,
+                       std::pair<int, int> goal_pose) {
+  StatsTimer timer;
+  this->stats_ = SearchStats();
+  this->stats_.searches = 1;
+  this->start_position_ = robot_pose;
+  this->goal_position_ = goal_pose;
+  this->path_ = std::stack<std::pair<int, int>>();
+  this->expanded_nodes_ = 0;
+  this->found_goal = false;
+  this->tiled_context_.beginSearch(world_map.getTileColumns());
+
+  // a search for a blocked goal would read every tile of the region, so
+  // bad poses are answered right away
+  if (!world_map.isInside(robot_pose)) {
+    this->status_ = PlanStatus::INVALID_START;
+  } else if (!world_map.isInside(goal_pose)) {
+    this->status_ = PlanStatus::INVALID_GOAL;
+  } else if (world_map.isOccupied(robot_pose)) {
+    this->status_ = PlanStatus::BLOCKED_START;
+  } else if (world_map.isOccupied(goal_pose)) {
+    this->status_ = PlanStatus::BLOCKED_GOAL;
+  } else {
+    this->tiled_context_.reach(robot_pose.first, robot_pose.second, 0.0f,
+                               TiledSearchContext::NO_MOVE);
+    this->tiled_open_.push(DoublePair(0.0, robot_pose));
+    this->stats_.countPush(1);
+    this->stats_.setup_ms = timer.lap();
+    if (this->connectivity_ == Connectivity::EIGHT_CONNECTED) {
+      tiledSearch<EightConnected>(world_map);
+    } else if (this->connectivity_ ==
+               Connectivity::EIGHT_CONNECTED_CUT_CORNERS) {
+      tiledSearch<EightConnectedCutCorners>(world_map);
+    } else {
+      tiledSearch<FourConnected>(world_map);
     }
-  }
-  // check if goal is reached or not using found_goal flag
-  if (found_goal == false) {
-    std::cout << "no path found" << std::endl;
+    this->stats_.search_ms = timer.lap() - this->stats_.track_path_ms;
+    this->stats_.expansions = uint64_t(this->expanded_nodes_);
+    this->status_ =
+        found_goal ? PlanStatus::SUCCESS : PlanStatus::UNREACHABLE;
   }
   this->path_.push(start_position_);
   return this->path_;
 }
+
+/* ----------------------------------------------------------------*/
+/**
+ * @brief  Searches like search and returns the outcome as PlanResult
+ *
+ * @param world_map
+ * @param robot_pose
+ * @param goal_pose
+ *
+ * @return status, path from start to goal and statistics
+ */
+/* ----------------------------------------------------------------*/
+PlanResult optimalPlanner::plan(const GridView &world_map,
+                                std::pair<int, int> robot_pose,
+                                std::pair<int, int> goal_pose) {
+  return toResult(search(world_map, robot_pose, goal_pose));
+}
+
+PlanResult optimalPlanner::plan(TiledGrid &world_map,
+                                std::pair<int, int> robot_pose,
+                                std::pair<int, int> goal_pose) {
+  return toResult(search(world_map, robot_pose, goal_pose));
+}
+
+PlanResult optimalPlanner::toResult(std::stack<std::pair<int, int>> path) {
+  PlanResult result;
+  result.status = this->status_;
+  result.stats = this->stats_;
+  if (this->status_ == PlanStatus::SUCCESS) {
+    result.path.reserve(path.size());
+    while (!path.empty()) {
+      result.path.push_back(path.top());
+      path.pop();
+    }
+  }
+  return result;
+}
@@ -0,0 +1,216 @@
+/* Copyright (C)
+ * 2019 - Bhargav Dandamudi
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the 'Software'), to deal in the Software without
+ * restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit
+ * persons to whom the Software is furnished to do so,subject to
+ * the following conditions:
+ * The above copyright notice and this permission notice shall
+ * be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED ''AS IS'', WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR
+ * ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM,OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+/**
+ * @file batchBench.cpp
+ * @brief  Batch planning throughput for growing worker pools
+ * @author Bhargav Dandamudi
+ * @version 1
+ * @date 2019-04-16
+ */
+#include "../include/BatchPlanner.h"
+#include "../include/BitWavefront.h"
+#include "../include/FlowField.h"
+#include "../include/MapFile.h"
+#include "../include/TiledGrid.h"
+#include "../include/optimalPlanner.h"
+#include "./benchMaps.h"
+#include <benchmark/benchmark.h>
+#include <cstdio>
+
+// 256 seeded queries on one random map per batch, run with 1, 2, 4 and 8
+// workers. Reports planned queries per second.
+static void BM_PlanBatch(benchmark::State &state) {
+  int size = 512;
+  OccupancyGrid grid(randomObstacleMap(size, 0.2, 42));
+  std::mt19937 generator(7);
+  std::uniform_int_distribution<int> cell(0, grid.getCellCount() - 1);
+  std::vector<PlanQuery> queries;
+  while (queries.size() < 256) {
+    int start = cell(generator);
+    int goal = cell(generator);
+    if (!grid.isOccupied(start) && !grid.isOccupied(goal) && start != goal) {
+      queries.push_back(
+          std::make_pair(grid.toPosition(start), grid.toPosition(goal)));
+    }
+  }
+  BatchPlanner batch(int(state.range(0)));
+  for (auto _ : state) {
+    std::vector<PlanResult> results = batch.planBatch(grid, queries);
+    benchmark::DoNotOptimize(results);
+  }
+  state.SetItemsProcessed(int64_t(state.iterations()) *
+                          int64_t(queries.size()));
+}
+
+// flow field of one goal on a 2048 random map built with 1, 2, 4 and 8
+// threads
+static void BM_FlowFieldBuild(benchmark::State &state) {
+  int size = 2048;
+  OccupancyGrid grid(randomObstacleMap(size, 0.2, 42));
+  FlowField field;
+  for (auto _ : state) {
+    field.build(grid, std::make_pair(size - 1, size - 1),
+                int(state.range(0)));
+    benchmark::DoNotOptimize(field.getDistance(std::make_pair(0, 0)));
+  }
+}
+// the distances of BM_FlowFieldBuild from the bit parallel wavefront
+static void BM_BitWavefrontDistances(benchmark::State &state) {
+  int size = 2048;
+  OccupancyGrid grid(randomObstacleMap(size, 0.2, 42));
+  BitWavefront wavefront(grid);
+  std::vector<uint32_t> distance;
+  for (auto _ : state) {
+    wavefront.distances(std::make_pair(size - 1, size - 1), distance);
+    benchmark::DoNotOptimize(distance.data());
+  }
+}
+// corner to corner reachability on random maps up to 8192 x 8192 (64M
+// cells)
+static void BM_BitWavefrontReachable(benchmark::State &state) {
+  int size = int(state.range(0));
+  OccupancyGrid grid(randomObstacleMap(size, 0.2, 42), CellStorage::BIT);
+  // free the corners and their neighbors so they are not walled in
+  for (int cell : {0, 1, size}) {
+    grid.setValue(cell, 0);
+    grid.setValue(grid.getCellCount() - 1 - cell, 0);
+  }
+  BitWavefront wavefront(grid);
+  bool reachable = false;
+  for (auto _ : state) {
+    reachable = wavefront.isReachable(std::make_pair(0, 0),
+                                      std::make_pair(size - 1, size - 1));
+    benchmark::DoNotOptimize(reachable);
+  }
+  state.counters["reachable"] = reachable;
+}
+// query for a walled in goal on a 1024 random map, searched out by astar
+// (0) or answered by the reachability check of the planner (1)
+static void BM_UnreachableGoal(benchmark::State &state) {
+  int size = 1024;
+  OccupancyGrid grid(randomObstacleMap(size, 0.2, 42), CellStorage::BIT);
+  std::pair<int, int> goal(size - 1, size - 1);
+  grid.setValue(0, 0);
+  grid.setValue(grid.toIndex(goal), 0);
+  grid.setValue(grid.toIndex(std::make_pair(size - 2, size - 1)), 1);
+  grid.setValue(grid.toIndex(std::make_pair(size - 1, size - 2)), 1);
+  optimalPlanner planner;
+  planner.setReachabilityCheck(state.range(0) == 1);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        planner.search(grid, std::make_pair(0, 0), goal).size());
+  }
+  state.counters["expanded"] = planner.getExpandedNodes();
+}
+// maps and releases a saved 8192 x 8192 map, then reads one cell per row
+// through the view, which pages in one page per row
+static void BM_MapFileOpen(benchmark::State &state) {
+  int size = 8192;
+  std::string file_name = "bench_map.gmap";
+  MapFile::save(file_name,
+                OccupancyGrid(randomObstacleMap(size, 0.2, 42),
+                              state.range(0) ? CellStorage::BIT
+                                             : CellStorage::BYTE));
+  MapFile map;
+  for (auto _ : state) {
+    map.open(file_name);
+    GridView view = map.getView();
+    int occupied = 0;
+    for (int y = 0; y < size; y++) {
+      occupied += view.isOccupied(std::make_pair(y, y));
+    }
+    benchmark::DoNotOptimize(occupied);
+    map.close();
+  }
+  std::remove(file_name.c_str());
+}
+// 256 cell query on a mapped 8192 x 8192 file paged in tiles, the cache of
+// 64 tiles is cold for every query
+static void BM_TiledSearch(benchmark::State &state) {
+  int size = 8192;
+  std::string file_name = "bench_tiled.gmap";
+  OccupancyGrid grid(randomObstacleMap(size, 0.2, 42), CellStorage::BIT);
+  std::pair<int, int> start(4000, 4000);
+  std::pair<int, int> goal(4100, 4156);
+  grid.setValue(grid.toIndex(start), 0);
+  grid.setValue(grid.toIndex(goal), 0);
+  MapFile::save(file_name, grid);
+  TiledGrid tiled(64);
+  tiled.open(file_name);
+  optimalPlanner planner;
+  for (auto _ : state) {
+    tiled.clear();
+    std::stack<std::pair<int, int>> path = planner.search(tiled, start, goal);
+    benchmark::DoNotOptimize(path);
+  }
+  state.counters["tiles"] = planner.getSearchedTiles();
+  std::remove(file_name.c_str());
+}
+// the 256 starts of BM_PlanBatch heading to one goal, read from its field
+static void BM_FlowFieldPaths(benchmark::State &state) {
+  int size = 512;
+  OccupancyGrid grid(randomObstacleMap(size, 0.2, 42));
+  std::pair<int, int> goal(size - 1, size - 1);
+  FlowField field;
+  field.build(grid, goal);
+  std::mt19937 generator(7);
+  std::uniform_int_distribution<int> cell(0, grid.getCellCount() - 1);
+  std::vector<std::pair<int, int>> starts;
+  while (starts.size() < 256) {
+    int start = cell(generator);
+    if (!grid.isOccupied(start)) {
+      starts.push_back(grid.toPosition(start));
+    }
+  }
+  for (auto _ : state) {
+    for (const auto &start : starts) {
+      benchmark::DoNotOptimize(field.path(start));
+    }
+  }
+  state.SetItemsProcessed(int64_t(state.iterations()) *
+                          int64_t(starts.size()));
+}
+
+BENCHMARK(BM_PlanBatch)
+    ->RangeMultiplier(2)
+    ->Range(1, 8)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+BENCHMARK(BM_FlowFieldBuild)
+    ->RangeMultiplier(2)
+    ->Range(1, 8)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+BENCHMARK(BM_BitWavefrontDistances)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_BitWavefrontReachable)
+    ->RangeMultiplier(4)
+    ->Range(512, 8192)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_UnreachableGoal)->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_MapFileOpen)->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_FlowFieldPaths)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_TiledSearch)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,168 @@
+/* Copyright (C)
+ * 2019 - Bhargav Dandamudi
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the 'Software'), to deal in the Software without
+ * restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit
+ * persons to whom the Software is furnished to do so,subject to
+ * the following conditions:
+ * The above copyright notice and this permission notice shall
+ * be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED ''AS IS'', WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR
+ * ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM,OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+/**
+ * @file benchMaps.h
+ * @brief  Seeded map generators shared by the benchmarks
+ * @author Bhargav Dandamudi
+ * @version 1
+ * @date 2019-04-10
+ */
+#pragma once
+#include <algorithm>
+#include <random>
+#include <vector>
+
+/* ----------------------------------------------------------------*/
+/**
+ * @brief  Square map with randomly placed obstacles. The top left and bottom
+ *          right corners are always free so they can be used as start/goal.
+ *
+ * @param int side length of the map
+ * @param double fraction of cells which are obstacles
+ * @param unsigned seed for the generator
+ *
+ * @return world map, 1 = obstacle, 0 = free
+ */
+/* ----------------------------------------------------------------*/
+inline std::vector<std::vector<int>> randomObstacleMap(int size, double density,
+                                                       unsigned seed) {
+  std::mt19937 generator(seed);
+  std::bernoulli_distribution obstacle(density);
+  std::vector<std::vector<int>> map(size, std::vector<int>(size, 0));
+  for (int y = 0; y < size; y++) {
+    for (int x = 0; x < size; x++) {
+      map[y][x] = obstacle(generator) ? 1 : 0;
+    }
+  }
+  map[0][0] = 0;
+  map[size - 1][size - 1] = 0;
+  return map;
+}
+
+/* ----------------------------------------------------------------*/
+/**
+ * @brief  Square map without any obstacle
+ *
+ * @param int side length of the map
+ *
+ * @return world map with all cells free
+ */
+/* ----------------------------------------------------------------*/
+inline std::vector<std::vector<int>> openMap(int size) {
+  return std::vector<std::vector<int>>(size, std::vector<int>(size, 0));
+}
+
+/* ----------------------------------------------------------------*/
+/**
+ * @brief  Square map split into rooms by one cell thick walls. Every wall
+ *          segment between two rooms has one door at a seeded position.
+ *
+ * @param int side length of the map
+ * @param int room side length, walls included
+ * @param unsigned seed for the generator
+ *
+ * @return world map, 1 = wall, 0 = free
+ */
+/* ----------------------------------------------------------------*/
+inline std::vector<std::vector<int>> roomMap(int size, int room,
+                                             unsigned seed) {
+  std::mt19937 generator(seed);
+  std::uniform_int_distribution<int> door(1, room - 1);
+  std::vector<std::vector<int>> map(size, std::vector<int>(size, 0));
+  for (int y = room; y < size; y += room) {
+    for (int x = 0; x < size; x++) {
+      map[y][x] = 1;
+    }
+    for (int x = 0; x < size; x += room) {
+      map[y][std::min(size - 1, x + door(generator))] = 0;
+    }
+  }
+  for (int x = room; x < size; x += room) {
+    for (int y = 0; y < size; y++) {
+      if (map[y][x] == 0 && y % room != 0) {
+        map[y][x] = 1;
+      }
+    }
+    for (int y = 0; y < size; y += room) {
+      map[std::min(size - 1, y + door(generator))][x] = 0;
+    }
+  }
+  map[0][0] = 0;
+  map[size - 1][size - 1] = 0;
+  return map;
+}
+
+/* ----------------------------------------------------------------*/
+/**
+ * @brief  Square perfect maze carved by a seeded depth first search. Rooms
+ *          sit on odd coordinates with one cell walls in between, so every
+ *          pair of free cells is joined by exactly one corridor path.
+ *
+ * @param int side length of the map
+ * @param unsigned seed for the generator
+ *
+ * @return world map, 1 = wall, 0 = free
+ */
+/* ----------------------------------------------------------------*/
+inline std::vector<std::vector<int>> mazeMap(int size, unsigned seed) {
+  static const int DY[4] = {-2, 0, 2, 0};
+  static const int DX[4] = {0, -2, 0, 2};
+  std::mt19937 generator(seed);
+  std::vector<std::vector<int>> map(size, std::vector<int>(size, 1));
+  std::vector<std::pair<int, int>> stack(1, std::make_pair(1, 1));
+  map[1][1] = 0;
+  while (!stack.empty()) {
+    int y = stack.back().first;
+    int x = stack.back().second;
+    int open[4];
+    int count = 0;
+    for (int k = 0; k < 4; k++) {
+      int ny = y + DY[k];
+      int nx = x + DX[k];
+      if (ny > 0 && nx > 0 && ny < size - 1 && nx < size - 1 &&
+          map[ny][nx] == 1) {
+        open[count++] = k;
+      }
+    }
+    if (count == 0) {
+      stack.pop_back();
+      continue;
+    }
+    int k = open[std::uniform_int_distribution<int>(0, count - 1)(generator)];
+    map[y + DY[k] / 2][x + DX[k] / 2] = 0;
+    map[y + DY[k]][x + DX[k]] = 0;
+    stack.push_back(std::make_pair(y + DY[k], x + DX[k]));
+  }
+  // corners as entrances, joined to the nearest room
+  map[0][0] = map[0][1] = 0;
+  int last = (size - 2) % 2 == 1 ? size - 2 : size - 3;
+  for (int y = last; y < size; y++) {
+    map[y][last] = 0;
+  }
+  for (int x = last; x < size; x++) {
+    map[size - 1][x] = 0;
+  }
+  return map;
+}
@@ -0,0 +1,99 @@
+/* Copyright (C)
+ * 2019 - Bhargav Dandamudi
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the 'Software'), to deal in the Software without
+ * restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit
+ * persons to whom the Software is furnished to do so,subject to
+ * the following conditions:
+ * The above copyright notice and this permission notice shall
+ * be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED ''AS IS'', WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR
+ * ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM,OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+/**
+ * @file openListBench.cpp
+ * @brief  Compares the open list implementations of optimalPlanner
+ * @author Bhargav Dandamudi
+ * @version 1
+ * @date 2019-04-10
+ */
+#include "../include/optimalPlanner.h"
+#include "./benchMaps.h"
+#include <benchmark/benchmark.h>
+
+// corner to corner search on a seeded random map, the map is copied into
+// the planner on every call for all open lists alike
+static void searchCornerToCorner(
+    benchmark::State &state, OpenListType type, double density,
+    NodeLayout layout = NodeLayout::ARRAY_OF_STRUCTS) {
+  int size = int(state.range(0));
+  std::vector<std::vector<int>> map = randomObstacleMap(size, density, 42);
+  optimalPlanner planner;
+  planner.setOpenListType(type);
+  planner.setNodeLayout(layout);
+  for (auto _ : state) {
+    std::stack<std::pair<int, int>> path = planner.search(
+        map, std::make_pair(0, 0), std::make_pair(size - 1, size - 1));
+    benchmark::DoNotOptimize(path);
+  }
+}
+
+static void BM_SetOpenList(benchmark::State &state) {
+  searchCornerToCorner(state, OpenListType::SET, 0.2);
+}
+static void BM_BinaryHeap(benchmark::State &state) {
+  searchCornerToCorner(state, OpenListType::BINARY_HEAP, 0.2);
+}
+static void BM_QuaternaryHeap(benchmark::State &state) {
+  searchCornerToCorner(state, OpenListType::QUATERNARY_HEAP, 0.2);
+}
+static void BM_QuaternaryHeapSoA(benchmark::State &state) {
+  searchCornerToCorner(state, OpenListType::QUATERNARY_HEAP, 0.2,
+                       NodeLayout::STRUCT_OF_ARRAYS);
+}
+static void BM_BucketQueue(benchmark::State &state) {
+  searchCornerToCorner(state, OpenListType::BUCKET_QUEUE, 0.2);
+}
+
+// three cell query on a large open grid, the search context is reused so
+// the cost must not grow with the map size
+static void BM_ShortQueryLargeMap(benchmark::State &state) {
+  int size = int(state.range(0));
+  OccupancyGrid grid(openMap(size));
+  optimalPlanner planner;
+  std::pair<int, int> start = std::make_pair(size / 2, size / 2);
+  std::pair<int, int> goal = std::make_pair(size / 2, size / 2 + 3);
+  planner.search(grid, start, goal); // sizes the search context once
+  for (auto _ : state) {
+    std::stack<std::pair<int, int>> path = planner.search(grid, start, goal);
+    benchmark::DoNotOptimize(path);
+  }
+}
+
+BENCHMARK(BM_SetOpenList)->RangeMultiplier(4)->Range(64, 1024)->Unit(
+    benchmark::kMillisecond);
+BENCHMARK(BM_BinaryHeap)->RangeMultiplier(4)->Range(64, 1024)->Unit(
+    benchmark::kMillisecond);
+BENCHMARK(BM_QuaternaryHeap)->RangeMultiplier(4)->Range(64, 1024)->Unit(
+    benchmark::kMillisecond);
+BENCHMARK(BM_QuaternaryHeapSoA)->RangeMultiplier(4)->Range(64, 1024)->Unit(
+    benchmark::kMillisecond);
+BENCHMARK(BM_BucketQueue)->RangeMultiplier(4)->Range(64, 1024)->Unit(
+    benchmark::kMillisecond);
+
+BENCHMARK(BM_ShortQueryLargeMap)->RangeMultiplier(8)->Range(64, 4096)->Unit(
+    benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
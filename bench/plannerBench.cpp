@@ -0,0 +1,212 @@
+/* Copyright (C)
+ * 2019 - Bhargav Dandamudi
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the 'Software'), to deal in the Software without
+ * restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit
+ * persons to whom the Software is furnished to do so,subject to
+ * the following conditions:
+ * The above copyright notice and this permission notice shall
+ * be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED ''AS IS'', WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR
+ * ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM,OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+/**
+ * @file plannerBench.cpp
+ * @brief  Latency of optimalPlanner and RandomPlanner on generated map
+ *          families from 64 x 64 to 8192 x 8192
+ * @author Bhargav Dandamudi
+ * @version 1
+ * @date 2019-04-27
+ */
+#include "../include/ComponentIndex.h"
+#include "../include/RandomPlanner.h"
+#include "../include/optimalPlanner.h"
+#include "./benchMaps.h"
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <chrono>
+#include <memory>
+
+enum class MapFamily { RANDOM, MAZE, ROOMS, OPEN };
+
+typedef std::pair<std::pair<int, int>, std::pair<int, int>> Query;
+
+// map and queries of the running benchmark. Google Benchmark calls a
+// benchmark function several times while it picks the iteration count, the
+// map of the last family and size is kept instead of generating it again.
+struct BenchMap {
+  MapFamily family;
+  int size;
+  std::unique_ptr<OccupancyGrid> grid;
+  std::vector<Query> queries;
+};
+
+// 16 seeded start/goal pairs of free cells in one region, so every query
+// of the optimal planner finds a path
+static std::vector<Query> connectedQueries(const OccupancyGrid &grid) {
+  ComponentIndex components(grid);
+  std::mt19937 generator(11);
+  std::uniform_int_distribution<int> cell(0, grid.getCellCount() - 1);
+  std::vector<Query> queries;
+  while (queries.size() < 16) {
+    std::pair<int, int> start = grid.toPosition(cell(generator));
+    std::pair<int, int> goal = grid.toPosition(cell(generator));
+    if (start != goal && components.isConnected(start, goal)) {
+      queries.push_back(Query(start, goal));
+    }
+  }
+  return queries;
+}
+
+static const BenchMap &benchMap(MapFamily family, int size) {
+  static BenchMap current{MapFamily::OPEN, 0, nullptr, {}};
+  if (current.grid && current.family == family && current.size == size) {
+    return current;
+  }
+  current.grid.reset(); // one large map in memory at a time
+  std::vector<std::vector<int>> map;
+  switch (family) {
+  case MapFamily::RANDOM:
+    map = randomObstacleMap(size, 0.2, 42);
+    break;
+  case MapFamily::MAZE:
+    map = mazeMap(size, 42);
+    break;
+  case MapFamily::ROOMS:
+    map = roomMap(size, 16, 42);
+    break;
+  case MapFamily::OPEN:
+    map = openMap(size);
+    break;
+  }
+  current.grid.reset(new OccupancyGrid(map, CellStorage::BYTE));
+  current.family = family;
+  current.size = size;
+  current.queries = connectedQueries(*current.grid);
+  return current;
+}
+
+// latency percentiles of the timed queries and the memory of this
+// benchmark: the map plus what the planner keeps allocated
+static void reportLatencies(benchmark::State &state,
+                            std::vector<double> &latencies,
+                            const OccupancyGrid &grid,
+                            std::size_t planner_bytes) {
+  if (latencies.empty()) {
+    return;
+  }
+  std::sort(latencies.begin(), latencies.end());
+  for (int percent : {50, 90, 99}) {
+    std::size_t rank = (latencies.size() - 1) * std::size_t(percent) / 100;
+    state.counters["p" + std::to_string(percent) + "_ms"] = latencies[rank];
+  }
+  // one byte per cell, the benchmark maps use BYTE storage
+  std::size_t map_bytes = std::size_t(grid.getCellCount());
+  state.counters["memory_mb"] =
+      double(map_bytes + planner_bytes) / (1024.0 * 1024.0);
+}
+
+static double millisecondsSince(
+    std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double, std::milli>(
+             std::chrono::steady_clock::now() - start)
+      .count();
+}
+
+// one query per iteration, cycling through the queries of the map
+static void BM_OptimalPlanner(benchmark::State &state, MapFamily family) {
+  const BenchMap &map = benchMap(family, int(state.range(0)));
+  optimalPlanner planner;
+  std::vector<double> latencies;
+  double expanded = 0;
+  std::size_t next = 0;
+  for (auto _ : state) {
+    const Query &query = map.queries[next++ % map.queries.size()];
+    std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+    std::stack<std::pair<int, int>> path =
+        planner.search(*map.grid, query.first, query.second);
+    latencies.push_back(millisecondsSince(start));
+    benchmark::DoNotOptimize(path);
+    expanded += planner.getExpandedNodes();
+  }
+  state.counters["expansions/s"] =
+      benchmark::Counter(expanded, benchmark::Counter::kIsRate);
+  reportLatencies(state, latencies, *map.grid, planner.getMemoryUsage());
+}
+
+// the random planner gives up after its step limit, steps are its
+// expansions
+static void BM_RandomPlanner(benchmark::State &state, MapFamily family) {
+  const BenchMap &map = benchMap(family, int(state.range(0)));
+  RandomPlanner planner;
+  planner.setSeed(42); // the same walks on every run
+  std::vector<double> latencies;
+  double steps = 0;
+  std::size_t path_bytes = 0;
+  std::size_t next = 0;
+  for (auto _ : state) {
+    const Query &query = map.queries[next++ % map.queries.size()];
+    std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+    std::vector<std::pair<int, int>> path =
+        planner.search(*map.grid, query.first, query.second);
+    latencies.push_back(millisecondsSince(start));
+    benchmark::DoNotOptimize(path);
+    steps += double(path.size());
+    // the walk is all the random planner keeps
+    path_bytes = std::max(path_bytes,
+                          path.capacity() * sizeof(std::pair<int, int>));
+  }
+  state.counters["expansions/s"] =
+      benchmark::Counter(steps, benchmark::Counter::kIsRate);
+  reportLatencies(state, latencies, *map.grid, path_bytes);
+}
+
+BENCHMARK_CAPTURE(BM_OptimalPlanner, random, MapFamily::RANDOM)
+    ->RangeMultiplier(8)
+    ->Range(64, 8192)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_OptimalPlanner, maze, MapFamily::MAZE)
+    ->RangeMultiplier(8)
+    ->Range(64, 8192)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_OptimalPlanner, rooms, MapFamily::ROOMS)
+    ->RangeMultiplier(8)
+    ->Range(64, 8192)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_OptimalPlanner, open, MapFamily::OPEN)
+    ->RangeMultiplier(8)
+    ->Range(64, 8192)
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_CAPTURE(BM_RandomPlanner, random, MapFamily::RANDOM)
+    ->RangeMultiplier(8)
+    ->Range(64, 8192)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_RandomPlanner, maze, MapFamily::MAZE)
+    ->RangeMultiplier(8)
+    ->Range(64, 8192)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_RandomPlanner, rooms, MapFamily::ROOMS)
+    ->RangeMultiplier(8)
+    ->Range(64, 8192)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_RandomPlanner, open, MapFamily::OPEN)
+    ->RangeMultiplier(8)
+    ->Range(64, 8192)
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
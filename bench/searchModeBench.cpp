@@ -0,0 +1,279 @@
+/* Copyright (C)
+ * 2019 - Bhargav Dandamudi
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the 'Software'), to deal in the Software without
+ * restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit
+ * persons to whom the Software is furnished to do so,subject to
+ * the following conditions:
+ * The above copyright notice and this permission notice shall
+ * be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED ''AS IS'', WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR
+ * ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM,OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+/**
+ * @file searchModeBench.cpp
+ * @brief  Compare the search modes of optimalPlanner, expansions and latency
+ * @author Bhargav Dandamudi
+ * @version 1
+ * @date 2019-04-14
+ */
+#include "../include/AnytimePlanner.h"
+#include "../include/ComponentIndex.h"
+#include "../include/CostMap.h"
+#include "../include/HierarchicalPlanner.h"
+#include "../include/IncrementalPlanner.h"
+#include "../include/LandmarkHeuristic.h"
+#include "../include/optimalPlanner.h"
+#include "./benchMaps.h"
+#include <benchmark/benchmark.h>
+
+// corner to corner search on a grid built once, reports the nodes expanded
+// by the last search next to the latency
+static void searchCornerToCorner(benchmark::State &state, SearchMode mode,
+                                 const std::vector<std::vector<int>> &map,
+                                 bool parallel = false) {
+  int size = int(map.size());
+  OccupancyGrid grid(map);
+  optimalPlanner planner;
+  planner.setSearchMode(mode);
+  planner.setParallelFrontiers(parallel);
+  for (auto _ : state) {
+    std::stack<std::pair<int, int>> path = planner.search(
+        grid, std::make_pair(0, 0), std::make_pair(size - 1, size - 1));
+    benchmark::DoNotOptimize(path);
+  }
+  state.counters["expansions"] = planner.getExpandedNodes();
+}
+
+static void BM_AstarOpen(benchmark::State &state) {
+  searchCornerToCorner(state, SearchMode::ASTAR, openMap(int(state.range(0))));
+}
+static void BM_JumpPointOpen(benchmark::State &state) {
+  searchCornerToCorner(state, SearchMode::JUMP_POINT,
+                       openMap(int(state.range(0))));
+}
+static void BM_AstarRooms(benchmark::State &state) {
+  searchCornerToCorner(state, SearchMode::ASTAR,
+                       roomMap(int(state.range(0)), 16, 42));
+}
+static void BM_JumpPointRooms(benchmark::State &state) {
+  searchCornerToCorner(state, SearchMode::JUMP_POINT,
+                       roomMap(int(state.range(0)), 16, 42));
+}
+static void BM_EightConnectedRooms(benchmark::State &state) {
+  int size = int(state.range(0));
+  OccupancyGrid grid(roomMap(size, 16, 42));
+  optimalPlanner planner;
+  planner.setConnectivity(Connectivity::EIGHT_CONNECTED);
+  for (auto _ : state) {
+    std::stack<std::pair<int, int>> path = planner.search(
+        grid, std::make_pair(0, 0), std::make_pair(size - 1, size - 1));
+    benchmark::DoNotOptimize(path);
+  }
+  state.counters["expansions"] = planner.getExpandedNodes();
+}
+static void BM_BidirectionalRooms(benchmark::State &state) {
+  searchCornerToCorner(state, SearchMode::BIDIRECTIONAL,
+                       roomMap(int(state.range(0)), 16, 42));
+}
+static void BM_BidirectionalTwoThreadsRooms(benchmark::State &state) {
+  searchCornerToCorner(state, SearchMode::BIDIRECTIONAL,
+                       roomMap(int(state.range(0)), 16, 42), true);
+}
+// the abstraction is built once outside the timed loop, like a map which is
+// loaded once and queried many times
+static void BM_HierarchicalRooms(benchmark::State &state) {
+  int size = int(state.range(0));
+  OccupancyGrid grid(roomMap(size, 16, 42));
+  HierarchicalPlanner planner(grid, 16);
+  for (auto _ : state) {
+    std::stack<std::pair<int, int>> path = planner.search(
+        std::make_pair(0, 0), std::make_pair(size - 1, size - 1));
+    benchmark::DoNotOptimize(path);
+  }
+  state.counters["abstract_nodes"] = planner.getAbstractNodeCount();
+}
+// a cell halfway along the path is blocked and freed again every iteration,
+// each change followed by a replan; compare with BM_AstarRooms
+static void BM_IncrementalReplanRooms(benchmark::State &state) {
+  int size = int(state.range(0));
+  std::pair<int, int> start(0, 0);
+  IncrementalPlanner planner(roomMap(size, 16, 42), start,
+                             std::make_pair(size - 1, size - 1));
+  std::stack<std::pair<int, int>> path = planner.search();
+  for (int step = int(path.size()) / 2; step > 0; step--) {
+    path.pop();
+  }
+  std::pair<int, int> cell = path.top();
+  int value = 0;
+  for (auto _ : state) {
+    value = 1 - value;
+    planner.updateCell(cell, value);
+    benchmark::DoNotOptimize(planner.replan(start));
+  }
+  state.counters["expansions"] = planner.getExpandedNodes();
+}
+// anti-diagonal query across the rooms, where Manhattan distance misleads
+// astar into many dead end rooms; with and without 8 landmark tables built
+// outside the timed loop
+static void searchAcrossRooms(benchmark::State &state, bool use_landmarks) {
+  int size = int(state.range(0));
+  OccupancyGrid grid(roomMap(size, 16, 3));
+  optimalPlanner planner;
+  if (use_landmarks) {
+    std::shared_ptr<LandmarkHeuristic> landmarks(new LandmarkHeuristic());
+    landmarks->build(grid, 8);
+    planner.setLandmarks(landmarks);
+  }
+  for (auto _ : state) {
+    std::stack<std::pair<int, int>> path = planner.search(
+        grid, std::make_pair(0, size - 1), std::make_pair(size - 1, 0));
+    benchmark::DoNotOptimize(path);
+  }
+  state.counters["expansions"] = planner.getExpandedNodes();
+}
+
+static void BM_AstarAcrossRooms(benchmark::State &state) {
+  searchAcrossRooms(state, false);
+}
+static void BM_AstarLandmarksAcrossRooms(benchmark::State &state) {
+  searchAcrossRooms(state, true);
+}
+// goal walled off in the opposite corner, with and without the component
+// index answering before the search
+static void searchUnreachable(benchmark::State &state, bool use_index) {
+  int size = int(state.range(0));
+  OccupancyGrid grid(openMap(size));
+  grid.setValue(grid.toIndex(std::make_pair(size - 2, size - 1)), 1);
+  grid.setValue(grid.toIndex(std::make_pair(size - 1, size - 2)), 1);
+  optimalPlanner planner;
+  if (use_index) {
+    planner.setComponentIndex(
+        std::shared_ptr<ComponentIndex>(new ComponentIndex(grid)));
+  }
+  for (auto _ : state) {
+    std::stack<std::pair<int, int>> path = planner.search(
+        grid, std::make_pair(0, 0), std::make_pair(size - 1, size - 1));
+    benchmark::DoNotOptimize(path);
+  }
+  state.counters["expansions"] = planner.getExpandedNodes();
+}
+
+static void BM_AstarUnreachable(benchmark::State &state) {
+  searchUnreachable(state, false);
+}
+static void BM_ComponentIndexUnreachable(benchmark::State &state) {
+  searchUnreachable(state, true);
+}
+// anytime search under a 5 ms budget, reports the bound reached in time
+static void BM_AnytimeRooms5ms(benchmark::State &state) {
+  int size = int(state.range(0));
+  OccupancyGrid grid(roomMap(size, 16, 3));
+  AnytimePlanner planner(3.0, 0.5);
+  for (auto _ : state) {
+    std::stack<std::pair<int, int>> path = planner.search(
+        grid, std::make_pair(0, size - 1), std::make_pair(size - 1, 0),
+        std::chrono::steady_clock::now() + std::chrono::milliseconds(5));
+    benchmark::DoNotOptimize(path);
+  }
+  state.counters["bound"] = planner.getSuboptimalityBound();
+  state.counters["searches"] = planner.getCompletedSearches();
+}
+// terrain costs from the walls inflated by 4 cells, the unit cost search
+// on the same map is BM_AstarRooms
+static void BM_AstarTerrainRooms(benchmark::State &state) {
+  int size = int(state.range(0));
+  OccupancyGrid grid(roomMap(size, 16, 42));
+  std::shared_ptr<CostMap> costs(new CostMap(size, size));
+  for (int i = 0; i < grid.getCellCount(); i++) {
+    if (grid.isOccupied(i)) {
+      costs->setCost(i, CostMap::LETHAL);
+    }
+  }
+  costs->inflate(4, 50);
+  optimalPlanner planner;
+  planner.setCostMap(costs);
+  for (auto _ : state) {
+    std::stack<std::pair<int, int>> path = planner.search(
+        grid, std::make_pair(0, 0), std::make_pair(size - 1, size - 1));
+    benchmark::DoNotOptimize(path);
+  }
+  state.counters["expansions"] = planner.getExpandedNodes();
+}
+static void BM_CostMapInflate(benchmark::State &state) {
+  int size = int(state.range(0));
+  OccupancyGrid grid(roomMap(size, 16, 42));
+  CostMap walls(size, size);
+  for (int i = 0; i < grid.getCellCount(); i++) {
+    if (grid.isOccupied(i)) {
+      walls.setCost(i, CostMap::LETHAL);
+    }
+  }
+  for (auto _ : state) {
+    CostMap costs = walls;
+    costs.inflate(4, 50);
+    benchmark::DoNotOptimize(costs.getCosts());
+  }
+}
+
+BENCHMARK(BM_AstarOpen)->RangeMultiplier(4)->Range(64, 1024)->Unit(
+    benchmark::kMillisecond);
+BENCHMARK(BM_JumpPointOpen)->RangeMultiplier(4)->Range(64, 1024)->Unit(
+    benchmark::kMillisecond);
+BENCHMARK(BM_AstarRooms)->RangeMultiplier(4)->Range(64, 1024)->Unit(
+    benchmark::kMillisecond);
+BENCHMARK(BM_JumpPointRooms)->RangeMultiplier(4)->Range(64, 1024)->Unit(
+    benchmark::kMillisecond);
+BENCHMARK(BM_EightConnectedRooms)->RangeMultiplier(4)->Range(64, 1024)->Unit(
+    benchmark::kMillisecond);
+BENCHMARK(BM_BidirectionalRooms)->RangeMultiplier(4)->Range(64, 1024)->Unit(
+    benchmark::kMillisecond);
+BENCHMARK(BM_BidirectionalTwoThreadsRooms)
+    ->RangeMultiplier(4)
+    ->Range(64, 1024)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+BENCHMARK(BM_HierarchicalRooms)->RangeMultiplier(4)->Range(64, 1024)->Unit(
+    benchmark::kMillisecond);
+BENCHMARK(BM_AstarAcrossRooms)->RangeMultiplier(4)->Range(64, 1024)->Unit(
+    benchmark::kMillisecond);
+BENCHMARK(BM_AstarLandmarksAcrossRooms)
+    ->RangeMultiplier(4)
+    ->Range(64, 1024)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_AstarUnreachable)->RangeMultiplier(4)->Range(64, 1024)->Unit(
+    benchmark::kMillisecond);
+BENCHMARK(BM_ComponentIndexUnreachable)
+    ->RangeMultiplier(4)
+    ->Range(64, 1024)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_AnytimeRooms5ms)
+    ->RangeMultiplier(4)
+    ->Range(64, 1024)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_IncrementalReplanRooms)
+    ->RangeMultiplier(4)
+    ->Range(64, 1024)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_AstarTerrainRooms)
+    ->RangeMultiplier(4)
+    ->Range(64, 1024)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_CostMapInflate)
+    ->RangeMultiplier(4)
+    ->Range(64, 4096)
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
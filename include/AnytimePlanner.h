@@ -0,0 +1,155 @@
+/* Copyright (C)
+ * 2019 - Bhargav Dandamudi
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the 'Software'), to deal in the Software without
+ * restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit
+ * persons to whom the Software is furnished to do so,subject to
+ * the following conditions:
+ * The above copyright notice and this permission notice shall
+ * be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED ''AS IS'', WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR
+ * ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM,OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+/**
+ * @file AnytimePlanner.h
+ * @brief  Anytime repairing astar (ARA*) which stops at a deadline
+ * @author Bhargav Dandamudi
+ * @version 1
+ * @date 2019-04-21
+ */
+#pragma once
+#include "./GridView.h"
+#include "./IndexedHeap.h"
+#include <chrono>
+#include <functional>
+#include <stack>
+#include <utility>
+#include <vector>
+
+/* ----------------------------------------------------------------*/
+/**
+ * @brief  Anytime planner for a fixed planning budget (ARA*).
+ *
+ *          The first search is weighted astar with the heuristic inflated
+ *          by epsilon > 1, which finds a path quickly whose cost is at most
+ *          epsilon times the optimal one. Epsilon is then lowered step by
+ *          step; every following search starts from the costs found so
+ *          far and only expands cells whose cost can still improve. The
+ *          planner stops at epsilon 1 (optimal path) or at the deadline and
+ *          returns the best complete path.
+ *
+ *          With every path the planner reports its suboptimality bound,
+ *          cost / bound is a lower bound of the optimal cost.
+ */
+/* ----------------------------------------------------------------*/
+class AnytimePlanner {
+public:
+  typedef std::chrono::steady_clock::time_point Deadline;
+  typedef std::function<void(const std::stack<std::pair<int, int>> &, double)>
+      SolutionCallback;
+
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  Constructor
+   *
+   * @param double epsilon of the first search, >= 1
+   * @param double amount epsilon is lowered by after every search; a step
+   *          <= 0 lowers epsilon straight to 1 after the first search
+   *          instead of repeating it
+   */
+  /* ----------------------------------------------------------------*/
+  explicit AnytimePlanner(double = 3.0, double = 0.5);
+
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  Improves the path until the deadline or until it is optimal
+   *
+   * @param GridView world map
+   * @param std::pair start location
+   * @param std::pair goal location
+   * @param Deadline point in time the planner has to return by
+   *
+   * @return best path found, start on top like optimalPlanner::search.
+   *          Only the start if no path exists or the first search did
+   *          not finish in time.
+   */
+  /* ----------------------------------------------------------------*/
+  std::stack<std::pair<int, int>> search(const GridView &, std::pair<int, int>,
+                                         std::pair<int, int>, Deadline);
+
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  Called with every improved path and its suboptimality bound,
+   *          so the caller can act on the first path before the deadline
+   *
+   * @param SolutionCallback function, empty for none
+   */
+  /* ----------------------------------------------------------------*/
+  void setSolutionCallback(SolutionCallback);
+
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  getter function for the suboptimality bound of the returned
+   *          path, 1 means optimal
+   *
+   * @return bound, infinity if no path was returned
+   */
+  /* ----------------------------------------------------------------*/
+  double getSuboptimalityBound() { return bound_; }
+  double getInitialEpsilon() { return initial_epsilon_; }
+  double getEpsilonStep() { return epsilon_step_; }
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  getter function for the number of searches which completed
+   *          in the last call, each one gave an improved path
+   */
+  /* ----------------------------------------------------------------*/
+  int getCompletedSearches() { return completed_searches_; }
+  int getExpandedNodes() { return expanded_nodes_; }
+
+private:
+  double fValue(int);
+  float gCost(int);
+  // weighted astar pass, false if the deadline was hit first
+  bool improvePath(Deadline);
+  // epsilon' = min(epsilon, g(goal) / lowest unexpanded g + h)
+  double currentBound();
+  std::stack<std::pair<int, int>> trackPath();
+
+  double initial_epsilon_;
+  double epsilon_step_;
+  double epsilon_;
+  double bound_;
+  int completed_searches_;
+  int expanded_nodes_;
+  SolutionCallback callback_;
+
+  GridView world_map_;
+  std::pair<int, int> start_position_;
+  std::pair<int, int> goal_position_;
+  int start_index_;
+  int goal_index_;
+  // search state, valid for a cell only if its stamp is the current query
+  std::vector<float> g_cost_;
+  std::vector<int> parent_;
+  std::vector<unsigned> seen_;   // query the g cost belongs to
+  std::vector<unsigned> closed_; // search pass the cell was expanded in
+  std::vector<unsigned> incons_; // search pass the cell was made
+                                 // inconsistent in
+  unsigned query_;
+  unsigned pass_;
+  std::vector<int> inconsistent_; // expanded cells improved again
+  IndexedHeap<4> open_;
+};
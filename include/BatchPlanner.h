@@ -0,0 +1,131 @@
+/* Copyright (C)
+ * 2019 - Bhargav Dandamudi
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the 'Software'), to deal in the Software without
+ * restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit
+ * persons to whom the Software is furnished to do so,subject to
+ * the following conditions:
+ * The above copyright notice and this permission notice shall
+ * be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED ''AS IS'', WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR
+ * ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM,OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+/**
+ * @file BatchPlanner.h
+ * @brief  Fixed thread pool planning many queries on one shared map
+ * @author Bhargav Dandamudi
+ * @version 1
+ * @date 2019-04-16
+ */
+#pragma once
+#include "./GridView.h"
+#include "./PlanResult.h"
+#include "./optimalPlanner.h"
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// start and goal location of one query
+typedef std::pair<std::pair<int, int>, std::pair<int, int>> PlanQuery;
+
+/* ----------------------------------------------------------------*/
+/**
+ * @brief  Runs batches of optimalPlanner queries on a fixed pool of worker
+ *          threads. All workers read the same map through a GridView, no
+ *          copy is made. Every worker keeps its own optimalPlanner, so its
+ *          search context and open list are reused from query to query.
+ *
+ *          Workers take the next unplanned query from a shared counter, so
+ *          long and short queries balance out across the pool.
+ */
+/* ----------------------------------------------------------------*/
+class BatchPlanner {
+public:
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  Starts the worker threads
+   *
+   * @param int number of workers, 0 uses one per hardware thread
+   */
+  /* ----------------------------------------------------------------*/
+  explicit BatchPlanner(int = 0);
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  Stops and joins the worker threads
+   */
+  /* ----------------------------------------------------------------*/
+  ~BatchPlanner();
+  BatchPlanner(const BatchPlanner &) = delete;
+  BatchPlanner &operator=(const BatchPlanner &) = delete;
+
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  Plans all queries on the map and waits for the results. Calls
+   *          from several threads are run one batch after the other.
+   *
+   * @param GridView world map, must not change during the call
+   * @param std::vector<PlanQuery> start and goal locations
+   *
+   * @return results in the same order as the queries, as optimalPlanner::plan
+   *          returns them, so every query tells whether and why it failed
+   */
+  /* ----------------------------------------------------------------*/
+  std::vector<PlanResult> planBatch(const GridView &,
+                                    const std::vector<PlanQuery> &);
+
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  Selects the search mode of every worker for the next batches
+   *
+   * @param SearchMode search mode
+   */
+  /* ----------------------------------------------------------------*/
+  void setSearchMode(SearchMode);
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  getter function for the statistics of the last batch, summed
+   *          over all its queries
+   */
+  /* ----------------------------------------------------------------*/
+  SearchStats getBatchStats();
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  getter function for the number of worker threads
+   */
+  /* ----------------------------------------------------------------*/
+  int getThreadCount();
+
+private:
+  // loop run by every worker thread
+  void work(int);
+
+  std::vector<optimalPlanner> planners_; // one per worker
+  std::vector<std::thread> workers_;
+  std::mutex batch_mutex_; // held by the caller for a whole batch
+  std::mutex mutex_;       // guards the batch fields below
+  std::condition_variable start_cv_;
+  std::condition_variable done_cv_;
+  const GridView *map_;
+  const std::vector<PlanQuery> *queries_;
+  std::vector<PlanResult> *results_;
+  std::atomic<int> next_query_; // next query a worker takes
+  SearchStats batch_stats_;     // workers add theirs when done
+  int busy_workers_;            // workers not done with the current batch
+  unsigned batch_id_;           // counts batches so workers see new ones
+  bool stopping_;
+};
@@ -0,0 +1,168 @@
+/* Copyright (C)
+ * 2019 - Bhargav Dandamudi
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the 'Software'), to deal in the Software without
+ * restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit
+ * persons to whom the Software is furnished to do so,subject to
+ * the following conditions:
+ * The above copyright notice and this permission notice shall
+ * be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED ''AS IS'', WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR
+ * ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM,OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+/**
+ * @file BitWavefront.h
+ * @brief  Breadth first wavefronts on packed 64 bit free cell masks
+ * @author Bhargav Dandamudi
+ * @version 1
+ * @date 2019-04-25
+ */
+#pragma once
+#include "./GridView.h"
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/* ----------------------------------------------------------------*/
+/**
+ * @brief  Unit cost (four connected) reachability and distance layers
+ *          computed 64 cells at a time. Free cells are kept as one bit per
+ *          cell, every row starting on a new word like BIT grids. A
+ *          breadth first layer is the previous layer shifted left, right,
+ *          up and down, masked with the free cells not reached before.
+ *
+ *          Only the words next to a nonzero word of the current layer are
+ *          computed, so a layer costs O(layer words) and not O(map words),
+ *          and a query touching a small part of a huge map stays cheap.
+ *          Reachability needs no layers: a flood fills whole free runs of
+ *          a word at once with carry free shifts and revisits a word only
+ *          when it is handed new cells.
+ *
+ *          Queries reuse scratch buffers, one object must not be queried
+ *          from several threads at once.
+ */
+/* ----------------------------------------------------------------*/
+class BitWavefront {
+public:
+  static const uint32_t UNREACHABLE = 0xffffffffu;
+
+  BitWavefront();
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  Constructor, packs the free cells of the map
+   *
+   * @param GridView world map, must outlive the object
+   */
+  /* ----------------------------------------------------------------*/
+  explicit BitWavefront(const GridView &);
+
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  Packs the free cells of a map from scratch
+   *
+   * @param GridView world map, must outlive the object
+   */
+  /* ----------------------------------------------------------------*/
+  void build(const GridView &);
+
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  Reads changed cells again from the viewed map. Call after
+   *          changing the viewed map; cells outside the map are skipped.
+   *
+   * @param std::vector<std::pair<int,int>> changed cell locations
+   */
+  /* ----------------------------------------------------------------*/
+  void updateCells(const std::vector<std::pair<int, int>> &);
+
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  Tells if a path between two cells exists
+   *
+   * @param std::pair location
+   * @param std::pair location
+   *
+   * @return true if both cells are free and connected
+   */
+  /* ----------------------------------------------------------------*/
+  bool isReachable(std::pair<int, int>, std::pair<int, int>);
+
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  Number of steps of a shortest path, the wavefront stops as
+   *          soon as it reaches the target
+   *
+   * @param std::pair start location
+   * @param std::pair target location
+   *
+   * @return steps, -1 if there is no path
+   */
+  /* ----------------------------------------------------------------*/
+  int getDistance(std::pair<int, int>, std::pair<int, int>);
+
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  Distance of every cell to the goal, one wavefront over the
+   *          whole region of the goal
+   *
+   * @param std::pair goal location
+   * @param std::vector<uint32_t> filled with the steps of every cell,
+   *        UNREACHABLE for obstacles and other regions
+   *
+   * @return number of cells reached, the goal included
+   */
+  /* ----------------------------------------------------------------*/
+  int distances(std::pair<int, int>, std::vector<uint32_t> &);
+
+  int getHeight() const { return height_; }
+  int getWidth() const { return width_; }
+  int getWordsPerRow() const { return words_per_row_; }
+  const uint64_t *getFreeWords() const { return free_.data(); }
+  // bytes of the packed cells and the query scratch
+  std::size_t getMemoryUsage() const;
+
+private:
+  // grows layers from the source until the target cell (or, with -1,
+  // every reachable cell) is reached. Writes the layer of every reached
+  // cell if distances is not null. Returns the layer of the target, -1 if
+  // it was not reached, or the number of cells reached without a target
+  int wavefront(std::pair<int, int>, int, uint32_t *);
+  // fills the region of the source word by word until the target cell is
+  // reached, true if it is
+  bool flood(std::pair<int, int>, int);
+  // free bit of a cell, cells outside the map read as blocked and are
+  // not written
+  bool isFree(std::pair<int, int>) const;
+  void setFree(std::pair<int, int>, bool);
+
+  GridView world_map_;
+  int height_;
+  int width_;
+  int words_per_row_;
+  std::vector<uint64_t> free_; // 1 for free cells, padding bits are 0
+
+  // scratch of the queries
+  std::vector<uint64_t> reached_;  // cells reached by the running query
+  std::vector<uint64_t> layer_;    // cells of the current layer
+  std::vector<uint64_t> next_;     // cells of the next layer
+  std::vector<int> active_;        // nonzero words of layer_
+  std::vector<int> next_active_;   // nonzero words of next_
+  std::vector<int> touched_;       // words of reached_ set by the query
+  std::vector<std::pair<std::pair<int, int>, uint64_t>>
+      pending_; // words handed new cells by the flood, not filled yet
+  std::vector<uint32_t> computed_; // layer a word was last computed in
+  uint32_t round_;                 // layers computed on this object
+};
@@ -0,0 +1,134 @@
+/* Copyright (C)
+ * 2019 - Bhargav Dandamudi
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the 'Software'), to deal in the Software without
+ * restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit
+ * persons to whom the Software is furnished to do so,subject to
+ * the following conditions:
+ * The above copyright notice and this permission notice shall
+ * be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED ''AS IS'', WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR
+ * ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM,OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+/**
+ * @file BucketQueue.h
+ * @brief  Bucket queue (Dial's algorithm) for small integer priorities
+ * @author Bhargav Dandamudi
+ * @version 1
+ * @date 2019-04-22
+ */
+#pragma once
+#include <cstddef>
+#include <vector>
+
+/* ----------------------------------------------------------------*/
+/**
+ * @brief  Open list for searches whose priorities are small non negative
+ *          integers, like f costs on a unit cost grid with Manhattan
+ *          distance. Bucket f holds the cell indices queued with priority
+ *          f; a cursor remembers the lowest bucket which may be non empty.
+ *
+ *          Push and pop are O(1) amortized, the cursor only walks forward
+ *          while the priorities popped do not decrease, which holds for
+ *          astar with a consistent heuristic. Inside a bucket the last
+ *          cell pushed is popped first (LIFO), which favors the deepest
+ *          cells among equal f costs and keeps the working set hot.
+ *
+ *          Like the set open list it does not support decrease-key: an
+ *          improved cell is pushed again and the stale entry has to be
+ *          skipped by the caller.
+ */
+/* ----------------------------------------------------------------*/
+class BucketQueue {
+public:
+  BucketQueue() : cursor_(0), size_(0) {}
+
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  Removes all entries, the buckets keep their memory
+   */
+  /* ----------------------------------------------------------------*/
+  void clear() {
+    for (int b = cursor_; b < int(buckets_.size()) && size_ > 0; ++b) {
+      size_ -= int(buckets_[b].size());
+      buckets_[b].clear();
+    }
+    cursor_ = 0;
+    size_ = 0;
+  }
+
+  bool empty() const { return size_ == 0; }
+  int size() const { return size_; }
+  // bytes allocated for the buckets and their entries
+  std::size_t getMemoryUsage() const {
+    std::size_t bytes = buckets_.capacity() * sizeof(std::vector<int>);
+    for (const auto &bucket : buckets_) {
+      bytes += bucket.capacity() * sizeof(int);
+    }
+    return bytes;
+  }
+
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  Queues a cell
+   *
+   * @param int cell index
+   * @param int priority, >= 0
+   */
+  /* ----------------------------------------------------------------*/
+  void push(int index, int priority) {
+    if (priority >= int(buckets_.size())) {
+      buckets_.resize(priority + 1);
+    }
+    buckets_[priority].push_back(index);
+    if (priority < cursor_) {
+      cursor_ = priority;
+    }
+    size_++;
+  }
+
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  lowest queued priority, the queue must not be empty
+   */
+  /* ----------------------------------------------------------------*/
+  int topPriority() {
+    while (buckets_[cursor_].empty()) {
+      cursor_++;
+    }
+    return cursor_;
+  }
+
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  Removes the entry with the lowest priority, the latest pushed
+   *          one on ties
+   *
+   * @return cell index of the removed entry
+   */
+  /* ----------------------------------------------------------------*/
+  int pop() {
+    std::vector<int> &bucket = buckets_[topPriority()];
+    int index = bucket.back();
+    bucket.pop_back();
+    size_--;
+    return index;
+  }
+
+private:
+  std::vector<std::vector<int>> buckets_; // cell indices by priority
+  int cursor_; // no entry has a lower priority than this
+  int size_;
+};
@@ -0,0 +1,153 @@
+/* Copyright (C)
+ * 2019 - Bhargav Dandamudi
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the 'Software'), to deal in the Software without
+ * restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit
+ * persons to whom the Software is furnished to do so,subject to
+ * the following conditions:
+ * The above copyright notice and this permission notice shall
+ * be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED ''AS IS'', WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR
+ * ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM,OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+/**
+ * @file ComponentIndex.h
+ * @brief  Connected component labels of the free cells of a map
+ * @author Bhargav Dandamudi
+ * @version 1
+ * @date 2019-04-20
+ */
+#pragma once
+#include "./GridView.h"
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/* ----------------------------------------------------------------*/
+/**
+ * @brief  Labels every free cell with the 4-connected region it belongs
+ *          to, so a planner can tell in O(1) that a goal is unreachable
+ *          instead of expanding the whole region of the start.
+ *
+ *          The labels are computed with a two pass union-find scan. After
+ *          cells of the map change, updateCells() relabels only the regions
+ *          touching them: a freed cell merges its neighbor regions into the
+ *          largest one, a blocked cell floods its old region again in case
+ *          it was split.
+ *
+ *          The labels hold for the map version the index was built or last
+ *          updated for; planners ask matches() before trusting them, since
+ *          another map of the same size has other regions.
+ *
+ *          Lookups only read the label table, so planners on several
+ *          threads can share one index as long as nobody updates it.
+ */
+/* ----------------------------------------------------------------*/
+class ComponentIndex {
+public:
+  ComponentIndex();
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  Constructor, labels the map
+   *
+   * @param GridView world map, must outlive the index
+   */
+  /* ----------------------------------------------------------------*/
+  explicit ComponentIndex(const GridView &);
+
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  Labels all cells of a map from scratch
+   *
+   * @param GridView world map, must outlive the index
+   */
+  /* ----------------------------------------------------------------*/
+  void build(const GridView &);
+
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  Relabels the regions around changed cells and moves the index
+   *          to the new map version. Call after changing the viewed map;
+   *          cells outside the map are skipped.
+   *
+   * @param std::vector<std::pair<int,int>> changed cell locations
+   * @param uint64_t map version after the change
+   */
+  /* ----------------------------------------------------------------*/
+  void updateCells(const std::vector<std::pair<int, int>> &, uint64_t);
+
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  Tells if the labels were computed for this map
+   *
+   * @param GridView world map
+   *
+   * @return true if height, width and the non-zero version match
+   */
+  /* ----------------------------------------------------------------*/
+  bool matches(const GridView &) const;
+
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  Tells if a path between two cells can exist
+   *
+   * @param std::pair location
+   * @param std::pair location
+   *
+   * @return true if both cells are free and in the same region
+   */
+  /* ----------------------------------------------------------------*/
+  bool isConnected(std::pair<int, int>, std::pair<int, int>) const;
+
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  getter function for the label of a cell
+   *
+   * @param int cell index
+   *
+   * @return region label, -1 for obstacles
+   */
+  /* ----------------------------------------------------------------*/
+  int getLabel(int cell) const { return labels_[cell]; }
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  getter function for the number of free cells in a region
+   */
+  /* ----------------------------------------------------------------*/
+  int getComponentSize(int label) const { return sizes_[label]; }
+  int getComponentCount() const { return component_count_; }
+  int getCellCount() const { return int(labels_.size()); }
+  uint64_t getVersion() const { return version_; }
+
+private:
+  // union-find root with path halving, used while building only
+  static int findRoot(std::vector<int> &, int);
+  int newLabel(int);
+  void retireLabel(int);
+  // orthogonal neighbors of a cell inside the map, returns their count
+  int findNeighbors(int, int *) const;
+  // gives every cell reachable from the source the label, returns the count
+  // of relabelled cells and collects the labels they had in replaced_
+  int flood(int, int);
+
+  GridView world_map_;
+  std::vector<int> labels_;      // region of every cell, -1 if occupied
+  std::vector<int> sizes_;       // cells per label, 0 for retired labels
+  std::vector<int> free_labels_; // retired labels available for reuse
+  int component_count_;
+  uint64_t version_; // map version the labels hold for, 0 if unknown
+  std::vector<int> queue_;    // flood fill work list
+  std::vector<int> replaced_; // labels overwritten by the last flood
+};
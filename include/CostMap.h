@@ -0,0 +1,138 @@
+/* Copyright (C)
+ * 2019 - Bhargav Dandamudi
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the 'Software'), to deal in the Software without
+ * restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit
+ * persons to whom the Software is furnished to do so,subject to
+ * the following conditions:
+ * The above copyright notice and this permission notice shall
+ * be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED ''AS IS'', WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR
+ * ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM,OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+/**
+ * @file CostMap.h
+ * @brief  Per cell traversal costs stored as a contiguous uint8 grid
+ * @author Bhargav Dandamudi
+ * @version 1
+ * @date 2019-04-23
+ */
+#pragma once
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/* ----------------------------------------------------------------*/
+/**
+ * @brief  Traversal costs like a ROS costmap: 0 (free floor) to 254, and
+ *          LETHAL (255) for cells which must not be entered. Stepping into
+ *          a cell costs 1 + its value, so a map of zeros gives the unit
+ *          costs of the plain grid.
+ *
+ *          Cells are one byte each in row-major order without padding, so
+ *          a cell index of the occupancy grid is also the index here. Bulk
+ *          updates and obstacle inflation run as SSE2 kernels over whole
+ *          rows, with a scalar fallback on other targets.
+ *
+ *          The lowest cost in the map is kept up to date on every change;
+ *          planners scale their heuristic by 1 + that value so it stays
+ *          admissible.
+ */
+/* ----------------------------------------------------------------*/
+class CostMap {
+public:
+  static const uint8_t LETHAL = 255;
+
+  CostMap();
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  Constructor
+   *
+   * @param int height
+   * @param int width
+   * @param uint8_t cost of every cell
+   */
+  /* ----------------------------------------------------------------*/
+  CostMap(int, int, uint8_t = 0);
+
+  int getHeight() const { return height_; }
+  int getWidth() const { return width_; }
+  int getCellCount() const { return height_ * width_; }
+  const uint8_t *getCosts() const { return costs_.data(); }
+  uint8_t getCost(int index) const { return costs_[index]; }
+  bool isLethal(int index) const { return costs_[index] == LETHAL; }
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  getter function for the lowest cost of any cell, LETHAL if all
+   *          cells are lethal
+   */
+  /* ----------------------------------------------------------------*/
+  uint8_t getMinCost() const { return min_cost_; }
+
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  Sets the cost of one cell
+   *
+   * @param int cell index
+   * @param uint8_t cost
+   */
+  /* ----------------------------------------------------------------*/
+  void setCost(int, uint8_t);
+
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  Sets all cells of a rectangle to one cost, e.g. a floor zone
+   *
+   * @param std::pair top left cell location
+   * @param int height of the rectangle
+   * @param int width of the rectangle
+   * @param uint8_t cost
+   */
+  /* ----------------------------------------------------------------*/
+  void fill(std::pair<int, int>, int, int, uint8_t);
+
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  Raises the cells of a rectangle to at least the cost, cells
+   *          which cost more keep their value
+   *
+   * @param std::pair top left cell location
+   * @param int height of the rectangle
+   * @param int width of the rectangle
+   * @param uint8_t cost
+   */
+  /* ----------------------------------------------------------------*/
+  void raise(std::pair<int, int>, int, int, uint8_t);
+
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  Inflates lethal cells: a cell d steps (Manhattan) from the
+   *          nearest lethal cell is raised to at least 255 - d * decay,
+   *          capped at 254, for d up to radius
+   *
+   * @param int radius in cells
+   * @param uint8_t cost lost per step away from the obstacle
+   */
+  /* ----------------------------------------------------------------*/
+  void inflate(int, uint8_t);
+
+private:
+  void updateMinCost();
+
+  int height_;
+  int width_;
+  uint8_t min_cost_;
+  std::vector<uint8_t> costs_;
+};
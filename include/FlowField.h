@@ -0,0 +1,128 @@
+/* Copyright (C)
+ * 2019 - Bhargav Dandamudi
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the 'Software'), to deal in the Software without
+ * restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit
+ * persons to whom the Software is furnished to do so,subject to
+ * the following conditions:
+ * The above copyright notice and this permission notice shall
+ * be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED ''AS IS'', WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR
+ * ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM,OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+/**
+ * @file FlowField.h
+ * @brief  Distance and next step field towards one goal
+ * @author Bhargav Dandamudi
+ * @version 1
+ * @date 2019-04-24
+ */
+#pragma once
+#include "./GridView.h"
+#include <atomic>
+#include <cstdint>
+#include <stack>
+#include <utility>
+#include <vector>
+
+/* ----------------------------------------------------------------*/
+/**
+ * @brief  Breadth first distances from every cell to one goal, with the
+ *          first step of a shortest (four connected) path stored per cell.
+ *          Built once per goal and map, it gives the path of any number of
+ *          agents heading to that goal in O(path length) without a search.
+ *
+ *          The wavefront grows layer by layer on a pool of threads. Threads
+ *          take chunks of the current layer from a shared counter and claim
+ *          cells with a compare and swap on their distance, so every cell
+ *          joins the next layer once.
+ */
+/* ----------------------------------------------------------------*/
+class FlowField {
+public:
+  static const uint32_t UNREACHABLE = 0xffffffffu;
+  static const uint8_t NO_STEP = 0xff; // at the goal or unreachable
+
+  FlowField();
+
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  Computes the field of the goal on the map, replacing the
+   *          previous one
+   *
+   * @param GridView world map
+   * @param std::pair goal location
+   * @param int number of threads, 0 uses one per hardware thread
+   */
+  /* ----------------------------------------------------------------*/
+  void build(const GridView &, std::pair<int, int>, int = 0);
+
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  Follows the next steps from a start location to the goal
+   *
+   * @param std::pair start location
+   *
+   * @return path in the format of optimalPlanner::search, only the start
+   *          if the goal can not be reached
+   */
+  /* ----------------------------------------------------------------*/
+  std::stack<std::pair<int, int>> path(std::pair<int, int>) const;
+
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  Number of steps from the location to the goal
+   *
+   * @param std::pair location
+   *
+   * @return steps, UNREACHABLE for blocked cells and other regions
+   */
+  /* ----------------------------------------------------------------*/
+  uint32_t getDistance(std::pair<int, int>) const;
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  First step of a shortest path from the location
+   *
+   * @param std::pair location
+   *
+   * @return next location, the location itself at the goal or if it can
+   *          not reach the goal
+   */
+  /* ----------------------------------------------------------------*/
+  std::pair<int, int> nextStep(std::pair<int, int>) const;
+
+  std::pair<int, int> getGoal() const { return goal_; }
+  int getHeight() const { return height_; }
+  int getWidth() const { return width_; }
+
+private:
+  // layer loop run by every thread of build
+  void grow(int, int);
+
+  int height_;
+  int width_;
+  std::pair<int, int> goal_;
+  std::vector<std::atomic<uint32_t>> distance_; // steps to the goal per cell
+  std::vector<uint8_t> direction_; // FourConnected move of the next step
+
+  // wavefront shared by the threads while building
+  const GridView *map_;
+  std::vector<int> layer_;                   // cells of the current layer
+  std::vector<std::vector<int>> next_layer_; // next layer found per thread
+  std::atomic<int> next_chunk_;              // next chunk of layer_ to take
+  std::atomic<int> next_row_;                // next row of the step pass
+  std::atomic<int> arrived_;                 // threads waiting at the barrier
+  std::atomic<int> barrier_round_;
+};
@@ -0,0 +1,117 @@
+/* Copyright (C)
+ * 2019 - Bhargav Dandamudi
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the 'Software'), to deal in the Software without
+ * restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit
+ * persons to whom the Software is furnished to do so,subject to
+ * the following conditions:
+ * The above copyright notice and this permission notice shall
+ * be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED ''AS IS'', WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR
+ * ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM,OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+/**
+ * @file FlowFieldCache.h
+ * @brief  Flow fields kept per goal and map version
+ * @author Bhargav Dandamudi
+ * @version 1
+ * @date 2019-04-24
+ */
+#pragma once
+#include "./FlowField.h"
+#include "./GridView.h"
+#include <cstdint>
+#include <future>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+/* ----------------------------------------------------------------*/
+/**
+ * @brief  Keeps the flow fields of the most recently used goals. A field
+ *          is reused while it was built for the same goal, map size and
+ *          map version, else it is built again. The version is the one of
+ *          the view, GridView::getVersion, which tells maps apart as well
+ *          as edits of one map; views of version 0 (raw buffers) are built
+ *          again on every call. At most capacity fields are kept, the
+ *          least recently used one is dropped first.
+ *
+ *          get may be called from any thread. Fields are built with the
+ *          cache unlocked, so builds for different goals run at once, while
+ *          agents asking for a goal being built wait for that build. A
+ *          failed build throws to all of them and is not kept. Handed out
+ *          fields stay valid after they are dropped from the cache.
+ */
+/* ----------------------------------------------------------------*/
+class FlowFieldCache {
+public:
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  Constructor
+   *
+   * @param int number of fields kept
+   * @param int threads used to build a field, 0 uses one per hardware
+   *            thread
+   */
+  /* ----------------------------------------------------------------*/
+  explicit FlowFieldCache(int = 8, int = 0);
+
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  Field of the goal on the map, built if there is none for the
+   *          version of the view. Exceptions of the build are passed on.
+   *
+   * @param GridView world map
+   * @param std::pair goal location
+   *
+   * @return flow field
+   */
+  /* ----------------------------------------------------------------*/
+  std::shared_ptr<const FlowField> get(const GridView &, std::pair<int, int>);
+
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  Drops all fields
+   */
+  /* ----------------------------------------------------------------*/
+  void clear();
+
+  int size();
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  getter function for the number of fields built so far, the
+   *          calls of get which did not find a current field
+   */
+  /* ----------------------------------------------------------------*/
+  int getBuildCount();
+
+private:
+  struct Entry {
+    std::pair<int, int> goal;
+    int height;
+    int width;
+    uint64_t version;
+    int build; // number of the build, tells a rebuilt entry apart
+    // ready once the build is done
+    std::shared_future<std::shared_ptr<const FlowField>> field;
+  };
+
+  std::mutex mutex_;
+  std::list<Entry> entries_; // most recently used first
+  int capacity_;
+  int threads_;
+  int builds_;
+};
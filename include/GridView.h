@@ -0,0 +1,161 @@
+/* Copyright (C)
+ * 2019 - Bhargav Dandamudi
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the 'Software'), to deal in the Software without
+ * restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit
+ * persons to whom the Software is furnished to do so,subject to
+ * the following conditions:
+ * The above copyright notice and this permission notice shall
+ * be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED ''AS IS'', WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR
+ * ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM,OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+/**
+ * @file GridView.h
+ * @brief  Non-owning read-only view of a row-major map buffer
+ * @author Bhargav Dandamudi
+ * @version 1
+ * @date 2019-04-12
+ */
+#pragma once
+#include "./OccupancyGrid.h"
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+/* ----------------------------------------------------------------*/
+/**
+ * @brief  View of a map owned by somebody else: pointer to the first cell,
+ *          dimensions and row stride. Copying a view never copies cells, so
+ *          it can be handed to the planners for every query. The owner must
+ *          keep the buffer alive and unchanged while the view is used.
+ *
+ *          Cells are addressed like OccupancyGrid: (y,x) positions or linear
+ *          index y * width + x, independent of the stride. Rows are found
+ *          with 64 bit offsets, so (y,x) reads work on mapped files of more
+ *          than 2^31 cells (see TiledGrid); linear indices and
+ *          getCellCount are int and need at most INT_MAX cells.
+ */
+/* ----------------------------------------------------------------*/
+class GridView {
+public:
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  Default constructor, empty view
+   */
+  /* ----------------------------------------------------------------*/
+  GridView();
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  View over one byte per cell
+   *
+   * @param const uint8_t* first cell of the map
+   * @param int height (number of rows)
+   * @param int width (number of columns)
+   * @param int bytes between the start of two rows, >= width
+   * @param uint64_t version of the cells, 0 if unknown
+   */
+  /* ----------------------------------------------------------------*/
+  GridView(const uint8_t *, int, int, int, uint64_t = 0);
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  View over one bit per cell, bit x % 64 of word x / 64 in a row
+   *
+   * @param const uint64_t* first word of the map
+   * @param int height (number of rows)
+   * @param int width (number of columns)
+   * @param int words between the start of two rows
+   * @param uint64_t version of the cells, 0 if unknown
+   */
+  /* ----------------------------------------------------------------*/
+  GridView(const uint64_t *, int, int, int, uint64_t = 0);
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  View over an occupancy grid, the grid must outlive the view
+   */
+  /* ----------------------------------------------------------------*/
+  GridView(const OccupancyGrid &); // implicit, grids are passed as views
+
+  int getHeight() const { return height_; }
+  int getWidth() const { return width_; }
+  int getCellCount() const { return height_ * width_; }
+  int getStride() const { return stride_; }
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  Version of the viewed grid when the view was taken (see
+   *          OccupancyGrid::getVersion) or of the mapped file, 0 for views
+   *          over raw buffers whose version is unknown. Planners and caches
+   *          redo their per map work on every use of a version 0 view.
+   */
+  /* ----------------------------------------------------------------*/
+  uint64_t getVersion() const { return version_; }
+  CellStorage getStorage() const { return storage_; }
+  const uint8_t *getBytes() const { return bytes_; }
+  const uint64_t *getWords() const { return words_; }
+
+  int toIndex(std::pair<int, int> position) const {
+    return position.first * width_ + position.second;
+  }
+  std::pair<int, int> toPosition(int index) const {
+    return std::make_pair(index / width_, index % width_);
+  }
+  bool isInside(std::pair<int, int> position) const {
+    return position.first >= 0 && position.second >= 0 &&
+           position.first < height_ && position.second < width_;
+  }
+
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  Value of the cell at (y,x), always 0 or 1 for bit views
+   */
+  /* ----------------------------------------------------------------*/
+  int getValue(std::pair<int, int> position) const {
+    std::size_t row = std::size_t(position.first) * std::size_t(stride_);
+    if (storage_ == CellStorage::BYTE) {
+      return bytes_[row + position.second];
+    }
+    uint64_t word = words_[row + (position.second >> 6)];
+    return int((word >> (position.second & 63)) & 1u);
+  }
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  Value of the cell with given linear index
+   */
+  /* ----------------------------------------------------------------*/
+  int getValue(int index) const {
+    if (storage_ == CellStorage::BYTE && stride_ == width_) {
+      return bytes_[index];
+    }
+    return getValue(toPosition(index));
+  }
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  To check for obstacle (value 1)
+   */
+  /* ----------------------------------------------------------------*/
+  bool isOccupied(std::pair<int, int> position) const {
+    return getValue(position) == 1;
+  }
+  bool isOccupied(int index) const { return getValue(index) == 1; }
+
+private:
+  const uint8_t *bytes_;  // BYTE cells, nullptr for bit views
+  const uint64_t *words_; // BIT cells, nullptr for byte views
+  int height_;
+  int width_;
+  int stride_; // bytes (BYTE) or words (BIT) per row
+  CellStorage storage_;
+  uint64_t version_;
+};
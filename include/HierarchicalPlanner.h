@@ -0,0 +1,155 @@
+/* Copyright (C)
+ * 2019 - Bhargav Dandamudi
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the 'Software'), to deal in the Software without
+ * restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit
+ * persons to whom the Software is furnished to do so,subject to
+ * the following conditions:
+ * The above copyright notice and this permission notice shall
+ * be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED ''AS IS'', WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR
+ * ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM,OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+/**
+ * @file HierarchicalPlanner.h
+ * @brief  HPA* style cluster abstraction on top of optimalPlanner
+ * @author Bhargav Dandamudi
+ * @version 1
+ * @date 2019-04-17
+ */
+#pragma once
+#include "./GridView.h"
+#include "./IndexedHeap.h"
+#include "./OccupancyGrid.h"
+#include "./SearchContext.h"
+#include "./optimalPlanner.h"
+#include <stack>
+#include <utility>
+#include <vector>
+
+/* ----------------------------------------------------------------*/
+/**
+ * @brief  Hierarchical path planner for large maps (HPA*).
+ *
+ *          The map is cut into square clusters. Along every border between
+ *          two clusters each run of cells free on both sides is an entrance:
+ *          short runs get one transition in the middle, runs of 6 or more
+ *          cells one at each end. Transition cells are the nodes of an
+ *          abstract graph; inside a cluster they are linked with the path
+ *          costs optimalPlanner finds within the cluster, across a border
+ *          with cost 1.
+ *
+ *          A query links start and goal to the nodes of their clusters,
+ *          searches the abstract graph and then refines only the segments
+ *          of the abstract path with optimalPlanner inside one cluster each.
+ *          Paths are close to, but not always exactly, the shortest ones.
+ */
+/* ----------------------------------------------------------------*/
+class HierarchicalPlanner {
+public:
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  Builds the abstraction of the map
+   *
+   * @param GridView world map, must outlive the planner
+   * @param int cluster side length in cells
+   */
+  /* ----------------------------------------------------------------*/
+  explicit HierarchicalPlanner(const GridView &, int = 16);
+
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  Searches a path between two cells
+   *
+   * @param std::pair start location
+   * @param std::pair goal location
+   *
+   * @return stack with the path, start on top, like optimalPlanner::search.
+   *          Only the start when no path exists or a pose is outside the
+   *          map or blocked.
+   */
+  /* ----------------------------------------------------------------*/
+  std::stack<std::pair<int, int>> search(std::pair<int, int>,
+                                         std::pair<int, int>);
+
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  Rebuilds the clusters affected by changed cells: the clusters
+   *          holding them and their four neighbors, whose shared borders
+   *          may have gained or lost entrances. Call after changing the
+   *          viewed map.
+   *
+   * @param std::vector<std::pair<int,int>> changed cell locations
+   */
+  /* ----------------------------------------------------------------*/
+  void updateCells(const std::vector<std::pair<int, int>> &);
+
+  int getClusterSize() { return cluster_size_; }
+  int getClusterCount() { return int(clusters_.size()); }
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  getter function for the number of abstract graph nodes
+   */
+  /* ----------------------------------------------------------------*/
+  int getAbstractNodeCount();
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  getter function for the clusters rebuilt by the last update
+   */
+  /* ----------------------------------------------------------------*/
+  int getRebuiltClusters() { return rebuilt_clusters_; }
+
+private:
+  struct Cluster {
+    int top, left, height, width;       // cells covered by the cluster
+    std::vector<int> nodes;             // cell indices of abstract nodes
+    std::vector<std::vector<float>> costs; // path cost between nodes,
+                                           // FLT_MAX if not connected
+  };
+
+  int clusterOf(int);
+  bool isFree(std::pair<int, int>);
+  // recomputes the transitions on the right/bottom border of a cluster
+  void findRightEntrances(int);
+  void findBottomEntrances(int);
+  // collects the nodes of a cluster and links them inside the cluster
+  void buildCluster(int);
+  // view of the cells of one cluster, positions relative to its corner
+  GridView clusterView(int);
+  // path cost between two cells of a cluster, FLT_MAX if not connected
+  float clusterCost(int, int, int);
+  // abstract neighbors of a cell with edge costs, into neighbors_
+  void findNeighbors(int);
+
+  GridView world_map_;
+  int cluster_size_;
+  int clusters_y_; // clusters per column
+  int clusters_x_; // clusters per row
+  std::vector<Cluster> clusters_;
+  // cells on the own side of the transitions of every cluster
+  std::vector<std::vector<int>> right_entrances_;
+  std::vector<std::vector<int>> bottom_entrances_;
+  int rebuilt_clusters_;
+
+  optimalPlanner local_planner_;   // searches inside one cluster
+  OccupancyGrid cluster_copy_;     // cluster cells when the map is bit packed
+  SearchContext abstract_context_; // abstract search state, by cell index
+  IndexedHeap<4> abstract_open_;
+  int query_start_;
+  int query_goal_;
+  std::vector<std::pair<int, float>> start_links_; // start to its cluster
+  std::vector<std::pair<int, float>> goal_links_;  // goal cluster to goal
+  std::vector<std::pair<int, float>> neighbors_;
+};
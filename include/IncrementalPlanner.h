@@ -0,0 +1,152 @@
+/* Copyright (C)
+ * 2019 - Bhargav Dandamudi
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the 'Software'), to deal in the Software without
+ * restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit
+ * persons to whom the Software is furnished to do so,subject to
+ * the following conditions:
+ * The above copyright notice and this permission notice shall
+ * be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED ''AS IS'', WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR
+ * ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM,OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+/**
+ * @file IncrementalPlanner.h
+ * @brief  D* Lite planner which repairs its search after map changes
+ * @author Bhargav Dandamudi
+ * @version 1
+ * @date 2019-04-18
+ */
+#pragma once
+#include "./IndexedHeap.h"
+#include "./OccupancyGrid.h"
+#include <stack>
+#include <utility>
+#include <vector>
+
+/* ----------------------------------------------------------------*/
+/**
+ * @brief  Incremental planner (D* Lite) for a fixed goal.
+ *
+ *          The search runs backwards from the goal and keeps for every cell
+ *          its distance g and the one step lookahead rhs between calls.
+ *          Changing a cell only makes the cell and its neighbors
+ *          inconsistent; replan() then repairs the part of the search tree
+ *          below them instead of searching again from scratch. Moving the
+ *          start does not invalidate anything, the queue keys are corrected
+ *          lazily through the km offset.
+ *
+ *          The planner keeps its own copy of the map, changes go through
+ *          updateCell().
+ */
+/* ----------------------------------------------------------------*/
+class IncrementalPlanner {
+public:
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  Constructor
+   *
+   * @param OccupancyGrid world map, copied
+   * @param std::pair start location
+   * @param std::pair goal location
+   */
+  /* ----------------------------------------------------------------*/
+  IncrementalPlanner(const OccupancyGrid &, std::pair<int, int>,
+                     std::pair<int, int>);
+  IncrementalPlanner(const std::vector<std::vector<int>> &,
+                     std::pair<int, int>, std::pair<int, int>);
+
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  Plans from the current start, the first call does the full
+   *          search
+   *
+   * @return stack with the path, start on top, like optimalPlanner::search.
+   *          Only the start when no path exists or the planner is invalid.
+   */
+  /* ----------------------------------------------------------------*/
+  std::stack<std::pair<int, int>> search();
+
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  Changes a cell of the map and marks the cells whose lookahead
+   *          depends on it. The search itself is repaired by replan().
+   *          Cells outside the map are ignored.
+   *
+   * @param std::pair cell location
+   * @param int new value, 1 = obstacle
+   */
+  /* ----------------------------------------------------------------*/
+  void updateCell(std::pair<int, int>, int);
+
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  Moves the start and repairs the search after map changes
+   *
+   * @param std::pair new start location
+   *
+   * @return path from the new start, same format as search(), only the
+   *          start when it is outside the map
+   */
+  /* ----------------------------------------------------------------*/
+  std::stack<std::pair<int, int>> replan(std::pair<int, int>);
+
+  std::pair<int, int> getStartingPoint() { return start_; }
+  std::pair<int, int> getGoalPoint() { return goal_; }
+  const OccupancyGrid &getWorldMap() { return world_map_; }
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  getter function for the cells expanded by the last search or
+   *          replan
+   */
+  /* ----------------------------------------------------------------*/
+  int getExpandedNodes() { return expanded_nodes_; }
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  false if the start or goal given to the constructor was
+   *          outside the map or on an obstacle
+   */
+  /* ----------------------------------------------------------------*/
+  bool isValid() { return valid_; }
+
+private:
+  // inside the map and not an obstacle
+  bool isFree(std::pair<int, int>);
+  int heuristic(int, int);
+  // cost of the step between two neighbor cells, INFINITE_COST if blocked
+  int stepCost(int, int);
+  // orthogonal neighbors of a cell inside the map, returns their count
+  int findNeighbors(int, int *);
+  // queue key, (min(g, rhs) + h + km, min(g, rhs)) packed in one double
+  double calculateKey(int);
+  // rhs from the successors of a cell
+  int lookahead(int);
+  void updateVertex(int);
+  void computeShortestPath();
+
+  OccupancyGrid world_map_;
+  std::pair<int, int> start_;
+  std::pair<int, int> goal_;
+  int start_index_;
+  int goal_index_;
+  int last_start_index_; // start when km was last updated
+  int km_;               // sum of heuristic distances the start moved
+  double key_scale_;     // > any second key component
+  std::vector<int> g_;
+  std::vector<int> rhs_;
+  IndexedHeap<4> open_;
+  int expanded_nodes_;
+  bool valid_; // start and goal were free cells of the map
+};
@@ -0,0 +1,270 @@
+/* Copyright (C)
+ * 2019 - Bhargav Dandamudi
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the 'Software'), to deal in the Software without
+ * restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit
+ * persons to whom the Software is furnished to do so,subject to
+ * the following conditions:
+ * The above copyright notice and this permission notice shall
+ * be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED ''AS IS'', WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR
+ * ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM,OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+/**
+ * @file IndexedHeap.h
+ * @brief  d-ary min heap keyed by cell index with decrease-key support
+ * @author Bhargav Dandamudi
+ * @version 1
+ * @date 2019-04-10
+ */
+#pragma once
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+/* ----------------------------------------------------------------*/
+/**
+ * @brief  Min heap of (priority, cell index) entries. Every cell index can be
+ *          in the heap at most once; a position table maps each index to its
+ *          slot so that the priority of a queued cell can be lowered in place
+ *          instead of inserting a duplicate entry.
+ *
+ *          Ties on priority are broken by the smaller cell index, which is
+ *          the same order std::set<DoublePair> gives for row-major indices.
+ *
+ * @tparam Arity number of children per heap node (2 = binary, 4 = 4-ary)
+ */
+/* ----------------------------------------------------------------*/
+template <int Arity> class IndexedHeap {
+  static_assert(Arity >= 2, "heap arity must be at least 2");
+
+public:
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  Constructor
+   *
+   * @param int number of cell indices the heap can hold, [0, capacity)
+   */
+  /* ----------------------------------------------------------------*/
+  explicit IndexedHeap(int capacity = 0) : position_(capacity, -1) {}
+
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  Changes the range of accepted cell indices, empties the heap
+   *
+   * @param int new capacity
+   */
+  /* ----------------------------------------------------------------*/
+  void resize(int capacity) {
+    heap_.clear();
+    position_.assign(capacity, -1);
+  }
+
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  Removes all entries. Costs O(size), not O(capacity)
+   */
+  /* ----------------------------------------------------------------*/
+  void clear() {
+    for (const auto &entry : heap_) {
+      position_[entry.second] = -1;
+    }
+    heap_.clear();
+  }
+
+  bool empty() const { return heap_.empty(); }
+  int size() const { return int(heap_.size()); }
+  int capacity() const { return int(position_.size()); }
+  // bytes allocated for entries and positions
+  std::size_t getMemoryUsage() const {
+    return heap_.capacity() * sizeof(Entry) +
+           position_.capacity() * sizeof(int);
+  }
+  bool contains(int index) const { return position_[index] != -1; }
+
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  Inserts the cell, or lowers its priority if already queued.
+   *          A priority higher than the queued one is ignored.
+   *
+   * @param int cell index
+   * @param double priority (f cost)
+   */
+  /* ----------------------------------------------------------------*/
+  void push(int index, double priority) {
+    int slot = position_[index];
+    if (slot == -1) {
+      heap_.push_back(std::make_pair(priority, index));
+      siftUp(int(heap_.size()) - 1);
+    } else if (priority < heap_[slot].first) {
+      heap_[slot].first = priority;
+      siftUp(slot);
+    }
+  }
+
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  Lowers the priority of a cell which is already in the heap
+   *
+   * @param int cell index
+   * @param double new priority, must not be higher than the current one
+   */
+  /* ----------------------------------------------------------------*/
+  void decreaseKey(int index, double priority) {
+    int slot = position_[index];
+    heap_[slot].first = priority;
+    siftUp(slot);
+  }
+
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  Inserts the cell or moves it to a new priority, higher or lower
+   *
+   * @param int cell index
+   * @param double priority
+   */
+  /* ----------------------------------------------------------------*/
+  void update(int index, double priority) {
+    int slot = position_[index];
+    if (slot == -1) {
+      heap_.push_back(std::make_pair(priority, index));
+      siftUp(int(heap_.size()) - 1);
+    } else if (priority < heap_[slot].first) {
+      heap_[slot].first = priority;
+      siftUp(slot);
+    } else {
+      heap_[slot].first = priority;
+      siftDown(slot);
+    }
+  }
+
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  Removes a queued cell wherever it is in the heap
+   *
+   * @param int cell index
+   */
+  /* ----------------------------------------------------------------*/
+  void remove(int index) {
+    int slot = position_[index];
+    position_[index] = -1;
+    Entry last = heap_.back();
+    heap_.pop_back();
+    if (slot == int(heap_.size())) {
+      return;
+    }
+    heap_[slot] = last;
+    position_[last.second] = slot;
+    if (slot > 0 && less(last, heap_[(slot - 1) / Arity])) {
+      siftUp(slot);
+    } else {
+      siftDown(slot);
+    }
+  }
+
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  priority of a queued cell
+   */
+  /* ----------------------------------------------------------------*/
+  double priority(int index) const { return heap_[position_[index]].first; }
+
+  int top() const { return heap_.front().second; }
+  double topPriority() const { return heap_.front().first; }
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  cell index in a slot of the heap storage, slots 0 to size() - 1
+   *          visit every queued cell once in no particular order
+   */
+  /* ----------------------------------------------------------------*/
+  int at(int slot) const { return heap_[slot].second; }
+
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  Removes the entry with the lowest priority
+   *
+   * @return cell index of the removed entry
+   */
+  /* ----------------------------------------------------------------*/
+  int pop() {
+    int index = heap_.front().second;
+    position_[index] = -1;
+    if (heap_.size() > 1) {
+      heap_.front() = heap_.back();
+      heap_.pop_back();
+      position_[heap_.front().second] = 0;
+      siftDown(0);
+    } else {
+      heap_.pop_back();
+    }
+    return index;
+  }
+
+private:
+  typedef std::pair<double, int> Entry; // (priority, cell index)
+
+  static bool less(const Entry &a, const Entry &b) {
+    return a.first < b.first || (a.first == b.first && a.second < b.second);
+  }
+
+  // moves the entry at slot towards the root, shifting parents down
+  void siftUp(int slot) {
+    Entry moving = heap_[slot];
+    while (slot > 0) {
+      int parent = (slot - 1) / Arity;
+      if (!less(moving, heap_[parent])) {
+        break;
+      }
+      heap_[slot] = heap_[parent];
+      position_[heap_[slot].second] = slot;
+      slot = parent;
+    }
+    heap_[slot] = moving;
+    position_[moving.second] = slot;
+  }
+
+  // moves the entry at slot towards the leaves, shifting children up
+  void siftDown(int slot) {
+    Entry moving = heap_[slot];
+    int count = int(heap_.size());
+    while (true) {
+      int first_child = slot * Arity + 1;
+      if (first_child >= count) {
+        break;
+      }
+      int last_child = first_child + Arity;
+      if (last_child > count) {
+        last_child = count;
+      }
+      int best = first_child;
+      for (int c = first_child + 1; c < last_child; ++c) {
+        if (less(heap_[c], heap_[best])) {
+          best = c;
+        }
+      }
+      if (!less(heap_[best], moving)) {
+        break;
+      }
+      heap_[slot] = heap_[best];
+      position_[heap_[slot].second] = slot;
+      slot = best;
+    }
+    heap_[slot] = moving;
+    position_[moving.second] = slot;
+  }
+
+  std::vector<Entry> heap_;   // heap ordered entries
+  std::vector<int> position_; // slot of every cell index in heap_, -1 if absent
+};
@@ -0,0 +1,172 @@
+/* Copyright (C)
+ * 2019 - Bhargav Dandamudi
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the 'Software'), to deal in the Software without
+ * restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit
+ * persons to whom the Software is furnished to do so,subject to
+ * the following conditions:
+ * The above copyright notice and this permission notice shall
+ * be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED ''AS IS'', WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR
+ * ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM,OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+/**
+ * @file LandmarkHeuristic.h
+ * @brief  Landmark (ALT) distance tables for a tighter astar heuristic
+ * @author Bhargav Dandamudi
+ * @version 1
+ * @date 2019-04-19
+ */
+#pragma once
+#include "./GridView.h"
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+/* ----------------------------------------------------------------*/
+/**
+ * @brief  Differential heuristic from a few landmark cells.
+ *
+ *          For every landmark L the exact distance d(L, c) to every cell is
+ *          stored. By the triangle inequality |d(L, a) - d(L, b)| never
+ *          overestimates the distance between a and b, so the maximum over
+ *          all landmarks is an admissible and consistent heuristic. In
+ *          mazes and corridors it is far tighter than Manhattan distance.
+ *
+ *          Landmarks are spread along the map border, where they bound the
+ *          most queries, and their tables are filled by breadth first
+ *          searches running on parallel threads. Tables can be saved and
+ *          loaded again; a checksum of the cells ties a file to the map
+ *          version it was computed for.
+ */
+/* ----------------------------------------------------------------*/
+class LandmarkHeuristic {
+public:
+  static const uint32_t UNREACHABLE = 0xffffffffu;
+
+  LandmarkHeuristic();
+
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  Picks the landmarks and computes their distance tables
+   *
+   * @param GridView world map
+   * @param int number of landmarks
+   * @param int worker threads, 0 uses one per hardware thread
+   */
+  /* ----------------------------------------------------------------*/
+  void build(const GridView &, int = 8, int = 0);
+
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  Writes landmarks and tables to a binary file
+   *
+   * @param std::string file name
+   *
+   * @return false if the file could not be written
+   */
+  /* ----------------------------------------------------------------*/
+  bool save(const std::string &) const;
+
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  Reads tables written by save()
+   *
+   * @param std::string file name
+   * @param GridView map the tables have to belong to
+   *
+   * @return false if the file is missing, broken or was computed for a
+   *          different map; the current tables are kept then
+   */
+  /* ----------------------------------------------------------------*/
+  bool load(const std::string &, const GridView &);
+
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  Lower bound on the path length between two cells
+   *
+   * @param int cell index
+   * @param int cell index
+   *
+   * @return largest landmark bound, 0 without tables
+   */
+  /* ----------------------------------------------------------------*/
+  double estimate(int from, int to) const {
+    const uint32_t *a = distances_.data() + size_t(from) * landmarks_.size();
+    const uint32_t *b = distances_.data() + size_t(to) * landmarks_.size();
+    uint32_t best = 0;
+    for (size_t l = 0; l < landmarks_.size(); l++) {
+      if (a[l] == UNREACHABLE || b[l] == UNREACHABLE) {
+        continue;
+      }
+      uint32_t bound = a[l] > b[l] ? a[l] - b[l] : b[l] - a[l];
+      best = bound > best ? bound : best;
+    }
+    return double(best);
+  }
+
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  Tells if the tables were computed for this map
+   *
+   * @param GridView world map
+   *
+   * @return true if size and checksum match
+   */
+  /* ----------------------------------------------------------------*/
+  bool matches(const GridView &) const;
+
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  FNV-1a hash over the occupancy of all cells
+   *
+   * @param GridView world map
+   *
+   * @return checksum identifying the map version
+   */
+  /* ----------------------------------------------------------------*/
+  static uint64_t checksum(const GridView &);
+
+  int getCellCount() const { return height_ * width_; }
+  int getLandmarkCount() const { return int(landmarks_.size()); }
+  const std::vector<int> &getLandmarks() const { return landmarks_; }
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  getter function for a table entry
+   *
+   * @param int landmark number
+   * @param int cell index
+   *
+   * @return distance from the landmark, UNREACHABLE if not connected
+   */
+  /* ----------------------------------------------------------------*/
+  uint32_t getDistance(int landmark, int cell) const {
+    return distances_[size_t(cell) * landmarks_.size() + landmark];
+  }
+
+private:
+  // free cell closest to a location, -1 if the map is fully blocked
+  static int nearestFreeCell(const GridView &, std::pair<int, int>);
+  // breadth first search from one cell, distances in row-major order
+  static void distancesFrom(const GridView &, int, std::vector<uint32_t> &);
+
+  int height_;
+  int width_;
+  uint64_t checksum_;
+  std::vector<int> landmarks_;
+  // cell major, the distances of all landmarks to one cell lie together
+  std::vector<uint32_t> distances_;
+};
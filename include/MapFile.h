@@ -0,0 +1,190 @@
+/* Copyright (C)
+ * 2019 - Bhargav Dandamudi
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the 'Software'), to deal in the Software without
+ * restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit
+ * persons to whom the Software is furnished to do so,subject to
+ * the following conditions:
+ * The above copyright notice and this permission notice shall
+ * be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED ''AS IS'', WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR
+ * ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM,OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+/**
+ * @file MapFile.h
+ * @brief  Binary map files loaded through mmap, with PGM and MovingAI
+ *          converters
+ * @author Bhargav Dandamudi
+ * @version 1
+ * @date 2019-04-26
+ */
+#pragma once
+#include "./GridView.h"
+#include "./OccupancyGrid.h"
+#include <cstdint>
+#include <string>
+
+/* ----------------------------------------------------------------*/
+/**
+ * @brief  Maps stored on disk in the layout of OccupancyGrid, so a file
+ *          mapped into memory is used as a GridView without parsing or
+ *          copying. A 64 byte header comes first:
+ *
+ *            magic "GMAP", format version, height, width, cell storage
+ *            (0 BIT, 1 BYTE), row stride (words or bytes), resolution in
+ *            meters per cell, checksum of the cells, offset of the cells
+ *
+ *          followed by the rows, each BIT row padded to whole 64 bit words.
+ *          The cells are padded to a multiple of 8 bytes and the checksum
+ *          is FNV-1a over those words. All values are little endian; the
+ *          file is mapped without byte swapping, so only little endian
+ *          hosts are supported.
+ *
+ *          open() checks the header and the file size only, which keeps a
+ *          large map usable in milliseconds; verify() reads all cells and
+ *          compares the checksum. Height and width are below 2^31 each,
+ *          the cell count is not limited: maps of more than 2^31 cells are
+ *          read by (y,x), e.g. through TiledGrid.
+ */
+/* ----------------------------------------------------------------*/
+class MapFile {
+public:
+  MapFile();
+  ~MapFile();
+  MapFile(const MapFile &) = delete;
+  MapFile &operator=(const MapFile &) = delete;
+
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  Maps a map file read-only, closing the previous one
+   *
+   * @param std::string file name
+   *
+   * @return false if the file can not be mapped or is not a valid map file
+   */
+  /* ----------------------------------------------------------------*/
+  bool open(const std::string &);
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  Unmaps the file, views handed out must not be used after
+   */
+  /* ----------------------------------------------------------------*/
+  void close();
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  Reads all cells and compares them with the header checksum
+   *
+   * @return true if the cells are intact
+   */
+  /* ----------------------------------------------------------------*/
+  bool verify() const;
+
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  View on the mapped cells, valid until the file is closed. Its
+   *          version is taken from OccupancyGrid::nextVersion by open(), so
+   *          planners keep their per map work between queries; the file
+   *          must not be changed while it is open. The planners index cells
+   *          by int, so optimalPlanner rejects views of more than INT_MAX
+   *          cells with MAP_TOO_LARGE; search larger files as a TiledGrid.
+   */
+  /* ----------------------------------------------------------------*/
+  GridView getView() const;
+  uint64_t getVersion() const { return version_; }
+  bool isOpen() const { return data_ != nullptr; }
+  int getHeight() const { return height_; }
+  int getWidth() const { return width_; }
+  double getResolution() const { return resolution_; }
+  uint64_t getChecksum() const { return checksum_; }
+
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  Writes a map file, in the cell storage of the view
+   *
+   * @param std::string file name
+   * @param GridView world map
+   * @param double meters per cell
+   *
+   * @return false if the file can not be written
+   */
+  /* ----------------------------------------------------------------*/
+  static bool save(const std::string &, const GridView &, double = 1.0);
+
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  Reads a binary (P5) or plain (P2) PGM image as written by ROS
+   *          map_saver. Like map_server, a pixel is free if its occupancy
+   *          1 - value / maxval is below the threshold; occupied and
+   *          unknown pixels become obstacles.
+   *
+   * @param std::string file name
+   * @param OccupancyGrid grid to fill, BIT storage
+   * @param double free threshold
+   *
+   * @return false if the file is not a readable PGM image
+   */
+  /* ----------------------------------------------------------------*/
+  static bool readPgm(const std::string &, OccupancyGrid &, double = 0.196);
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  Reads a MovingAI benchmark .map file. '.', 'G' and 'S' are
+   *          passable, every other terrain becomes an obstacle.
+   *
+   * @param std::string file name
+   * @param OccupancyGrid grid to fill, BIT storage
+   *
+   * @return false if the file is not a readable .map file
+   */
+  /* ----------------------------------------------------------------*/
+  static bool readMovingAi(const std::string &, OccupancyGrid &);
+
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  Converts a PGM image into a map file
+   *
+   * @param std::string PGM file name
+   * @param std::string map file name
+   * @param double meters per cell, from the map yaml
+   * @param double free threshold, from the map yaml
+   *
+   * @return false if reading or writing fails
+   */
+  /* ----------------------------------------------------------------*/
+  static bool convertPgm(const std::string &, const std::string &,
+                         double = 0.05, double = 0.196);
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  Converts a MovingAI .map file into a map file of 1 m cells
+   *
+   * @param std::string .map file name
+   * @param std::string map file name
+   *
+   * @return false if reading or writing fails
+   */
+  /* ----------------------------------------------------------------*/
+  static bool convertMovingAi(const std::string &, const std::string &);
+
+private:
+  const uint8_t *data_; // start of the mapping, the header
+  std::size_t size_;    // bytes mapped
+  int height_;
+  int width_;
+  CellStorage storage_;
+  int stride_;
+  double resolution_;
+  uint64_t checksum_;
+  uint64_t data_offset_; // where the cells start
+  uint64_t version_;     // map version of the views, new on every open
+};
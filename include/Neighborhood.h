@@ -0,0 +1,90 @@
+/* Copyright (C)
+ * 2019 - Bhargav Dandamudi
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the 'Software'), to deal in the Software without
+ * restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit
+ * persons to whom the Software is furnished to do so,subject to
+ * the following conditions:
+ * The above copyright notice and this permission notice shall
+ * be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED ''AS IS'', WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR
+ * ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM,OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+/**
+ * @file Neighborhood.h
+ * @brief  Compile time move sets for the grid planners
+ * @author Bhargav Dandamudi
+ * @version 1
+ * @date 2019-04-24
+ */
+#pragma once
+#include <algorithm>
+
+/* ----------------------------------------------------------------*/
+/**
+ * @brief  Neighborhood policies. A policy lists its moves as constexpr
+ *          tables, SIZE entries of row offset DY, column offset DX and
+ *          length COST, so a planner templated on it expands a node with
+ *          one loop the compiler can unroll. distance is the matching
+ *          heuristic for absolute row and column differences, it never
+ *          overestimates the cost of a path with these moves.
+ *
+ *          UNIFORM is true when every move has the same length.
+ *          CUT_CORNERS tells if a diagonal move may pass the corner of an
+ *          obstacle; without it both orthogonal cells next to the move
+ *          must be free, so the diagonal neighborhood reaches exactly the
+ *          cells the orthogonal one does.
+ *
+ *          Further move sets (e.g. knight moves) are new structs of the
+ *          same shape.
+ */
+/* ----------------------------------------------------------------*/
+
+// orthogonal moves in the order top, left, bottom, right
+struct FourConnected {
+  static constexpr int SIZE = 4;
+  static constexpr int DY[SIZE] = {-1, 0, 1, 0};
+  static constexpr int DX[SIZE] = {0, -1, 0, 1};
+  static constexpr float COST[SIZE] = {1.0f, 1.0f, 1.0f, 1.0f};
+  static constexpr bool UNIFORM = true;
+  static constexpr bool CUT_CORNERS = false;
+
+  // Manhattan distance
+  static constexpr double distance(int dy, int dx) { return dy + dx; }
+};
+
+// orthogonal moves first, then the diagonals of length sqrt(2)
+struct EightConnected {
+  static constexpr float DIAGONAL = 1.41421356f;
+  static constexpr int SIZE = 8;
+  static constexpr int DY[SIZE] = {-1, 0, 1, 0, -1, 1, 1, -1};
+  static constexpr int DX[SIZE] = {0, -1, 0, 1, -1, -1, 1, 1};
+  static constexpr float COST[SIZE] = {1.0f,     1.0f,     1.0f,     1.0f,
+                                       DIAGONAL, DIAGONAL, DIAGONAL, DIAGONAL};
+  static constexpr bool UNIFORM = false;
+  static constexpr bool CUT_CORNERS = false;
+
+  // octile distance: diagonal steps while both differences shrink, then
+  // straight ones
+  static constexpr double distance(int dy, int dx) {
+    return std::max(dy, dx) + (double(DIAGONAL) - 1.0) * std::min(dy, dx);
+  }
+};
+
+// the moves of EightConnected, diagonals may pass obstacle corners and
+// squeeze between two obstacles
+struct EightConnectedCutCorners : EightConnected {
+  static constexpr bool CUT_CORNERS = true;
+};
@@ -0,0 +1,212 @@
+/* Copyright (C)
+ * 2019 - Bhargav Dandamudi
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the 'Software'), to deal in the Software without
+ * restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit
+ * persons to whom the Software is furnished to do so,subject to
+ * the following conditions:
+ * The above copyright notice and this permission notice shall
+ * be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED ''AS IS'', WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR
+ * ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM,OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+/**
+ * @file OccupancyGrid.h
+ * @brief  Flat row-major occupancy grid shared by all planners
+ * @author Bhargav Dandamudi
+ * @version 1
+ * @date 2019-04-11
+ */
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+/* ----------------------------------------------------------------*/
+/**
+ * @brief  Storage used for every cell of the grid
+ *          BYTE: one uint8_t per cell, keeps the cell value (0-255)
+ *          BIT : one bit per cell, only obstacle(1) / free(0). Every row
+ *                starts on a new 64 bit word.
+ */
+/* ----------------------------------------------------------------*/
+enum class CellStorage { BIT, BYTE };
+
+/* ----------------------------------------------------------------*/
+/**
+ * @brief  Map stored in a single row-major buffer. Cells are addressed either
+ *          by (y,x) position as in the rest of the planners or by the linear
+ *          index y * width + x. A cell with value 1 is an obstacle.
+ */
+/* ----------------------------------------------------------------*/
+class OccupancyGrid {
+public:
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  Default constructor, empty grid
+   */
+  /* ----------------------------------------------------------------*/
+  OccupancyGrid();
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  Grid of given size with all cells free
+   *
+   * @param int height (number of rows)
+   * @param int width (number of columns)
+   * @param CellStorage cell storage
+   */
+  /* ----------------------------------------------------------------*/
+  OccupancyGrid(int, int, CellStorage = CellStorage::BYTE);
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  Converts a nested vector map into a grid
+   *
+   * @param std::vector<std::vector<int>> world map, all rows of same length
+   * @param CellStorage cell storage
+   */
+  /* ----------------------------------------------------------------*/
+  explicit OccupancyGrid(const std::vector<std::vector<int>> &,
+                         CellStorage = CellStorage::BYTE);
+
+  int getHeight() const { return height_; }
+  int getWidth() const { return width_; }
+  int getCellCount() const { return height_ * width_; }
+  CellStorage getStorage() const { return storage_; }
+
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  linear index of a (y,x) position
+   */
+  /* ----------------------------------------------------------------*/
+  int toIndex(std::pair<int, int> position) const {
+    return position.first * width_ + position.second;
+  }
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  (y,x) position of a linear index
+   */
+  /* ----------------------------------------------------------------*/
+  std::pair<int, int> toPosition(int index) const {
+    return std::make_pair(index / width_, index % width_);
+  }
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  To check if the position lies inside the grid
+   */
+  /* ----------------------------------------------------------------*/
+  bool isInside(std::pair<int, int> position) const {
+    return position.first >= 0 && position.second >= 0 &&
+           position.first < height_ && position.second < width_;
+  }
+
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  Value of the cell, always 0 or 1 with bit storage
+   *
+   * @param int linear index of the cell
+   */
+  /* ----------------------------------------------------------------*/
+  int getValue(int index) const {
+    if (storage_ == CellStorage::BYTE) {
+      return bytes_[index];
+    }
+    int y = index / width_;
+    int x = index - y * width_;
+    return int((words_[y * words_per_row_ + (x >> 6)] >> (x & 63)) & 1u);
+  }
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  To check if the cell is an obstacle
+   *
+   * @param int linear index of the cell
+   *
+   * @return true if the cell value is 1
+   */
+  /* ----------------------------------------------------------------*/
+  bool isOccupied(int index) const { return getValue(index) == 1; }
+
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  Map version, unique in the process: every constructed grid
+   *          and every setValue takes a new number, so two grids never
+   *          share a version. Caches built from the grid compare it to
+   *          tell if they are still current. A copy keeps the version of
+   *          its source, it holds the same cells.
+   */
+  /* ----------------------------------------------------------------*/
+  uint64_t getVersion() const { return version_; }
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  Next number of the process wide version counter, thread safe.
+   *          Other owners of cells, like MapFile, take their versions from
+   *          it as well, so no two maps share one.
+   */
+  /* ----------------------------------------------------------------*/
+  static uint64_t nextVersion();
+
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  Sets value of a cell. With bit storage only value 1 is stored as
+   *          obstacle, everything else is stored as free.
+   *
+   * @param int linear index of the cell
+   * @param int new value
+   */
+  /* ----------------------------------------------------------------*/
+  void setValue(int, int);
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  Rewrites all cells row by row and takes one new version for
+   *          the whole grid, so loading a map does not pay a version per
+   *          cell. The reader fills the values of row y, one per column,
+   *          stored like setValue stores them.
+   *
+   * @param std::function reader of row y into the buffer, false on failure
+   *
+   * @return false if the reader failed, the rows before it are written
+   */
+  /* ----------------------------------------------------------------*/
+  bool fillRows(const std::function<bool(int, uint8_t *)> &);
+
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  Converts the grid back into a nested vector map
+   */
+  /* ----------------------------------------------------------------*/
+  std::vector<std::vector<int>> toVector() const;
+
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  raw buffers, only the one matching the storage is filled
+   */
+  /* ----------------------------------------------------------------*/
+  const uint8_t *getBytes() const { return bytes_.data(); }
+  const uint64_t *getWords() const { return words_.data(); }
+  int getWordsPerRow() const { return words_per_row_; }
+
+private:
+  // writes a cell without taking a new version
+  void storeValue(int, int);
+
+  int height_;
+  int width_;
+  int words_per_row_; // 64 bit words in every row with bit storage
+  CellStorage storage_;
+  std::vector<uint8_t> bytes_;  // BYTE storage, height_ * width_ cells
+  std::vector<uint64_t> words_; // BIT storage, height_ * words_per_row_ words
+  uint64_t version_;            // changes with every setValue and fillRows
+};
@@ -0,0 +1,212 @@
+/* Copyright (C)
+ * 2019 - Bhargav Dandamudi
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the 'Software'), to deal in the Software without
+ * restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit
+ * persons to whom the Software is furnished to do so,subject to
+ * the following conditions:
+ * The above copyright notice and this permission notice shall
+ * be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED ''AS IS'', WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR
+ * ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM,OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+/**
+ * @file PathCache.h
+ * @brief  Least recently used cache of planned paths
+ * @author Bhargav Dandamudi
+ * @version 1
+ * @date 2019-04-27
+ */
+#pragma once
+#include "./GridView.h"
+#include "./optimalPlanner.h"
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <stack>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/* ----------------------------------------------------------------*/
+/**
+ * @brief  Keeps the paths of repeated queries. A path is found again for
+ *          the same start, goal, planner type and map version. The version
+ *          has to tell maps apart, not only edits of one map:
+ *          OccupancyGrid::getVersion is unique in the process. The planner
+ *          type is a number chosen by the caller for planners giving
+ *          different paths; search() derives it from the connectivity and
+ *          the cost map of optimalPlanner.
+ *
+ *          At most capacity path cells are kept, the least recently used
+ *          paths are dropped first. Failed searches are kept as well, as a
+ *          path holding the start only.
+ *
+ *          After cells of the map change, updateCells() drops the paths
+ *          through the changed cells plus those a freed cell could shorten,
+ *          over the cell or over a diagonal step past its corner, plus
+ *          for a blocked cell those stepping diagonally past its corner,
+ *          and moves the other paths to the new map version, so the cache
+ *          is not flushed by every edit. A path kept with its cost map is
+ *          judged by its cost against the octile distance scaled by the
+ *          lowest step cost of the map, since a freed cell may open a
+ *          longer but cheaper way; clear the cache when costs change.
+ *
+ *          All functions may be called from any thread.
+ */
+/* ----------------------------------------------------------------*/
+class PathCache {
+public:
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  Constructor
+   *
+   * @param std::size_t number of path cells kept
+   */
+  /* ----------------------------------------------------------------*/
+  explicit PathCache(std::size_t = std::size_t(1) << 20);
+
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  Looks a path up and marks it as most recently used
+   *
+   * @param std::pair start location
+   * @param std::pair goal location
+   * @param uint64_t planner type
+   * @param uint64_t map version
+   * @param std::stack path in the format of the planners, set on a hit
+   *
+   * @return true if the path was cached
+   */
+  /* ----------------------------------------------------------------*/
+  bool find(std::pair<int, int>, std::pair<int, int>, uint64_t, uint64_t,
+            std::stack<std::pair<int, int>> &);
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  Keeps a path, replacing the one of the same key
+   *
+   * @param std::pair start location
+   * @param std::pair goal location
+   * @param uint64_t planner type
+   * @param uint64_t map version
+   * @param std::stack path as returned by the planner
+   * @param CostMap step costs the path was planned with, nullptr for unit
+   *          costs
+   */
+  /* ----------------------------------------------------------------*/
+  void insert(std::pair<int, int>, std::pair<int, int>, uint64_t, uint64_t,
+              const std::stack<std::pair<int, int>> &,
+              const CostMap * = nullptr);
+
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  Cached path of the query, planned and kept on a miss. The
+   *          planner runs without the cache locked. Planners with another
+   *          connectivity or cost map use other keys; a cost map is told
+   *          apart by its address, so clear the cache when costs change.
+   *
+   * @param optimalPlanner planner used on a miss
+   * @param GridView world map
+   * @param std::pair start location
+   * @param std::pair goal location
+   * @param uint64_t map version
+   *
+   * @return stack containing path positions
+   */
+  /* ----------------------------------------------------------------*/
+  std::stack<std::pair<int, int>> search(optimalPlanner &, const GridView &,
+                                         std::pair<int, int>,
+                                         std::pair<int, int>, uint64_t);
+
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  Drops the paths of a map version the changed cells may affect
+   *          and moves the others to the new version
+   *
+   * @param GridView world map after the change
+   * @param std::vector<std::pair<int,int>> changed cell locations
+   * @param uint64_t map version before the change
+   * @param uint64_t map version after the change
+   *
+   * @return number of dropped paths
+   */
+  /* ----------------------------------------------------------------*/
+  int updateCells(const GridView &, const std::vector<std::pair<int, int>> &,
+                  uint64_t, uint64_t);
+
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  Drops all paths
+   */
+  /* ----------------------------------------------------------------*/
+  void clear();
+
+  int size();
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  getter function for the number of path cells kept
+   */
+  /* ----------------------------------------------------------------*/
+  std::size_t getCellCount();
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  getter function for the lookups answered and missed so far
+   */
+  /* ----------------------------------------------------------------*/
+  uint64_t getHits();
+  uint64_t getMisses();
+
+private:
+  struct Key {
+    std::pair<int, int> start;
+    std::pair<int, int> goal;
+    uint64_t planner;
+    uint64_t version;
+    bool operator==(const Key &other) const {
+      return start == other.start && goal == other.goal &&
+             planner == other.planner && version == other.version;
+    }
+  };
+  struct KeyHash {
+    std::size_t operator()(const Key &) const;
+  };
+  struct Entry {
+    Key key;
+    std::vector<std::pair<int, int>> cells; // goal first, start last
+    double cost;     // sum of the step costs
+    double min_step; // lowest cost of an orthogonal step on the map
+    bool reachable;  // false for failed searches
+    int min_y;       // bounding box of the cells
+    int min_x;
+    int max_y;
+    int max_x;
+  };
+
+  // removes an entry from the list and the index, the lock is held
+  void erase(std::list<Entry>::iterator);
+  // true if a change of the cell can change the path of the entry
+  static bool isAffected(const Entry &, std::pair<int, int>, bool);
+  // planner type of search(), the connectivity in the low four bits and
+  // the cost map above
+  static uint64_t plannerType(optimalPlanner &);
+
+  std::mutex mutex_;
+  std::list<Entry> entries_; // most recently used first
+  std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> index_;
+  std::size_t capacity_; // path cells kept at most
+  std::size_t cells_;    // path cells kept
+  uint64_t hits_;
+  uint64_t misses_;
+};
@@ -0,0 +1,102 @@
+/* Copyright (C)
+ * 2019 - Bhargav Dandamudi
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the 'Software'), to deal in the Software without
+ * restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit
+ * persons to whom the Software is furnished to do so,subject to
+ * the following conditions:
+ * The above copyright notice and this permission notice shall
+ * be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED ''AS IS'', WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR
+ * ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM,OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+/**
+ * @file PlanResult.h
+ * @brief  Outcome of a planner query
+ * @author Bhargav Dandamudi
+ * @version 1
+ * @date 2019-04-27
+ */
+#pragma once
+#include "./SearchStats.h"
+#include <utility>
+#include <vector>
+
+/* ----------------------------------------------------------------*/
+/**
+ * @brief  Why a query ended
+ *          SUCCESS       path reaches the goal (start == goal included)
+ *          INVALID_START start outside the map
+ *          INVALID_GOAL  goal outside the map
+ *          BLOCKED_START start on an obstacle
+ *          BLOCKED_GOAL  goal on an obstacle
+ *          UNREACHABLE   no path between start and goal exists
+ *          STEP_LIMIT    RandomPlanner ran out of steps before the goal
+ *          MAP_TOO_LARGE map of more cells than an int indexes
+ */
+/* ----------------------------------------------------------------*/
+enum class PlanStatus {
+  SUCCESS,
+  INVALID_START,
+  INVALID_GOAL,
+  BLOCKED_START,
+  BLOCKED_GOAL,
+  UNREACHABLE,
+  STEP_LIMIT,
+  MAP_TOO_LARGE
+};
+
+/* ----------------------------------------------------------------*/
+/**
+ * @brief  Short description of a status, for callers reporting it
+ */
+/* ----------------------------------------------------------------*/
+inline const char *toString(PlanStatus status) {
+  switch (status) {
+  case PlanStatus::SUCCESS:
+    return "path found";
+  case PlanStatus::INVALID_START:
+    return "start outside the map";
+  case PlanStatus::INVALID_GOAL:
+    return "goal outside the map";
+  case PlanStatus::BLOCKED_START:
+    return "start is an obstacle";
+  case PlanStatus::BLOCKED_GOAL:
+    return "goal is an obstacle";
+  case PlanStatus::UNREACHABLE:
+    return "goal not reachable";
+  case PlanStatus::STEP_LIMIT:
+    return "step limit reached";
+  case PlanStatus::MAP_TOO_LARGE:
+    return "map too large to index";
+  }
+  return "unknown status";
+}
+
+/* ----------------------------------------------------------------*/
+/**
+ * @brief  Result of optimalPlanner::plan and RandomPlanner::plan: the
+ *          status, the cells from start to goal (the cells walked so far
+ *          for STEP_LIMIT, empty when the query was rejected) and the
+ *          statistics of the search
+ */
+/* ----------------------------------------------------------------*/
+struct PlanResult {
+  PlanStatus status = PlanStatus::UNREACHABLE;
+  std::vector<std::pair<int, int>> path; // start first
+  SearchStats stats;
+
+  bool found() const { return status == PlanStatus::SUCCESS; }
+};
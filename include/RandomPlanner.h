@@ -31,11 +31,18 @@
  */
 #pragma once
 #include "./Node.h"
+#include "./ComponentIndex.h"
+#include "./GridView.h"
+#include "./Neighborhood.h"
+#include "./OccupancyGrid.h"
+#include "./PlanResult.h"
+#include "./Xoshiro256.h"
 #include <algorithm>
+#include <cmath>
 #include <deque>
 #include <iostream>
+#include <memory>
 #include <queue>
-#include <time.h>
 #include <utility>
 #include <vector>
 /* ----------------------------------------------------------------*/
@@ -53,7 +60,9 @@ private:
   int max_step_number = 100; // as in problem statement, can be any +ve integer
   std::deque<std::pair<int, int>>
       last_steps; // Queue Memory of last N steps taken so far
-  std::vector<std::vector<int>> world_map;
+  GridView world_map; // map the planner works on
+  std::shared_ptr<const OccupancyGrid>
+      owned_map; // backing grid when the map was handed over as vector
   std::pair<int, int> robot_pose; // starting location of the robot
   std::pair<int, int> goal_pose;  // destination of the robot
   std::vector<std::pair<int, int>> path_;
@@ -63,6 +72,20 @@ private:
   int dir;      // direction inwhich robot will move
   int y_length; // max height of map in y direction
   int x_length; // max width of map in x direction
+  std::shared_ptr<const ComponentIndex>
+      components; // connected regions checked before walking, optional
+  PlanStatus status_ = PlanStatus::SUCCESS; // how the last search ended
+  uint64_t seed_ = newSeed(); // seed of random_, differs between planners
+  Xoshiro256 random_{seed_};  // source of the random directions
+
+  // fresh seed from std::random_device for planners nobody seeded
+  static uint64_t newSeed();
+
+  // moves the robot to a free location, updates memory and path
+  void stepTo(std::pair<int, int>);
+  // shared by the constructors which hand over an owned grid
+  RandomPlanner(std::shared_ptr<const OccupancyGrid>, std::pair<int, int>,
+                std::pair<int, int>);
 
 public:
   /* ----------------------------------------------------------------*/
@@ -81,9 +104,30 @@ public:
    * @param std::pair goal position
    */
   /* ----------------------------------------------------------------*/
-  RandomPlanner(std::vector<std::vector<int>>, std::pair<int, int>,
+  RandomPlanner(const std::vector<std::vector<int>> &, std::pair<int, int>,
                 std::pair<int, int>);
   /* ----------------------------------------------------------------*/
+  /**
+   * @brief Parameterised constructor taking an occupancy grid, the grid is
+   * copied once
+   * @param OccupancyGrid world map
+   * @param std::pair starting position
+   * @param std::pair goal position
+   */
+  /* ----------------------------------------------------------------*/
+  RandomPlanner(const OccupancyGrid &, std::pair<int, int>,
+                std::pair<int, int>);
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief Parameterised constructor taking a map view, nothing is copied
+   * and the viewed map must outlive the planner
+   * @param GridView world map
+   * @param std::pair starting position
+   * @param std::pair goal position
+   */
+  /* ----------------------------------------------------------------*/
+  RandomPlanner(const GridView &, std::pair<int, int>, std::pair<int, int>);
+  /* ----------------------------------------------------------------*/
   /**
    * @brief  to Move in up direction, updates current node
    *
@@ -171,6 +215,21 @@ public:
   /* ----------------------------------------------------------------*/
   int randomDirection();
   /* ----------------------------------------------------------------*/
+  /**
+   * @brief  Restarts the random directions from a seed, for replaying the
+   *          same walks. Planners are seeded differently unless set.
+   *
+   * @param uint64_t seed
+   */
+  /* ----------------------------------------------------------------*/
+  void setSeed(uint64_t);
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  getter function for the seed of the random directions
+   */
+  /* ----------------------------------------------------------------*/
+  uint64_t getSeed();
+  /* ----------------------------------------------------------------*/
   /**
    * @brief  update the last steps queue to maintain memory
    *
@@ -199,12 +258,6 @@ public:
   /* ----------------------------------------------------------------*/
   bool checkLastNPositions(std::pair<int, int>);
   /* ----------------------------------------------------------------*/
-  /**
-   * @brief  to print the robot path if found
-   */
-  /* ----------------------------------------------------------------*/
-  void printPath();
-  /* ----------------------------------------------------------------*/
   /**
    * @brief  To search the path by randomly moving in map with constraint of
    *          not moving to node which is visited already in last N steps
@@ -217,9 +270,44 @@ public:
    * @return
    */
   /* ----------------------------------------------------------------*/
-  std::vector<std::pair<int, int>> search(std::vector<std::vector<int>>,
-                                          std::pair<int, int>,
+  std::vector<std::pair<int, int>>
+  search(const std::vector<std::vector<int>> &, std::pair<int, int>,
+         std::pair<int, int>);
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  Random search on a read-only map view. The map is not copied (an
+   *          OccupancyGrid converts implicitly) and must stay alive while the
+   *          planner refers to it.
+   *
+   * @param GridView world map
+   * @param std::pair start location
+   * @param std::pair goal location
+   *
+   * @return path taken by the robot
+   */
+  /* ----------------------------------------------------------------*/
+  std::vector<std::pair<int, int>> search(const GridView &, std::pair<int, int>,
                                           std::pair<int, int>);
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  Random search telling how the walk ended, STEP_LIMIT when the
+   *          goal was not reached in max_step_number steps. Nothing is
+   *          written to the console.
+   *
+   * @param GridView world map
+   * @param std::pair start location
+   * @param std::pair goal location
+   *
+   * @return status, path walked and statistics
+   */
+  /* ----------------------------------------------------------------*/
+  PlanResult plan(const GridView &, std::pair<int, int>, std::pair<int, int>);
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  getter function for how the last search ended
+   */
+  /* ----------------------------------------------------------------*/
+  PlanStatus getStatus();
 
   /* ----------------------------------------------------------------*/
   /**
@@ -263,4 +351,24 @@ public:
    */
   /* ----------------------------------------------------------------*/
   std::vector<std::pair<int, int>> getPath();
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  Checks every walk against the connected regions first, so a
+   *          goal outside the region of the start fails at once instead of
+   *          after max_step_number steps. The index is used only for the
+   *          map and version it was built or last updated for (see
+   *          ComponentIndex::matches), other maps walk without it.
+   *
+   * @param std::shared_ptr component index, nullptr to walk always
+   */
+  /* ----------------------------------------------------------------*/
+  void setComponentIndex(std::shared_ptr<const ComponentIndex>);
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  getter function for the component index in use
+   *
+   * @return component index, nullptr if none is set
+   */
+  /* ----------------------------------------------------------------*/
+  std::shared_ptr<const ComponentIndex> getComponentIndex();
 };
@@ -0,0 +1,253 @@
+/* Copyright (C)
+ * 2019 - Bhargav Dandamudi
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the 'Software'), to deal in the Software without
+ * restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit
+ * persons to whom the Software is furnished to do so,subject to
+ * the following conditions:
+ * The above copyright notice and this permission notice shall
+ * be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED ''AS IS'', WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR
+ * ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM,OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+/**
+ * @file SearchContext.h
+ * @brief  Per-cell search state kept alive between planner queries
+ * @author Bhargav Dandamudi
+ * @version 1
+ * @date 2019-04-13
+ */
+#pragma once
+#include "./node.h"
+#include <atomic>
+#include <cfloat>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+/* ----------------------------------------------------------------*/
+/**
+ * @brief  Memory layout of the per-cell search state
+ *          ARRAY_OF_STRUCTS: one CompactNode per cell (default), a visit
+ *                            touches a single cache line
+ *          STRUCT_OF_ARRAYS: g costs, parents and states in separate
+ *                            arrays, the closed list check reads only states
+ */
+/* ----------------------------------------------------------------*/
+enum class NodeLayout { ARRAY_OF_STRUCTS, STRUCT_OF_ARRAYS };
+
+/* ----------------------------------------------------------------*/
+/**
+ * @brief  Node information and closed list of optimalPlanner::search, sized
+ *          once per map and reused by every following query.
+ *
+ *          Every search gets a new generation number which is stored with
+ *          each cell it touches. A cell stamped by an older generation reads
+ *          as not reached (FLT_MAX g cost, no parent), so starting a search
+ *          never clears the arrays and a short query costs only the cells
+ *          it explores.
+ */
+/* ----------------------------------------------------------------*/
+class SearchContext {
+public:
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  Constructor, empty context
+   *
+   * @param NodeLayout memory layout of the cell records
+   */
+  /* ----------------------------------------------------------------*/
+  explicit SearchContext(NodeLayout = NodeLayout::ARRAY_OF_STRUCTS);
+
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  Starts a new search over a map with given number of cells.
+   *          Arrays are only reallocated when the cell count or the layout
+   *          changes.
+   *
+   * @param int number of cells of the map
+   */
+  /* ----------------------------------------------------------------*/
+  void beginSearch(int);
+
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  Changes the memory layout, takes effect with the next search
+   */
+  /* ----------------------------------------------------------------*/
+  void setLayout(NodeLayout layout) { layout_ = layout; }
+  NodeLayout getLayout() const { return layout_; }
+
+  int getCellCount() const { return cell_count_; }
+  uint32_t getGeneration() const { return generation_; }
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  Bytes of per-cell state currently allocated
+   */
+  /* ----------------------------------------------------------------*/
+  std::size_t getMemoryUsage() const;
+
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  To check if the cell was reached in the current search
+   */
+  /* ----------------------------------------------------------------*/
+  bool isReached(int index) const {
+    return (getState(index) >> 1) == generation_;
+  }
+  bool isClosed(int index) const {
+    return getState(index) == ((generation_ << 1) | 1u);
+  }
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  Moves a reached cell to the closed list
+   */
+  /* ----------------------------------------------------------------*/
+  void close(int index) { setState(index, (generation_ << 1) | 1u); }
+
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  g cost of the cell, FLT_MAX if not reached in this search
+   */
+  /* ----------------------------------------------------------------*/
+  float getGCost(int index) const {
+    if (!isReached(index)) {
+      return FLT_MAX;
+    }
+    return allocated_layout_ == NodeLayout::ARRAY_OF_STRUCTS
+               ? nodes_[index].g_cost
+               : g_costs_[index];
+  }
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  parent cell index, -1 if not reached in this search
+   */
+  /* ----------------------------------------------------------------*/
+  int getParent(int index) const {
+    if (!isReached(index)) {
+      return -1;
+    }
+    return allocated_layout_ == NodeLayout::ARRAY_OF_STRUCTS
+               ? nodes_[index].parent
+               : parents_[index];
+  }
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  Records a better way to reach an open cell
+   *
+   * @param int cell index
+   * @param float g cost
+   * @param int parent cell index
+   */
+  /* ----------------------------------------------------------------*/
+  void reach(int index, float g_cost, int parent) {
+    if (allocated_layout_ == NodeLayout::ARRAY_OF_STRUCTS) {
+      CompactNode &cell = nodes_[index];
+      cell.g_cost = g_cost;
+      cell.parent = parent;
+      cell.state = generation_ << 1;
+    } else {
+      g_costs_[index] = g_cost;
+      parents_[index] = parent;
+      states_[index] = generation_ << 1;
+    }
+  }
+
+private:
+  uint32_t getState(int index) const {
+    return allocated_layout_ == NodeLayout::ARRAY_OF_STRUCTS
+               ? nodes_[index].state
+               : states_[index];
+  }
+  void setState(int index, uint32_t state) {
+    if (allocated_layout_ == NodeLayout::ARRAY_OF_STRUCTS) {
+      nodes_[index].state = state;
+    } else {
+      states_[index] = state;
+    }
+  }
+
+  NodeLayout layout_;           // layout requested for the next search
+  NodeLayout allocated_layout_; // layout of the allocated arrays
+  int cell_count_;
+  uint32_t generation_; // number of the running search, starts at 1
+  std::vector<CompactNode> nodes_; // ARRAY_OF_STRUCTS storage
+  std::vector<float> g_costs_;     // STRUCT_OF_ARRAYS storage
+  std::vector<int32_t> parents_;
+  std::vector<uint32_t> states_;
+};
+
+/* ----------------------------------------------------------------*/
+/**
+ * @brief  g costs a search thread publishes for another thread to read,
+ *          one atomic word per cell holding the search generation next to
+ *          the cost. Like SearchContext, entries of older generations read
+ *          as FLT_MAX and the array is not cleared between searches.
+ *
+ *          Copies start empty and assignment empties the target: the array
+ *          belongs to one running search.
+ */
+/* ----------------------------------------------------------------*/
+class PublishedCosts {
+public:
+  PublishedCosts();
+  PublishedCosts(const PublishedCosts &);
+  PublishedCosts &operator=(const PublishedCosts &);
+
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  Starts a new search, entries are only reset when the number of
+   *          cells changes. Not thread safe, call before the threads start.
+   *
+   * @param int number of cells of the map
+   */
+  /* ----------------------------------------------------------------*/
+  void beginSearch(int);
+
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  Stores the g cost of a cell
+   *
+   * @param int cell index
+   * @param float g cost
+   */
+  /* ----------------------------------------------------------------*/
+  void publish(int index, float g_cost) {
+    uint32_t bits;
+    std::memcpy(&bits, &g_cost, sizeof(bits));
+    costs_[index].store((uint64_t(generation_) << 32) | bits);
+  }
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  g cost of a cell, FLT_MAX if not published in this search
+   */
+  /* ----------------------------------------------------------------*/
+  float read(int index) const {
+    uint64_t word = costs_[index].load();
+    if (uint32_t(word >> 32) != generation_) {
+      return FLT_MAX;
+    }
+    uint32_t bits = uint32_t(word);
+    float g_cost;
+    std::memcpy(&g_cost, &bits, sizeof(g_cost));
+    return g_cost;
+  }
+
+private:
+  std::unique_ptr<std::atomic<uint64_t>[]> costs_;
+  int size_;
+  uint32_t generation_;
+};
@@ -0,0 +1,156 @@
+/* Copyright (C)
+ * 2019 - Bhargav Dandamudi
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the 'Software'), to deal in the Software without
+ * restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit
+ * persons to whom the Software is furnished to do so,subject to
+ * the following conditions:
+ * The above copyright notice and this permission notice shall
+ * be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED ''AS IS'', WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR
+ * ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM,OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+/**
+ * @file SearchStats.h
+ * @brief  Counters and timings of planner searches
+ * @author Bhargav Dandamudi
+ * @version 1
+ * @date 2019-04-27
+ */
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+
+// Set to 0 (cmake -D SEARCH_STATS=OFF) to compile the counting out of the
+// search loops: the hook counters (pushes, pops, stale_pops, reopenings,
+// peak_open) and the timings then stay 0. searches and expansions are set
+// once per search and kept either way.
+#ifndef PLANNER_SEARCH_STATS
+#define PLANNER_SEARCH_STATS 1
+#endif
+
+/* ----------------------------------------------------------------*/
+/**
+ * @brief  What a search did, for finding out why a query is slow:
+ *
+ *          expansions    nodes moved to the closed list
+ *          pushes, pops  open list operations; a push lowering the f cost
+ *                        of a queued cell in a heap counts as push as well
+ *          stale_pops    pops of cells already closed, left behind in open
+ *                        lists without decrease-key
+ *          reopenings    cheaper paths found to cells already on the open
+ *                        list (the consistent heuristics never reopen
+ *                        closed cells)
+ *          peak_open     largest open list size
+ *          setup_ms      from the call until the first expansion
+ *          search_ms     main loop, without building the path
+ *          track_path_ms walking the parents back into the path
+ *
+ *          A sum over several searches (operator+=) adds everything but
+ *          peak_open, which keeps the largest; searches counts them.
+ */
+/* ----------------------------------------------------------------*/
+struct SearchStats {
+  static constexpr bool ENABLED = PLANNER_SEARCH_STATS != 0;
+
+  uint64_t searches = 0;
+  uint64_t expansions = 0;
+  uint64_t pushes = 0;
+  uint64_t pops = 0;
+  uint64_t stale_pops = 0;
+  uint64_t reopenings = 0;
+  uint64_t peak_open = 0;
+  double setup_ms = 0;
+  double search_ms = 0;
+  double track_path_ms = 0;
+
+  // hot path hooks, empty when the statistics are compiled out
+  void countPush(uint64_t open_size) {
+#if PLANNER_SEARCH_STATS
+    pushes++;
+    peak_open = std::max(peak_open, open_size);
+#else
+    (void)open_size;
+#endif
+  }
+  void countPop() {
+#if PLANNER_SEARCH_STATS
+    pops++;
+#endif
+  }
+  void countStalePop() {
+#if PLANNER_SEARCH_STATS
+    stale_pops++;
+#endif
+  }
+  void countReopening() {
+#if PLANNER_SEARCH_STATS
+    reopenings++;
+#endif
+  }
+
+  SearchStats &operator+=(const SearchStats &other) {
+    searches += other.searches;
+    expansions += other.expansions;
+    pushes += other.pushes;
+    pops += other.pops;
+    stale_pops += other.stale_pops;
+    reopenings += other.reopenings;
+    peak_open = std::max(peak_open, other.peak_open);
+    setup_ms += other.setup_ms;
+    search_ms += other.search_ms;
+    track_path_ms += other.track_path_ms;
+    return *this;
+  }
+};
+
+/* ----------------------------------------------------------------*/
+/**
+ * @brief  Stopwatch for the phases of SearchStats, reads the clock only
+ *          when the statistics are compiled in
+ */
+/* ----------------------------------------------------------------*/
+class StatsTimer {
+public:
+  StatsTimer() { restart(); }
+  void restart() {
+#if PLANNER_SEARCH_STATS
+    start_ = std::chrono::steady_clock::now();
+#endif
+  }
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  Milliseconds since the last restart or lap, restarts
+   */
+  /* ----------------------------------------------------------------*/
+  double lap() {
+#if PLANNER_SEARCH_STATS
+    std::chrono::steady_clock::time_point now =
+        std::chrono::steady_clock::now();
+    double elapsed =
+        std::chrono::duration<double, std::milli>(now - start_).count();
+    start_ = now;
+    return elapsed;
+#else
+    return 0;
+#endif
+  }
+
+private:
+#if PLANNER_SEARCH_STATS
+  std::chrono::steady_clock::time_point start_;
+#endif
+};
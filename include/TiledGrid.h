@@ -0,0 +1,299 @@
+/* Copyright (C)
+ * 2019 - Bhargav Dandamudi
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the 'Software'), to deal in the Software without
+ * restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit
+ * persons to whom the Software is furnished to do so,subject to
+ * the following conditions:
+ * The above copyright notice and this permission notice shall
+ * be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED ''AS IS'', WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR
+ * ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM,OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+/**
+ * @file TiledGrid.h
+ * @brief  Map paged in fixed size tiles, for maps larger than memory
+ * @author Bhargav Dandamudi
+ * @version 1
+ * @date 2019-04-27
+ */
+#pragma once
+#include "./GridView.h"
+#include "./MapFile.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/* ----------------------------------------------------------------*/
+/**
+ * @brief  Map read in tiles of TILE_SIZE x TILE_SIZE cells. A tile is
+ *          copied out of the source (usually a mapped MapFile) the first
+ *          time one of its cells is asked for and kept in a cache of at
+ *          most capacity tiles; the least recently used tile is dropped
+ *          first. Only the tiles a search actually visits are read, so the
+ *          map may be much larger than memory.
+ *
+ *          A tile holds one bit per cell, tile row r is word r and cell x
+ *          is bit x. Cells outside the map read as obstacles.
+ *
+ *          Lookups change the cache, a TiledGrid is used by one thread at a
+ *          time.
+ */
+/* ----------------------------------------------------------------*/
+class TiledGrid {
+public:
+  static constexpr int TILE_SIZE = 64; // cells per tile side, one word a row
+
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  Constructor, empty map
+   *
+   * @param int number of tiles kept in memory, at least 1
+   */
+  /* ----------------------------------------------------------------*/
+  explicit TiledGrid(int = 1024);
+
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  Maps a map file (see MapFile) and pages its cells from there
+   *
+   * @param std::string file name
+   *
+   * @return false if the file is not a valid map file
+   */
+  /* ----------------------------------------------------------------*/
+  bool open(const std::string &);
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  Pages the cells from a view, the viewed map must outlive the
+   *          grid and stay unchanged
+   *
+   * @param GridView world map
+   */
+  /* ----------------------------------------------------------------*/
+  void assign(const GridView &);
+
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  Drops all tiles from the cache
+   */
+  /* ----------------------------------------------------------------*/
+  void clear();
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  Changes the number of tiles kept, drops all tiles
+   */
+  /* ----------------------------------------------------------------*/
+  void setCapacity(int);
+  int getCapacity() const { return capacity_; }
+
+  int getHeight() const { return source_.getHeight(); }
+  int getWidth() const { return source_.getWidth(); }
+  int getTileRows() const { return tile_rows_; }
+  int getTileColumns() const { return tile_columns_; }
+  bool isInside(std::pair<int, int> position) const {
+    return source_.isInside(position);
+  }
+
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  To check for obstacle, loads the tile of the cell if needed
+   *
+   * @param int row
+   * @param int column
+   *
+   * @return true for obstacles and cells outside the map
+   */
+  /* ----------------------------------------------------------------*/
+  bool isOccupied(int y, int x) {
+    if (y < 0 || x < 0 || y >= source_.getHeight() ||
+        x >= source_.getWidth()) {
+      return true;
+    }
+    int64_t id = int64_t(y / TILE_SIZE) * tile_columns_ + x / TILE_SIZE;
+    if (id != last_id_) {
+      last_cells_ = findTile(id);
+      last_id_ = id;
+    }
+    return (last_cells_[y % TILE_SIZE] >> (x % TILE_SIZE)) & 1u;
+  }
+  bool isOccupied(std::pair<int, int> position) {
+    return isOccupied(position.first, position.second);
+  }
+
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  getter function for the tiles in memory and the tiles read
+   *          from the source so far
+   */
+  /* ----------------------------------------------------------------*/
+  int getResidentTiles() const { return int(slots_.size()); }
+  uint64_t getLoadCount() const { return loads_; }
+  std::size_t getMemoryUsage() const { return tiles_.size() * sizeof(Tile); }
+
+private:
+  struct Tile {
+    uint64_t cells[TILE_SIZE]; // bit x of word y, 1 for obstacles
+    int64_t id;                // tile row * tile columns + tile column
+    int newer;                 // neighbours in the LRU order, -1 at the ends
+    int older;
+  };
+
+  // cells of a tile, loaded into the least recently used slot if missing
+  const uint64_t *findTile(int64_t);
+  void loadTile(Tile &) const;
+  void unlink(int);
+  void pushFront(int);
+
+  std::unique_ptr<MapFile> file_; // mapped file opened by the grid
+  GridView source_;
+  int tile_rows_;
+  int tile_columns_;
+  int capacity_;
+  std::vector<Tile> tiles_;                  // cache slots, up to capacity_
+  std::unordered_map<int64_t, int> slots_;   // tile id to slot
+  int newest_;                               // most recently used slot
+  int oldest_;                               // least recently used slot
+  int64_t last_id_;                          // tile of the last lookup
+  const uint64_t *last_cells_;
+  uint64_t loads_;
+};
+
+/* ----------------------------------------------------------------*/
+/**
+ * @brief  Search state of optimalPlanner on a TiledGrid: g cost, move into
+ *          the cell and closed flag, kept in blocks of one tile each. A
+ *          block is taken when the search first reaches a cell of the tile,
+ *          so the memory follows the tiles visited instead of the map size.
+ *
+ *          Like SearchContext, cells carry the number of the search they
+ *          were stamped by. Blocks are handed to other tiles by the next
+ *          search without clearing them.
+ */
+/* ----------------------------------------------------------------*/
+class TiledSearchContext {
+public:
+  static constexpr uint8_t NO_MOVE = 0xff; // parent move of the start
+
+  TiledSearchContext();
+  // copies start empty, the blocks belong to one planner
+  TiledSearchContext(const TiledSearchContext &) : TiledSearchContext() {}
+  TiledSearchContext &operator=(const TiledSearchContext &) {
+    release();
+    return *this;
+  }
+
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  Starts a new search, all cells read as not reached
+   *
+   * @param int tile columns of the map
+   */
+  /* ----------------------------------------------------------------*/
+  void beginSearch(int);
+
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  Frees the blocks of earlier searches
+   */
+  /* ----------------------------------------------------------------*/
+  void release();
+
+  bool isReached(int y, int x) {
+    const Block *block = findBlock(y, x, false);
+    return block != nullptr && (block->state[cell(y, x)] >> 1) == generation_;
+  }
+  bool isClosed(int y, int x) {
+    const Block *block = findBlock(y, x, false);
+    return block != nullptr &&
+           block->state[cell(y, x)] == ((generation_ << 1) | 1u);
+  }
+  void close(int y, int x) {
+    findBlock(y, x, true)->state[cell(y, x)] = (generation_ << 1) | 1u;
+  }
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  g cost of the cell, FLT_MAX if not reached in this search
+   */
+  /* ----------------------------------------------------------------*/
+  float getGCost(int y, int x);
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  index of the move from the parent into the cell, NO_MOVE for
+   *          the start and cells not reached
+   */
+  /* ----------------------------------------------------------------*/
+  uint8_t getMove(int y, int x);
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  Records a better way to reach an open cell
+   *
+   * @param int row
+   * @param int column
+   * @param float g cost
+   * @param uint8_t index of the move from the parent
+   */
+  /* ----------------------------------------------------------------*/
+  void reach(int y, int x, float g_cost, uint8_t move) {
+    Block *block = findBlock(y, x, true);
+    int i = cell(y, x);
+    block->g_cost[i] = g_cost;
+    block->move[i] = move;
+    block->state[i] = generation_ << 1;
+  }
+
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  getter function for the tiles the current search reached
+   */
+  /* ----------------------------------------------------------------*/
+  int getTileCount() const { return int(used_); }
+  std::size_t getMemoryUsage() const { return blocks_.size() * sizeof(Block); }
+
+private:
+  static constexpr int CELLS = TiledGrid::TILE_SIZE * TiledGrid::TILE_SIZE;
+  struct Block {
+    float g_cost[CELLS];
+    uint32_t state[CELLS]; // generation << 1 | closed
+    uint8_t move[CELLS];
+  };
+
+  static int cell(int y, int x) {
+    return (y % TiledGrid::TILE_SIZE) * TiledGrid::TILE_SIZE +
+           x % TiledGrid::TILE_SIZE;
+  }
+  // block of the tile holding the cell, taken from the pool when create is
+  // set, else nullptr if the search did not reach the tile
+  Block *findBlock(int y, int x, bool create) {
+    int64_t id = int64_t(y / TiledGrid::TILE_SIZE) * tile_columns_ +
+                 x / TiledGrid::TILE_SIZE;
+    if (id == last_id_ && (last_block_ != nullptr || !create)) {
+      return last_block_;
+    }
+    return lookupBlock(id, create);
+  }
+  Block *lookupBlock(int64_t, bool);
+
+  std::vector<std::unique_ptr<Block>> blocks_; // pool, reused by searches
+  std::size_t used_;                           // blocks of the current search
+  std::unordered_map<int64_t, Block *> tiles_; // tile id to block
+  int tile_columns_;
+  uint32_t generation_;
+  int64_t last_id_; // tile of the last lookup
+  Block *last_block_;
+};
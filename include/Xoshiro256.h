@@ -0,0 +1,103 @@
+/* Copyright (C)
+ * 2019 - Bhargav Dandamudi
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the 'Software'), to deal in the Software without
+ * restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit
+ * persons to whom the Software is furnished to do so,subject to
+ * the following conditions:
+ * The above copyright notice and this permission notice shall
+ * be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED ''AS IS'', WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR
+ * ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM,OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+/**
+ * @file Xoshiro256.h
+ * @brief  Small fast random number generator owned by one planner
+ * @author Bhargav Dandamudi
+ * @version 1
+ * @date 2019-04-27
+ */
+#pragma once
+#include <cstdint>
+
+/* ----------------------------------------------------------------*/
+/**
+ * @brief  xoshiro256** generator (Blackman and Vigna): 256 bits of state,
+ *          a few shifts and rotations per 64 bit number. The state is
+ *          filled from a 64 bit seed with splitmix64, so equal seeds give
+ *          equal sequences on every platform.
+ *
+ *          Unlike rand() nothing is shared: every planner owns its
+ *          generator and planners on different threads do not interfere.
+ *          One generator must not be used by two threads at once.
+ */
+/* ----------------------------------------------------------------*/
+class Xoshiro256 {
+public:
+  explicit Xoshiro256(uint64_t seed = 0) { this->seed(seed); }
+
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  Restarts the sequence of the seed
+   *
+   * @param uint64_t seed
+   */
+  /* ----------------------------------------------------------------*/
+  void seed(uint64_t seed) {
+    for (uint64_t &word : state_) {
+      seed += 0x9e3779b97f4a7c15ull;
+      uint64_t z = seed;
+      z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+      z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+      word = z ^ (z >> 31);
+    }
+  }
+
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  Next 64 random bits
+   */
+  /* ----------------------------------------------------------------*/
+  uint64_t next() {
+    uint64_t result = rotate(state_[1] * 5, 7) * 9;
+    uint64_t t = state_[1] << 17;
+    state_[2] ^= state_[0];
+    state_[3] ^= state_[1];
+    state_[1] ^= state_[2];
+    state_[0] ^= state_[3];
+    state_[2] ^= t;
+    state_[3] = rotate(state_[3], 45);
+    return result;
+  }
+
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  Random number in [0, bound), from the high 32 bits scaled by
+   *          a multiplication instead of the slower, low bit biased modulo
+   *
+   * @param uint32_t bound, > 0
+   */
+  /* ----------------------------------------------------------------*/
+  uint32_t below(uint32_t bound) {
+    return uint32_t(((next() >> 32) * bound) >> 32);
+  }
+
+private:
+  static uint64_t rotate(uint64_t x, int k) {
+    return (x << k) | (x >> (64 - k));
+  }
+
+  uint64_t state_[4];
+};
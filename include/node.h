@@ -32,6 +32,7 @@
 #pragma once
 
 #include <cmath>
+#include <cstdint>
 #include <iostream>
 
 /* ----------------------------------------------------------------*/
@@ -48,3 +49,18 @@ struct node {
   double f_cost;                 // sum of g and h costs;
   double h_cost;                 // cost to go from the node to goal node
 };
+
+/* ----------------------------------------------------------------*/
+/**
+ * @brief  12 byte per cell record kept by the search context. The location is
+ *          the cell index, h is recomputed from the location and f = g + h,
+ *          so only the g cost and the parent are stored. A float g cost is
+ *          exact for paths of up to 2^24 unit steps.
+ */
+/* ----------------------------------------------------------------*/
+struct CompactNode {
+  float g_cost;   // g cost of the node, FLT_MAX if not reached yet
+  int32_t parent; // linear index of the parent cell, -1 if none
+  uint32_t state; // search generation << 1 | closed flag
+};
+static_assert(sizeof(CompactNode) == 12, "CompactNode must stay 12 bytes");
@@ -29,10 +29,26 @@
  * @version 1
  * @date 2019-04-04
  */
+#pragma once
+#include "./BitWavefront.h"
+#include "./BucketQueue.h"
+#include "./ComponentIndex.h"
+#include "./CostMap.h"
+#include "./GridView.h"
+#include "./IndexedHeap.h"
+#include "./LandmarkHeuristic.h"
+#include "./Neighborhood.h"
+#include "./OccupancyGrid.h"
+#include "./PlanResult.h"
+#include "./SearchContext.h"
+#include "./SearchStats.h"
+#include "./TiledGrid.h"
 #include "./node.h"
+#include <atomic>
 #include <bits/stdc++.h>
 #include <cmath>
 #include <iostream>
+#include <memory>
 #include <queue>
 #include <stdlib.h>
 #include <utility>
@@ -40,6 +56,57 @@
 // defining types for ease in usage for programs
 typedef std::pair<double, std::pair<int, int>> DoublePair;
 
+/* ----------------------------------------------------------------*/
+/**
+ * @brief  Priority queue used as open list by optimalPlanner::search
+ *          SET            : std::set<DoublePair>, stale entries are left behind
+ *                           when a node is improved
+ *          BINARY_HEAP    : indexed binary heap with decrease-key
+ *          QUATERNARY_HEAP: indexed 4-ary heap with decrease-key (default)
+ *          BUCKET_QUEUE   : one bucket per integer f cost, LIFO on ties,
+ *                           stale entries are left behind like in SET.
+ *                           Needs integer f costs, which unit moves and
+ *                           Manhattan or landmark heuristics give. Eight
+ *                           connected searches use QUATERNARY_HEAP instead.
+ */
+/* ----------------------------------------------------------------*/
+enum class OpenListType { SET, BINARY_HEAP, QUATERNARY_HEAP, BUCKET_QUEUE };
+
+/* ----------------------------------------------------------------*/
+/**
+ * @brief  Expansion strategy of optimalPlanner::search
+ *          ASTAR     : expands every neighbor of the current node (default)
+ *          JUMP_POINT: jump point search, skips the symmetric paths through
+ *                      open areas and only queues the nodes where the path
+ *                      may turn. Needs a uniform cost grid, gives paths of
+ *                      the same length as ASTAR.
+ *          BIDIRECTIONAL: astar from the start and backwards from the goal
+ *                      until the frontiers meet on a provably shortest path.
+ *                      Both frontiers use an indexed 4-ary heap.
+ */
+/* ----------------------------------------------------------------*/
+enum class SearchMode { ASTAR, JUMP_POINT, BIDIRECTIONAL };
+
+/* ----------------------------------------------------------------*/
+/**
+ * @brief  Moves optimalPlanner::search may take, see Neighborhood.h
+ *          FOUR_CONNECTED : top, left, bottom and right, Manhattan
+ *                           heuristic (default)
+ *          EIGHT_CONNECTED: the diagonals as well at cost sqrt(2), not
+ *                           past obstacle corners, octile heuristic
+ *          EIGHT_CONNECTED_CUT_CORNERS: the diagonals may pass the corner
+ *                           of an obstacle, only the target cell has to
+ *                           be free
+ *
+ *          Other move sets are searched with search<Neighborhood>.
+ */
+/* ----------------------------------------------------------------*/
+enum class Connectivity {
+  FOUR_CONNECTED,
+  EIGHT_CONNECTED,
+  EIGHT_CONNECTED_CUT_CORNERS
+};
+
 /* ----------------------------------------------------------------*/
 /**
  * @brief  Optimal Planner class members declaration
@@ -64,8 +131,31 @@ public:
    * @param std::pair  robot goal location
    */
   /* ----------------------------------------------------------------*/
-  optimalPlanner(std::vector<std::vector<int>>, std::pair<int, int>,
+  optimalPlanner(const std::vector<std::vector<int>> &, std::pair<int, int>,
                  std::pair<int, int>);
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  Parameterised Constructor taking an occupancy grid, the grid is
+   *          copied once
+   *
+   * @param OccupancyGrid world map
+   * @param std::pair  robot start location
+   * @param std::pair  robot goal location
+   */
+  /* ----------------------------------------------------------------*/
+  optimalPlanner(const OccupancyGrid &, std::pair<int, int>,
+                 std::pair<int, int>);
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  Parameterised Constructor taking a map view, nothing is copied
+   *          and the viewed map must outlive the planner
+   *
+   * @param GridView world map
+   * @param std::pair  robot start location
+   * @param std::pair  robot goal location
+   */
+  /* ----------------------------------------------------------------*/
+  optimalPlanner(const GridView &, std::pair<int, int>, std::pair<int, int>);
 
   /* ----------------------------------------------------------------*/
   /**
@@ -78,9 +168,79 @@ public:
    * @return stack containing path positions
    */
   /* ----------------------------------------------------------------*/
-  std::stack<std::pair<int, int>> search(std::vector<std::vector<int>>,
-                                         std::pair<int, int>,
+  std::stack<std::pair<int, int>>
+  search(const std::vector<std::vector<int>> &, std::pair<int, int>,
+         std::pair<int, int>);
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  Searches the path using astar algorithm on a read-only map view.
+   *          The map is not copied (an OccupancyGrid converts implicitly) and
+   *          must stay alive while the planner refers to it.
+   *
+   * @param GridView world map
+   * @param std::pair robot start location
+   * @param std::pair robot goal location
+   *
+   * @return stack containing path positions
+   */
+  /* ----------------------------------------------------------------*/
+  std::stack<std::pair<int, int>> search(const GridView &, std::pair<int, int>,
+                                         std::pair<int, int>);
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  Astar with the moves of a neighborhood policy (see
+   *          Neighborhood.h), e.g. search<EightConnectedCutCorners> or a
+   *          policy struct of the caller. Ignores the connectivity and the
+   *          search mode; landmark tables are only used by FourConnected.
+   *
+   * @param GridView world map
+   * @param std::pair robot start location
+   * @param std::pair robot goal location
+   *
+   * @return stack containing path positions
+   */
+  /* ----------------------------------------------------------------*/
+  template <class Neighborhood>
+  std::stack<std::pair<int, int>> search(const GridView &, std::pair<int, int>,
                                          std::pair<int, int>);
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  Searches the path using astar algorithm on a tiled map. Tiles
+   *          are read and search state is allocated only for the tiles the
+   *          search visits. Runs ASTAR with the connectivity in use; the
+   *          search mode, open list type, landmarks, component index and
+   *          terrain costs apply to whole map searches only.
+   *
+   * @param TiledGrid world map
+   * @param std::pair robot start location
+   * @param std::pair robot goal location
+   *
+   * @return stack containing path positions
+   */
+  /* ----------------------------------------------------------------*/
+  std::stack<std::pair<int, int>> search(TiledGrid &, std::pair<int, int>,
+                                         std::pair<int, int>);
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  Searches like search and tells how the query ended. The
+   *          planner writes nothing to the console, callers report the
+   *          status themselves.
+   *
+   * @param GridView world map
+   * @param std::pair robot start location
+   * @param std::pair robot goal location
+   *
+   * @return status, path from start to goal and search statistics
+   */
+  /* ----------------------------------------------------------------*/
+  PlanResult plan(const GridView &, std::pair<int, int>, std::pair<int, int>);
+  PlanResult plan(TiledGrid &, std::pair<int, int>, std::pair<int, int>);
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  getter function for how the last search ended
+   */
+  /* ----------------------------------------------------------------*/
+  PlanStatus getStatus();
 
   /* ----------------------------------------------------------------*/
   /**
@@ -183,6 +343,198 @@ public:
   /* ----------------------------------------------------------------*/
   void moveAndUpdateNodes(std::pair<int, int>, std::pair<int, int>);
 
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  Selects the priority queue used as open list in search
+   *
+   * @param OpenListType open list implementation
+   */
+  /* ----------------------------------------------------------------*/
+  void setOpenListType(OpenListType);
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  getter function for the open list implementation
+   *
+   * @return open list implementation in use
+   */
+  /* ----------------------------------------------------------------*/
+  OpenListType getOpenListType();
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  Selects the memory layout of the per-cell search state
+   *
+   * @param NodeLayout array of structs or struct of arrays
+   */
+  /* ----------------------------------------------------------------*/
+  void setNodeLayout(NodeLayout);
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  getter function for the per-cell search state layout
+   *
+   * @return layout in use
+   */
+  /* ----------------------------------------------------------------*/
+  NodeLayout getNodeLayout();
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  Selects how search expands nodes
+   *
+   * @param SearchMode astar or jump point search
+   */
+  /* ----------------------------------------------------------------*/
+  void setSearchMode(SearchMode);
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  getter function for the search mode
+   *
+   * @return search mode in use
+   */
+  /* ----------------------------------------------------------------*/
+  SearchMode getSearchMode();
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  Selects the moves of the search. Landmark tables hold four
+   *          connected distances and are not used for eight connected
+   *          searches, which also run JUMP_POINT and BIDIRECTIONAL as ASTAR.
+   *
+   * @param Connectivity four or eight connected
+   */
+  /* ----------------------------------------------------------------*/
+  void setConnectivity(Connectivity);
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  getter function for the moves of the search
+   *
+   * @return connectivity in use
+   */
+  /* ----------------------------------------------------------------*/
+  Connectivity getConnectivity();
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  getter function for the number of nodes expanded (moved to the
+   *          closed list) by the last search
+   *
+   * @return expanded nodes
+   */
+  /* ----------------------------------------------------------------*/
+  int getExpandedNodes();
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  getter function for the number of tiles the last search on a
+   *          TiledGrid kept search state for
+   */
+  /* ----------------------------------------------------------------*/
+  int getSearchedTiles();
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  Bytes the planner keeps allocated between searches: search
+   *          contexts, open lists and the packed map of the reachability
+   *          check. The map itself is not counted.
+   */
+  /* ----------------------------------------------------------------*/
+  std::size_t getMemoryUsage() const;
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  getter function for the counters and timings of the last
+   *          search. Built without SEARCH_STATS only searches and
+   *          expansions are set, the other fields stay 0.
+   *
+   * @return statistics of the last search
+   */
+  /* ----------------------------------------------------------------*/
+  SearchStats getSearchStats();
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  Lets BIDIRECTIONAL search grow both frontiers on their own
+   *          thread instead of alternating on the calling thread
+   *
+   * @param bool true for two threads
+   */
+  /* ----------------------------------------------------------------*/
+  void setParallelFrontiers(bool);
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  getter function for the parallel frontiers option
+   *
+   * @return true if bidirectional search runs on two threads
+   */
+  /* ----------------------------------------------------------------*/
+  bool getParallelFrontiers();
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  Uses landmark tables on top of Manhattan distance for the H
+   *          cost. Tables are ignored on maps they do not match (see
+   *          LandmarkHeuristic::matches), e.g. another size or an edited
+   *          map.
+   *
+   * @param std::shared_ptr landmark tables, nullptr for Manhattan only
+   */
+  /* ----------------------------------------------------------------*/
+  void setLandmarks(std::shared_ptr<const LandmarkHeuristic>);
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  getter function for the landmark tables in use
+   *
+   * @return landmark tables, nullptr if none are set
+   */
+  /* ----------------------------------------------------------------*/
+  std::shared_ptr<const LandmarkHeuristic> getLandmarks();
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  Checks every query against the connected regions first, so a
+   *          goal in another region returns at once without expanding the
+   *          region of the start. The index is used only for the map and
+   *          version it was built or last updated for (see
+   *          ComponentIndex::matches), and the orthogonal regions are
+   *          ignored for moves that cut corners and can leave them.
+   *
+   * @param std::shared_ptr component index, nullptr to search always
+   */
+  /* ----------------------------------------------------------------*/
+  void setComponentIndex(std::shared_ptr<const ComponentIndex>);
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  Uses per cell terrain costs: a step into a cell costs 1 + its
+   *          cost and lethal cells are blocked. JUMP_POINT and BIDIRECTIONAL
+   *          search like ASTAR while costs are in use. A cost map of another
+   *          size is ignored.
+   *
+   * @param std::shared_ptr terrain costs, nullptr for unit steps
+   */
+  /* ----------------------------------------------------------------*/
+  void setCostMap(std::shared_ptr<const CostMap>);
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  getter function for the terrain costs in use
+   *
+   * @return cost map, nullptr if none is set
+   */
+  /* ----------------------------------------------------------------*/
+  std::shared_ptr<const CostMap> getCostMap();
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  getter function for the component index in use
+   *
+   * @return component index, nullptr if none is set
+   */
+  /* ----------------------------------------------------------------*/
+  std::shared_ptr<const ComponentIndex> getComponentIndex();
+  /* ----------------------------------------------------------------*/
+  /**
+   * @brief  Floods the region of the start with the bit parallel
+   *          wavefront (see BitWavefront) before searching, so a goal in
+   *          another region returns after touching 64 cells at a time
+   *          instead of expanding the region cell by cell. Needs no index
+   *          kept up to date: the free cells are packed once per map
+   *          version, which grids and MapFile views carry; raw views
+   *          without a version are packed for every search.
+   *
+   * @param bool true to check reachability first
+   */
+  /* ----------------------------------------------------------------*/
+  void setReachabilityCheck(bool);
+  bool getReachabilityCheck();
+
   /* ----------------------------------------------------------------*/
   /**
    * @brief   To move in respective location
@@ -225,15 +577,243 @@ public:
   std::pair<int, int> goRight(std::pair<int, int>);
 
 private:
+  // map, poses and checks shared by the searches on a map view; false when
+  // the query is answered without searching. Tells if all moves have the
+  // same length and if the moves reach the regions of ComponentIndex
+  bool beginSearch(const GridView &, std::pair<int, int>, std::pair<int, int>,
+                   bool, bool);
+  // statistics, status and start of the path after a search on a map view
+  std::stack<std::pair<int, int>> finishSearch();
+  // astar main loop expanding the moves of a Neighborhood.h policy
+  template <class Neighborhood> void astarSearch();
+  // heuristic of a Neighborhood.h policy, with landmarks and terrain costs
+  template <class Neighborhood>
+  double heuristic(std::pair<int, int>, std::pair<int, int>);
+  // astar main loop on a tiled map
+  template <class Neighborhood> void tiledSearch(TiledGrid &);
+  // jump point search main loop, run by search in JUMP_POINT mode
+  void jumpPointSearch();
+  // walks from a node in direction (dy,dx) until a jump point is found
+  bool jump(std::pair<int, int>, int, int, std::pair<int, int> &);
+  // inside the map and not an obstacle
+  bool isFree(int, int);
+
+  // one direction of the bidirectional search
+  struct Frontier {
+    SearchContext *context; // g costs and parents of this direction
+    IndexedHeap<4> *open;
+    PublishedCosts *published; // g costs for the other thread, or nullptr
+    std::pair<int, int> target; // where this direction heads to
+    int expanded;
+    SearchStats stats; // counted apart, the frontiers may run on two threads
+  };
+  // bidirectional search main loop, run by search in BIDIRECTIONAL mode
+  void bidirectionalSearch();
+  // expands one node of a frontier, false once the frontier has to stop
+  bool expandFrontier(Frontier &, const Frontier &, std::atomic<uint64_t> &);
+  // heuristic between two locations for the connectivity in use
+  double calculateHCost(std::pair<int, int>, std::pair<int, int>);
+
+  // cost of a step into the cell
+  float stepCost(int index) {
+    return this->step_costs_ == nullptr ? 1.0f
+                                        : 1.0f + this->step_costs_[index];
+  }
+  // landmark tables are set, sized for world_map_ and valid for the moves
+  bool landmarksFit();
+  // goal reachable from the start in the packed free cells of world_map_
+  bool wavefrontReaches();
+
+  // open list operations dispatched on open_list_type_
+  void clearOpenList();
+  void pushOpenList(double, std::pair<int, int>);
+  bool isOpenListEmpty();
+  std::pair<int, int> popOpenList();
+  int openListSize();
+  // status, path and statistics of the search that returned the path
+  PlanResult toResult(std::stack<std::pair<int, int>>);
+
   std::pair<int, int> start_position_;
   std::pair<int, int> goal_position_;
   bool found_goal;
-  std::vector<std::vector<int>> world_map_;
+  bool jump_links_ = false; // parents lie several cells away (jump points)
+  GridView world_map_; // map the planner works on
+  std::shared_ptr<const OccupancyGrid>
+      owned_map_; // backing grid when the map was handed over as vector
   int x_length;
   int y_length;
   std::stack<std::pair<int, int>> path_;
-  std::vector<std::vector<node>> node_information;
-  std::vector<std::vector<bool>> closed_list; // to store visited nodes
+  SearchContext context_; // node information and closed list, reused by
+                          // every search on this planner
+  OpenListType open_list_type_ = OpenListType::QUATERNARY_HEAP;
+  NodeLayout node_layout_ = NodeLayout::ARRAY_OF_STRUCTS;
+  SearchMode search_mode_ = SearchMode::ASTAR;
+  Connectivity connectivity_ = Connectivity::FOUR_CONNECTED;
+  OpenListType open_list_in_use_ =
+      OpenListType::QUATERNARY_HEAP; // open list of the current search
+  int expanded_nodes_ = 0;
+  SearchStats stats_; // of the last search
+  StatsTimer search_timer_; // phases of the running search
+  PlanStatus status_ = PlanStatus::SUCCESS;
+  bool parallel_frontiers_ = false;
+  std::shared_ptr<const LandmarkHeuristic> landmarks_;
+  bool use_landmarks_ = false; // tables set and matching the current map
+  // result of the last LandmarkHeuristic::matches and what it compared
+  const LandmarkHeuristic *landmarks_checked_ = nullptr;
+  uint64_t landmarks_version_ = 0;
+  bool landmarks_match_ = false;
+  std::shared_ptr<const ComponentIndex> components_;
+  bool reachability_check_ = false;
+  BitWavefront wavefront_; // free cells of world_map_ for the check
+  uint64_t wavefront_version_ = 0; // map version packed into wavefront_
+  std::shared_ptr<const CostMap> cost_map_;
+  const uint8_t *step_costs_ = nullptr; // costs of the current search, null
+                                        // on the unit cost path
+  double heuristic_scale_ = 1.0;        // 1 + lowest terrain cost
+  SearchContext backward_context_; // goal side of bidirectional search
+  IndexedHeap<4> forward_open_;
+  IndexedHeap<4> backward_open_;
+  PublishedCosts forward_costs_;
+  PublishedCosts backward_costs_;
   std::set<DoublePair> open_list; // to store all possible nodes which needs
                                   // to visited while exploring the map
+  IndexedHeap<2> binary_heap_;    // open list keyed by cell index
+  IndexedHeap<4> quaternary_heap_;
+  BucketQueue bucket_queue_;
+  TiledSearchContext tiled_context_; // search state of tiled map searches
+  std::priority_queue<DoublePair, std::vector<DoublePair>,
+                      std::greater<DoublePair>>
+      tiled_open_; // open list of tiled map searches, keeps stale entries
 };
+
+// the templates are defined here so searches can be instantiated with
+// neighborhood policies of the caller
+
+/* ----------------------------------------------------------------*/
+/**
+ * @brief  Astar on a map view expanding the moves of the policy
+ *
+ * @param world_map
+ * @param robot_pose
+ * @param goal_pose
+ *
+ * @return Path
+ */
+/* ----------------------------------------------------------------*/
+template <class Neighborhood>
+std::stack<std::pair<int, int>>
+optimalPlanner::search(const GridView &world_map,
+                       std::pair<int, int> robot_pose,
+                       std::pair<int, int> goal_pose) {
+  // diagonals not cutting corners connect what orthogonal moves connect
+  bool orthogonal_regions = std::is_same<Neighborhood, FourConnected>::value ||
+                            std::is_same<Neighborhood, EightConnected>::value;
+  if (!beginSearch(world_map, robot_pose, goal_pose, Neighborhood::UNIFORM,
+                   orthogonal_regions)) {
+    return this->path_;
+  }
+  // the tables hold four connected distances
+  if (!std::is_same<Neighborhood, FourConnected>::value) {
+    this->use_landmarks_ = false;
+  }
+  astarSearch<Neighborhood>();
+  return finishSearch();
+}
+
+/* ----------------------------------------------------------------*/
+/**
+ * @brief  Distance of the neighborhood (Manhattan or octile), raised to the
+ *          landmark bound when tables are in use and scaled by the cheapest
+ *          terrain
+ *
+ * @param position
+ * @param target
+ *
+ * @return double , Hcost value
+ */
+/* ----------------------------------------------------------------*/
+template <class Neighborhood>
+double optimalPlanner::heuristic(std::pair<int, int> position,
+                                 std::pair<int, int> target) {
+  double hcost = Neighborhood::distance(abs(position.first - target.first),
+                                        abs(position.second - target.second));
+  if (this->use_landmarks_) {
+    // both bounds are admissible, the larger one is the better guess
+    hcost = std::max(hcost, this->landmarks_->estimate(
+                                this->world_map_.toIndex(position),
+                                this->world_map_.toIndex(target)));
+  }
+  // every step costs at least 1 + the lowest terrain cost
+  return hcost * this->heuristic_scale_;
+}
+
+/* ----------------------------------------------------------------*/
+/**
+ * @brief  Astar over the open list prepared by search, expanding the moves
+ *          of the neighborhood policy in one loop over its tables.
+ *
+ *          The goal is taken as soon as it is reached when every way into
+ *          it costs what the heuristic predicts from the neighbor, then the
+ *          first way found is a cheapest one. Otherwise (diagonal moves
+ *          into a goal costlier than the cheapest terrain) the path is only
+ *          known to be optimal once the goal leaves the open list.
+ */
+/* ----------------------------------------------------------------*/
+template <class Neighborhood> void optimalPlanner::astarSearch() {
+  int goal_index = this->world_map_.toIndex(this->goal_position_);
+  bool stop_on_reach =
+      Neighborhood::UNIFORM || stepCost(goal_index) == this->heuristic_scale_;
+  while (!isOpenListEmpty()) {
+    std::pair<int, int> current = popOpenList();
+    int index = this->world_map_.toIndex(current);
+    // the set keeps stale entries of improved nodes, skip them
+    if (this->context_.isClosed(index)) {
+      this->stats_.countStalePop();
+      continue;
+    }
+    this->context_.close(index);
+    this->expanded_nodes_++;
+    if (index == goal_index) {
+      this->found_goal = true;
+      trackPath();
+      return;
+    }
+    float g_current = this->context_.getGCost(index);
+    for (int k = 0; k < Neighborhood::SIZE; k++) {
+      int dy = Neighborhood::DY[k];
+      int dx = Neighborhood::DX[k];
+      std::pair<int, int> child(current.first + dy, current.second + dx);
+      if (!isValid(child)) {
+        continue;
+      }
+      // a diagonal step must not squeeze between two obstacles or clip
+      // the corner of one
+      if (!Neighborhood::CUT_CORNERS && dy != 0 && dx != 0 &&
+          (!isFree(current.first + dy, current.second) ||
+           !isFree(current.first, current.second + dx))) {
+        continue;
+      }
+      int child_index = this->world_map_.toIndex(child);
+      float g_new = g_current + Neighborhood::COST[k] * stepCost(child_index);
+      if (child_index == goal_index && stop_on_reach) {
+        this->context_.reach(child_index, g_new, index);
+        this->found_goal = true;
+        trackPath();
+        return;
+      }
+      // h is the same for every way into the location, so comparing g is
+      // enough (unreached cells are FLT_MAX)
+      float g_old = this->context_.getGCost(child_index);
+      if (this->context_.isClosed(child_index) || isBlocked(child) ||
+          !(g_new < g_old)) {
+        continue;
+      }
+      if (g_old < FLT_MAX) {
+        this->stats_.countReopening();
+      }
+      pushOpenList(g_new + heuristic<Neighborhood>(child, this->goal_position_),
+                   child);
+      this->context_.reach(child_index, g_new, index);
+    }
+  }
+}
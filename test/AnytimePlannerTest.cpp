@@ -0,0 +1,117 @@
+/* Copyright (C)
+ * 2019 - Bhargav Dandamudi
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the 'Software'), to deal in the Software without
+ * restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit
+ * persons to whom the Software is furnished to do so,subject to
+ * the following conditions:
+ * The above copyright notice and this permission notice shall
+ * be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED ''AS IS'', WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR
+ * ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM,OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+/**
+ * @file AnytimePlannerTest.cpp
+ * @brief  Test the ARA* passes, their bounds and the deadline
+ * @author Bhargav Dandamudi
+ * @version 1
+ * @date 2019-04-21
+ */
+#include "../bench/benchMaps.h"
+#include "../include/AnytimePlanner.h"
+#include "../include/OccupancyGrid.h"
+#include "../include/optimalPlanner.h"
+#include <gtest/gtest.h>
+
+TEST(anytimeTest, convergesToOptimalPath) {
+  OccupancyGrid grid(roomMap(64, 12, 8));
+  optimalPlanner astar;
+  std::pair<int, int> start(0, 63), goal(63, 0);
+  size_t optimal = astar.search(grid, start, goal).size();
+  AnytimePlanner planner(3.0, 0.5);
+  std::vector<double> bounds;
+  planner.setSolutionCallback(
+      [&](const std::stack<std::pair<int, int>> &path, double bound) {
+        // every path keeps its promise
+        EXPECT_LE(double(path.size() - 1), bound * double(optimal - 1) + 1e-9);
+        EXPECT_EQ(path.top(), start);
+        bounds.push_back(bound);
+      });
+  std::stack<std::pair<int, int>> path = planner.search(
+      grid, start, goal,
+      std::chrono::steady_clock::now() + std::chrono::seconds(10));
+  EXPECT_EQ(path.size(), optimal);
+  EXPECT_EQ(planner.getSuboptimalityBound(), 1.0);
+  ASSERT_FALSE(bounds.empty());
+  EXPECT_EQ(int(bounds.size()), planner.getCompletedSearches());
+  for (size_t i = 1; i < bounds.size(); i++) {
+    EXPECT_LE(bounds[i], bounds[i - 1]);
+  }
+}
+
+TEST(anytimeTest, reusesStateAcrossQueries) {
+  OccupancyGrid grid(randomObstacleMap(40, 0.25, 2));
+  optimalPlanner astar;
+  AnytimePlanner planner(2.0, 0.25);
+  for (int y = 0; y < 40; y += 13) {
+    std::pair<int, int> start(y, 0), goal(39, 39);
+    if (grid.isOccupied(grid.toIndex(start))) {
+      continue;
+    }
+    std::stack<std::pair<int, int>> path = planner.search(
+        grid, start, goal,
+        std::chrono::steady_clock::now() + std::chrono::seconds(10));
+    EXPECT_EQ(path.size(), astar.search(grid, start, goal).size());
+  }
+}
+
+TEST(anytimeTest, stepWithoutProgressJumpsToOptimal) {
+  OccupancyGrid grid(roomMap(64, 12, 8));
+  optimalPlanner astar;
+  std::pair<int, int> start(0, 63), goal(63, 0);
+  for (double step : {0.0, -1.0}) {
+    AnytimePlanner planner(3.0, step);
+    std::stack<std::pair<int, int>> path = planner.search(
+        grid, start, goal,
+        std::chrono::steady_clock::now() + std::chrono::seconds(10));
+    EXPECT_EQ(path.size(), astar.search(grid, start, goal).size());
+    EXPECT_EQ(planner.getSuboptimalityBound(), 1.0);
+    EXPECT_LE(planner.getCompletedSearches(), 2);
+  }
+}
+
+TEST(anytimeTest, deadlineAlreadyPassed) {
+  OccupancyGrid grid(roomMap(256, 16, 1));
+  AnytimePlanner planner;
+  std::stack<std::pair<int, int>> path =
+      planner.search(grid, std::make_pair(0, 255), std::make_pair(255, 0),
+                     std::chrono::steady_clock::now());
+  EXPECT_EQ(path.size(), 1u);
+  EXPECT_EQ(planner.getCompletedSearches(), 0);
+  EXPECT_GT(planner.getSuboptimalityBound(), 1e30);
+}
+
+TEST(anytimeTest, unreachableGoal) {
+  OccupancyGrid grid(openMap(16));
+  for (int x = 0; x < 16; x++) {
+    grid.setValue(grid.toIndex(std::make_pair(8, x)), 1);
+  }
+  AnytimePlanner planner;
+  std::stack<std::pair<int, int>> path = planner.search(
+      grid, std::make_pair(0, 0), std::make_pair(15, 15),
+      std::chrono::steady_clock::now() + std::chrono::seconds(1));
+  EXPECT_EQ(path.size(), 1u);
+  EXPECT_EQ(planner.getCompletedSearches(), 0);
+}
@@ -0,0 +1,110 @@
+/* Copyright (C)
+ * 2019 - Bhargav Dandamudi
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the 'Software'), to deal in the Software without
+ * restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit
+ * persons to whom the Software is furnished to do so,subject to
+ * the following conditions:
+ * The above copyright notice and this permission notice shall
+ * be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED ''AS IS'', WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR
+ * ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM,OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+/**
+ * @file BatchPlannerTest.cpp
+ * @brief  Test batch planning on the worker pool against serial searches
+ * @author Bhargav Dandamudi
+ * @version 1
+ * @date 2019-04-16
+ */
+#include "../include/BatchPlanner.h"
+#include <gtest/gtest.h>
+#include <random>
+
+// seeded random map with a set of queries between free cells
+static OccupancyGrid batchMap(std::vector<PlanQuery> &queries) {
+  std::mt19937 generator(5);
+  std::bernoulli_distribution obstacle(0.2);
+  OccupancyGrid grid(40, 50);
+  for (int i = 0; i < grid.getCellCount(); i++) {
+    grid.setValue(i, obstacle(generator) ? 1 : 0);
+  }
+  std::uniform_int_distribution<int> cell(0, grid.getCellCount() - 1);
+  while (queries.size() < 64) {
+    int start = cell(generator);
+    int goal = cell(generator);
+    if (!grid.isOccupied(start) && !grid.isOccupied(goal) && start != goal) {
+      queries.push_back(
+          std::make_pair(grid.toPosition(start), grid.toPosition(goal)));
+    }
+  }
+  return grid;
+}
+
+TEST(batchTest, resultsInQueryOrder) {
+  std::vector<PlanQuery> queries;
+  OccupancyGrid grid = batchMap(queries);
+  BatchPlanner batch(4);
+  EXPECT_EQ(batch.getThreadCount(), 4);
+  std::vector<PlanResult> results = batch.planBatch(grid, queries);
+  ASSERT_EQ(results.size(), queries.size());
+  optimalPlanner serial;
+  for (int i = 0; i < int(queries.size()); i++) {
+    PlanResult expected =
+        serial.plan(grid, queries[i].first, queries[i].second);
+    EXPECT_EQ(results[i].status, expected.status) << "query " << i;
+    EXPECT_EQ(results[i].path, expected.path) << "query " << i;
+  }
+}
+
+TEST(batchTest, poolIsReusedAcrossBatches) {
+  std::vector<PlanQuery> queries;
+  OccupancyGrid grid = batchMap(queries);
+  BatchPlanner batch(3);
+  batch.setSearchMode(SearchMode::JUMP_POINT);
+  std::vector<PlanResult> first = batch.planBatch(grid, queries);
+  std::vector<PlanResult> second = batch.planBatch(grid, queries);
+  EXPECT_EQ(first.size(), second.size());
+  for (int i = 0; i < int(first.size()); i++) {
+    EXPECT_EQ(first[i].status, second[i].status);
+    EXPECT_EQ(first[i].path.size(), second[i].path.size());
+  }
+  EXPECT_TRUE(batch.planBatch(grid, std::vector<PlanQuery>()).empty());
+}
+
+TEST(batchTest, failedQueriesTellWhy) {
+  std::vector<PlanQuery> queries;
+  OccupancyGrid grid = batchMap(queries);
+  // wall the first goal in, and add a query leaving the map
+  std::pair<int, int> goal = queries[0].second;
+  for (int dy = -1; dy <= 1; dy++) {
+    for (int dx = -1; dx <= 1; dx++) {
+      std::pair<int, int> cell(goal.first + dy, goal.second + dx);
+      if ((dy != 0 || dx != 0) && grid.isInside(cell)) {
+        grid.setValue(grid.toIndex(cell), 1);
+      }
+    }
+  }
+  queries.push_back(PlanQuery(queries[1].first, std::make_pair(40, 0)));
+  queries.push_back(PlanQuery(queries[1].first, queries[1].first));
+  BatchPlanner batch(2);
+  std::vector<PlanResult> results = batch.planBatch(grid, queries);
+  ASSERT_EQ(results.size(), queries.size());
+  EXPECT_EQ(results[0].status, PlanStatus::UNREACHABLE);
+  EXPECT_TRUE(results[0].path.empty());
+  EXPECT_EQ(results[queries.size() - 2].status, PlanStatus::INVALID_GOAL);
+  EXPECT_TRUE(results[queries.size() - 1].found());
+  EXPECT_EQ(results[queries.size() - 1].path.size(), 1u);
+}
@@ -0,0 +1,107 @@
+/* Copyright (C)
+ * 2019 - Bhargav Dandamudi
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the 'Software'), to deal in the Software without
+ * restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit
+ * persons to whom the Software is furnished to do so,subject to
+ * the following conditions:
+ * The above copyright notice and this permission notice shall
+ * be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED ''AS IS'', WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR
+ * ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM,OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+/**
+ * @file BidirectionalTest.cpp
+ * @brief  Test bidirectional search on one and two threads against astar
+ * @author Bhargav Dandamudi
+ * @version 1
+ * @date 2019-04-15
+ */
+#include "../include/optimalPlanner.h"
+#include <gtest/gtest.h>
+#include <random>
+
+// number of steps of a path, checks that every step is an orthogonal move
+// onto a free cell
+static int stepCount(std::stack<std::pair<int, int>> path,
+                     const OccupancyGrid &grid) {
+  int steps = 0;
+  std::pair<int, int> last = path.top();
+  path.pop();
+  while (!path.empty()) {
+    std::pair<int, int> next = path.top();
+    path.pop();
+    EXPECT_EQ(abs(next.first - last.first) + abs(next.second - last.second),
+              1);
+    EXPECT_FALSE(grid.isOccupied(grid.toIndex(next)));
+    last = next;
+    steps++;
+  }
+  return steps;
+}
+
+static void compareWithAstar(bool parallel) {
+  std::mt19937 generator(11);
+  for (int trial = 0; trial < 30; trial++) {
+    std::bernoulli_distribution obstacle(0.05 + 0.01 * trial);
+    OccupancyGrid grid(27, 33);
+    for (int i = 0; i < grid.getCellCount(); i++) {
+      grid.setValue(i, obstacle(generator) ? 1 : 0);
+    }
+    std::pair<int, int> start = std::make_pair(trial % 27, 0);
+    std::pair<int, int> goal = std::make_pair(26 - trial % 27, 32);
+    grid.setValue(grid.toIndex(start), 0);
+    grid.setValue(grid.toIndex(goal), 0);
+
+    optimalPlanner astar;
+    optimalPlanner bidirectional;
+    bidirectional.setSearchMode(SearchMode::BIDIRECTIONAL);
+    bidirectional.setParallelFrontiers(parallel);
+    std::stack<std::pair<int, int>> expected = astar.search(grid, start, goal);
+    std::stack<std::pair<int, int>> path =
+        bidirectional.search(grid, start, goal);
+    EXPECT_EQ(path.size(), expected.size()) << "trial " << trial;
+    EXPECT_EQ(path.top(), start);
+    stepCount(path, grid);
+  }
+}
+
+TEST(bidirectionalTest, matchesAstarSingleThread) { compareWithAstar(false); }
+
+TEST(bidirectionalTest, matchesAstarTwoThreads) { compareWithAstar(true); }
+
+TEST(bidirectionalTest, pathEndsAtGoal) {
+  OccupancyGrid grid(40, 40);
+  optimalPlanner planner;
+  planner.setSearchMode(SearchMode::BIDIRECTIONAL);
+  std::stack<std::pair<int, int>> path =
+      planner.search(grid, std::make_pair(3, 5), std::make_pair(30, 21));
+  EXPECT_EQ(stepCount(path, grid), 27 + 16);
+  while (path.size() > 1) {
+    path.pop();
+  }
+  EXPECT_EQ(path.top(), std::make_pair(30, 21));
+}
+
+TEST(bidirectionalTest, startIsGoal) {
+  OccupancyGrid grid(5, 5);
+  optimalPlanner planner;
+  planner.setSearchMode(SearchMode::BIDIRECTIONAL);
+  planner.setParallelFrontiers(true);
+  EXPECT_TRUE(planner.getParallelFrontiers());
+  std::stack<std::pair<int, int>> path =
+      planner.search(grid, std::make_pair(2, 2), std::make_pair(2, 2));
+  EXPECT_EQ(path.size(), 1u);
+}
@@ -0,0 +1,161 @@
+/* Copyright (C)
+ * 2019 - Bhargav Dandamudi
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the 'Software'), to deal in the Software without
+ * restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit
+ * persons to whom the Software is furnished to do so,subject to
+ * the following conditions:
+ * The above copyright notice and this permission notice shall
+ * be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED ''AS IS'', WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR
+ * ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM,OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+/**
+ * @file BitWavefrontTest.cpp
+ * @brief  Test the bit parallel wavefronts against the cell by cell ones
+ * @author Bhargav Dandamudi
+ * @version 1
+ * @date 2019-04-25
+ */
+#include "../bench/benchMaps.h"
+#include "../include/BitWavefront.h"
+#include "../include/FlowField.h"
+#include "../include/MapFile.h"
+#include "../include/OccupancyGrid.h"
+#include "../include/optimalPlanner.h"
+#include <cstdio>
+#include <gtest/gtest.h>
+
+// random map of 77 x 130 cells, rows end in the middle of a word
+static std::vector<std::vector<int>> oddMap(unsigned seed) {
+  std::vector<std::vector<int>> map = randomObstacleMap(130, 0.3, seed);
+  map.resize(77);
+  return map;
+}
+
+TEST(bitWavefrontTest, distancesMatchFlowField) {
+  for (CellStorage storage : {CellStorage::BYTE, CellStorage::BIT}) {
+    for (unsigned seed = 1; seed <= 3; seed++) {
+      OccupancyGrid grid(oddMap(seed), storage);
+      BitWavefront wavefront(grid);
+      std::pair<int, int> goal(40, 64);
+      grid.setValue(grid.toIndex(goal), 0);
+      wavefront.updateCells({goal});
+      FlowField field;
+      field.build(grid, goal, 1);
+      std::vector<uint32_t> distance;
+      int reached = wavefront.distances(goal, distance);
+      int expected_reached = 0;
+      for (int i = 0; i < grid.getCellCount(); i++) {
+        ASSERT_EQ(distance[i], field.getDistance(grid.toPosition(i))) << i;
+        expected_reached += distance[i] != BitWavefront::UNREACHABLE;
+      }
+      EXPECT_EQ(reached, expected_reached);
+      // point queries on the same object reuse its scratch buffers
+      for (int i = 0; i < grid.getCellCount(); i += 97) {
+        std::pair<int, int> start = grid.toPosition(i);
+        int steps = wavefront.getDistance(start, goal);
+        if (distance[i] == BitWavefront::UNREACHABLE) {
+          EXPECT_EQ(steps, -1);
+          EXPECT_FALSE(wavefront.isReachable(start, goal));
+        } else {
+          EXPECT_EQ(steps, int(distance[i]));
+          EXPECT_TRUE(wavefront.isReachable(start, goal));
+        }
+      }
+    }
+  }
+}
+
+TEST(bitWavefrontTest, updatesFollowTheMap) {
+  OccupancyGrid grid(openMap(70));
+  BitWavefront wavefront(grid);
+  std::pair<int, int> start(0, 0);
+  std::pair<int, int> goal(0, 69);
+  EXPECT_EQ(wavefront.getDistance(start, goal), 69);
+  EXPECT_EQ(wavefront.getDistance(start, start), 0);
+  // a wall across the map, across the word border at column 64
+  std::vector<std::pair<int, int>> wall;
+  for (int y = 0; y < 70; y++) {
+    wall.push_back(std::make_pair(y, 64));
+    grid.setValue(grid.toIndex(wall.back()), 1);
+  }
+  wavefront.updateCells(wall);
+  EXPECT_FALSE(wavefront.isReachable(start, goal));
+  EXPECT_EQ(wavefront.getDistance(start, wall[0]), -1);
+  // a door at the bottom
+  grid.setValue(grid.toIndex(wall.back()), 0);
+  wavefront.updateCells({wall.back(), std::make_pair(70, 0),
+                         std::make_pair(0, -1), std::make_pair(-1, 64)});
+  EXPECT_TRUE(wavefront.isReachable(start, goal));
+  EXPECT_EQ(wavefront.getDistance(start, goal), 69 + 2 * 69);
+}
+
+TEST(bitWavefrontTest, plannerChecksReachabilityFirst) {
+  OccupancyGrid grid(openMap(64));
+  // a wall around the goal corner
+  for (int i = 0; i < 8; i++) {
+    grid.setValue(grid.toIndex(std::make_pair(55, 56 + i)), 1);
+    grid.setValue(grid.toIndex(std::make_pair(56 + i, 55)), 1);
+  }
+  grid.setValue(grid.toIndex(std::make_pair(55, 55)), 1);
+  optimalPlanner planner, plain_planner;
+  planner.setReachabilityCheck(true);
+  EXPECT_TRUE(planner.getReachabilityCheck());
+  std::pair<int, int> start(0, 0), goal(63, 63);
+  EXPECT_EQ(planner.search(grid, start, goal).size(), 1u);
+  EXPECT_EQ(planner.getStatus(), PlanStatus::UNREACHABLE);
+  EXPECT_EQ(planner.getExpandedNodes(), 0);
+  plain_planner.search(grid, start, goal);
+  EXPECT_GT(plain_planner.getExpandedNodes(), 4000);
+
+  // a gap makes a new map version, which is packed again
+  grid.setValue(grid.toIndex(std::make_pair(55, 60)), 0);
+  EXPECT_EQ(planner.search(grid, start, goal).size(),
+            plain_planner.search(grid, start, goal).size());
+  EXPECT_EQ(planner.getStatus(), PlanStatus::SUCCESS);
+}
+
+TEST(bitWavefrontTest, plannerPacksMappedFilesOncePerOpen) {
+  OccupancyGrid grid(openMap(64), CellStorage::BIT);
+  for (int i = 0; i < 8; i++) {
+    grid.setValue(grid.toIndex(std::make_pair(55, 56 + i)), 1);
+    grid.setValue(grid.toIndex(std::make_pair(56 + i, 55)), 1);
+  }
+  grid.setValue(grid.toIndex(std::make_pair(55, 55)), 1);
+  std::string file_name = "bit_wavefront_test.gmap";
+  ASSERT_TRUE(MapFile::save(file_name, grid));
+  MapFile map;
+  ASSERT_TRUE(map.open(file_name));
+  ASSERT_NE(map.getView().getVersion(), 0u);
+  optimalPlanner planner;
+  planner.setReachabilityCheck(true);
+  std::pair<int, int> start(0, 0), goal(63, 63);
+  for (int round = 0; round < 2; round++) {
+    EXPECT_EQ(planner.search(map.getView(), start, goal).size(), 1u);
+    EXPECT_EQ(planner.getStatus(), PlanStatus::UNREACHABLE);
+    EXPECT_EQ(planner.getExpandedNodes(), 0);
+  }
+
+  // the reopened file with a gap is a new version, packed again
+  grid.setValue(grid.toIndex(std::make_pair(55, 60)), 0);
+  ASSERT_TRUE(MapFile::save(file_name, grid));
+  ASSERT_TRUE(map.open(file_name));
+  EXPECT_EQ(planner.search(map.getView(), start, goal).size(),
+            optimalPlanner().search(grid, start, goal).size());
+  EXPECT_EQ(planner.getStatus(), PlanStatus::SUCCESS);
+  map.close();
+  std::remove(file_name.c_str());
+}
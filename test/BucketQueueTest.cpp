@@ -0,0 +1,85 @@
+/* Copyright (C)
+ * 2019 - Bhargav Dandamudi
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the 'Software'), to deal in the Software without
+ * restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit
+ * persons to whom the Software is furnished to do so,subject to
+ * the following conditions:
+ * The above copyright notice and this permission notice shall
+ * be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED ''AS IS'', WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR
+ * ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM,OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+/**
+ * @file BucketQueueTest.cpp
+ * @brief  Test the bucket queue and the planner using it as open list
+ * @author Bhargav Dandamudi
+ * @version 1
+ * @date 2019-04-22
+ */
+#include "../bench/benchMaps.h"
+#include "../include/BucketQueue.h"
+#include "../include/optimalPlanner.h"
+#include <gtest/gtest.h>
+
+TEST(bucketTest, popsLowestBucketLastInFirst) {
+  BucketQueue queue;
+  queue.push(3, 5);
+  queue.push(7, 2);
+  queue.push(1, 5);
+  queue.push(9, 2);
+  EXPECT_EQ(queue.size(), 4);
+  EXPECT_EQ(queue.topPriority(), 2);
+  EXPECT_EQ(queue.pop(), 9);
+  EXPECT_EQ(queue.pop(), 7);
+  queue.push(4, 3); // above the cursor
+  queue.push(6, 1); // below the cursor
+  EXPECT_EQ(queue.pop(), 6);
+  EXPECT_EQ(queue.pop(), 4);
+  EXPECT_EQ(queue.pop(), 1);
+  EXPECT_EQ(queue.pop(), 3);
+  ASSERT_TRUE(queue.empty());
+}
+
+TEST(bucketTest, clearKeepsQueueUsable) {
+  BucketQueue queue;
+  queue.push(0, 10);
+  queue.push(1, 40);
+  queue.clear();
+  ASSERT_TRUE(queue.empty());
+  queue.push(2, 7);
+  EXPECT_EQ(queue.topPriority(), 7);
+  EXPECT_EQ(queue.pop(), 2);
+}
+
+TEST(bucketTest, plannerPathsMatchHeap) {
+  optimalPlanner heap_planner;
+  optimalPlanner bucket_planner;
+  bucket_planner.setOpenListType(OpenListType::BUCKET_QUEUE);
+  for (unsigned seed = 1; seed <= 10; seed++) {
+    OccupancyGrid grid(randomObstacleMap(48, 0.25, seed));
+    std::pair<int, int> start(0, 0), goal(47, 47);
+    EXPECT_EQ(bucket_planner.search(grid, start, goal).size(),
+              heap_planner.search(grid, start, goal).size());
+  }
+  bucket_planner.setSearchMode(SearchMode::JUMP_POINT);
+  OccupancyGrid rooms(roomMap(64, 16, 2));
+  EXPECT_EQ(bucket_planner
+                .search(rooms, std::make_pair(0, 0), std::make_pair(63, 63))
+                .size(),
+            heap_planner
+                .search(rooms, std::make_pair(0, 0), std::make_pair(63, 63))
+                .size());
+}
@@ -0,0 +1,160 @@
+/* Copyright (C)
+ * 2019 - Bhargav Dandamudi
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the 'Software'), to deal in the Software without
+ * restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit
+ * persons to whom the Software is furnished to do so,subject to
+ * the following conditions:
+ * The above copyright notice and this permission notice shall
+ * be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED ''AS IS'', WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR
+ * ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM,OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+/**
+ * @file ComponentIndexTest.cpp
+ * @brief  Test region labels, their incremental updates and the early exit
+ * @author Bhargav Dandamudi
+ * @version 1
+ * @date 2019-04-20
+ */
+#include "../bench/benchMaps.h"
+#include "../include/ComponentIndex.h"
+#include "../include/OccupancyGrid.h"
+#include "../include/RandomPlanner.h"
+#include "../include/optimalPlanner.h"
+#include <gtest/gtest.h>
+#include <map>
+
+// true if both indices split the free cells into the same regions
+static bool samePartition(const ComponentIndex &a, const ComponentIndex &b) {
+  if (a.getComponentCount() != b.getComponentCount()) {
+    return false;
+  }
+  std::map<int, int> a_to_b;
+  for (int i = 0; i < a.getCellCount(); i++) {
+    if ((a.getLabel(i) == -1) != (b.getLabel(i) == -1)) {
+      return false;
+    }
+    if (a.getLabel(i) == -1) {
+      continue;
+    }
+    auto found = a_to_b.insert(std::make_pair(a.getLabel(i), b.getLabel(i)));
+    if (found.first->second != b.getLabel(i) ||
+        a.getComponentSize(a.getLabel(i)) !=
+            b.getComponentSize(b.getLabel(i))) {
+      return false;
+    }
+  }
+  return int(a_to_b.size()) == b.getComponentCount();
+}
+
+TEST(componentTest, labelsRegions) {
+  std::vector<std::vector<int>> map{
+      {0, 0, 1, 0}, {0, 0, 1, 0}, {1, 1, 1, 0}, {0, 1, 0, 0}};
+  OccupancyGrid grid(map);
+  ComponentIndex index(grid);
+  EXPECT_EQ(index.getComponentCount(), 3);
+  ASSERT_TRUE(index.isConnected(std::make_pair(0, 0), std::make_pair(1, 1)));
+  ASSERT_TRUE(index.isConnected(std::make_pair(0, 3), std::make_pair(3, 2)));
+  ASSERT_FALSE(index.isConnected(std::make_pair(0, 0), std::make_pair(0, 3)));
+  ASSERT_FALSE(index.isConnected(std::make_pair(3, 0), std::make_pair(1, 1)));
+  ASSERT_FALSE(index.isConnected(std::make_pair(0, 2), std::make_pair(0, 2)));
+  EXPECT_EQ(index.getLabel(grid.toIndex(std::make_pair(2, 0))), -1);
+  EXPECT_EQ(index.getComponentSize(index.getLabel(0)), 4);
+}
+
+TEST(componentTest, updatesMatchRebuild) {
+  OccupancyGrid grid(randomObstacleMap(24, 0.4, 9));
+  ComponentIndex index(grid);
+  std::mt19937 generator(3);
+  std::uniform_int_distribution<int> coordinate(0, 23);
+  for (int round = 0; round < 300; round++) {
+    std::vector<std::pair<int, int>> changed;
+    for (int c = 0; c < 1 + round % 3; c++) {
+      std::pair<int, int> cell(coordinate(generator), coordinate(generator));
+      int index_of_cell = grid.toIndex(cell);
+      grid.setValue(index_of_cell, 1 - grid.getValue(index_of_cell));
+      changed.push_back(cell);
+    }
+    // cells outside the map are skipped
+    changed.push_back(std::make_pair(-1, round % 24));
+    changed.push_back(std::make_pair(round % 24, 24));
+    index.updateCells(changed, grid.getVersion());
+    ASSERT_TRUE(samePartition(index, ComponentIndex(grid))) << round;
+  }
+}
+
+TEST(componentTest, plannersRejectUnreachableGoal) {
+  OccupancyGrid grid(openMap(64));
+  for (int x = 0; x < 64; x++) {
+    grid.setValue(grid.toIndex(std::make_pair(32, x)), 1);
+  }
+  std::shared_ptr<ComponentIndex> index(new ComponentIndex(grid));
+  optimalPlanner planner;
+  planner.setComponentIndex(index);
+  std::stack<std::pair<int, int>> path =
+      planner.search(grid, std::make_pair(0, 0), std::make_pair(63, 63));
+  EXPECT_EQ(path.size(), 1u);
+  EXPECT_EQ(planner.getExpandedNodes(), 0);
+
+  RandomPlanner random_planner;
+  random_planner.setComponentIndex(index);
+  EXPECT_EQ(random_planner
+                .search(GridView(grid), std::make_pair(0, 0),
+                        std::make_pair(63, 63))
+                .size(),
+            1u);
+
+  // opening the wall makes the goal reachable again
+  grid.setValue(grid.toIndex(std::make_pair(32, 10)), 0);
+  index->updateCells({std::make_pair(32, 10)}, grid.getVersion());
+  path = planner.search(grid, std::make_pair(0, 0), std::make_pair(63, 63));
+  EXPECT_EQ(path.size(), 127u);
+}
+
+TEST(componentTest, indexOfAnotherMapIsIgnored) {
+  // the wall splits the walled map, the open maps have one region
+  OccupancyGrid walled(
+      std::vector<std::vector<int>>{{0, 1, 0}, {0, 1, 0}, {0, 1, 0}});
+  OccupancyGrid open(openMap(3));
+  OccupancyGrid wide(std::vector<std::vector<int>>{{0, 1, 0}, {0, 1, 0}});
+  OccupancyGrid tall(std::vector<std::vector<int>>{{0, 0}, {0, 0}, {0, 0}});
+  optimalPlanner planner;
+  planner.setComponentIndex(std::make_shared<ComponentIndex>(walled));
+  EXPECT_EQ(planner.plan(open, std::make_pair(0, 0), std::make_pair(0, 2))
+                .status,
+            PlanStatus::SUCCESS);
+  EXPECT_EQ(planner.plan(walled, std::make_pair(0, 0), std::make_pair(0, 2))
+                .status,
+            PlanStatus::UNREACHABLE);
+  planner.setComponentIndex(std::make_shared<ComponentIndex>(wide));
+  EXPECT_EQ(planner.plan(tall, std::make_pair(0, 0), std::make_pair(2, 1))
+                .status,
+            PlanStatus::SUCCESS);
+
+  RandomPlanner random_planner;
+  random_planner.setComponentIndex(std::make_shared<ComponentIndex>(walled));
+  random_planner.search(GridView(open), std::make_pair(0, 0),
+                        std::make_pair(0, 2));
+  EXPECT_NE(random_planner.getStatus(), PlanStatus::UNREACHABLE);
+
+  // a changed map is trusted again once the index followed the change
+  ComponentIndex index(walled);
+  walled.setValue(walled.toIndex(std::make_pair(1, 1)), 0);
+  EXPECT_FALSE(index.matches(walled));
+  index.updateCells({std::make_pair(1, 1)}, walled.getVersion());
+  EXPECT_TRUE(index.matches(walled));
+  EXPECT_TRUE(index.isConnected(std::make_pair(0, 0), std::make_pair(0, 2)));
+}
@@ -0,0 +1,170 @@
+/* Copyright (C)
+ * 2019 - Bhargav Dandamudi
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the 'Software'), to deal in the Software without
+ * restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit
+ * persons to whom the Software is furnished to do so,subject to
+ * the following conditions:
+ * The above copyright notice and this permission notice shall
+ * be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED ''AS IS'', WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR
+ * ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM,OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+/**
+ * @file CostMapTest.cpp
+ * @brief  Test the terrain cost kernels and weighted planning
+ * @author Bhargav Dandamudi
+ * @version 1
+ * @date 2019-04-23
+ */
+#include "../bench/benchMaps.h"
+#include "../include/CostMap.h"
+#include "../include/OccupancyGrid.h"
+#include "../include/optimalPlanner.h"
+#include <algorithm>
+#include <cstdlib>
+#include <gtest/gtest.h>
+#include <queue>
+
+// cost of the cheapest path with Dijkstra, -1 if there is none
+static int cheapestCost(const OccupancyGrid &grid, const CostMap &costs,
+                        int start, int goal) {
+  int width = grid.getWidth();
+  std::vector<int> distance(grid.getCellCount(), -1);
+  typedef std::pair<int, int> Entry;
+  std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> open;
+  open.push(std::make_pair(0, start));
+  while (!open.empty()) {
+    Entry entry = open.top();
+    open.pop();
+    if (distance[entry.second] != -1) {
+      continue;
+    }
+    distance[entry.second] = entry.first;
+    std::pair<int, int> position = grid.toPosition(entry.second);
+    std::pair<int, int> sides[4] = {
+        std::make_pair(position.first - 1, position.second),
+        std::make_pair(position.first + 1, position.second),
+        std::make_pair(position.first, position.second - 1),
+        std::make_pair(position.first, position.second + 1)};
+    for (const auto &side : sides) {
+      if (!grid.isInside(side)) {
+        continue;
+      }
+      int cell = side.first * width + side.second;
+      if (!grid.isOccupied(cell) && !costs.isLethal(cell) &&
+          distance[cell] == -1) {
+        open.push(std::make_pair(entry.first + 1 + costs.getCost(cell), cell));
+      }
+    }
+  }
+  return distance[goal];
+}
+
+static int pathCost(std::stack<std::pair<int, int>> path,
+                    const CostMap &costs, int width) {
+  int total = 0;
+  path.pop(); // the start is not entered
+  while (!path.empty()) {
+    total += 1 + costs.getCost(path.top().first * width + path.top().second);
+    path.pop();
+  }
+  return total;
+}
+
+TEST(costMapTest, inflateMatchesReference) {
+  // 37 columns, two vector blocks and a scalar tail per row
+  CostMap costs(23, 37);
+  std::mt19937 generator(5);
+  std::uniform_int_distribution<int> cell(0, 23 * 37 - 1);
+  for (int i = 0; i < 12; i++) {
+    costs.setCost(cell(generator), CostMap::LETHAL);
+  }
+  costs.setCost(40, 100);
+  CostMap inflated = costs;
+  inflated.inflate(4, 60);
+  for (int i = 0; i < costs.getCellCount(); i++) {
+    int nearest = 1000;
+    for (int j = 0; j < costs.getCellCount(); j++) {
+      if (costs.isLethal(j)) {
+        nearest = std::min(nearest,
+                           abs(i / 37 - j / 37) + abs(i % 37 - j % 37));
+      }
+    }
+    int expected = costs.getCost(i);
+    if (!costs.isLethal(i) && nearest <= 4) {
+      expected =
+          std::max(expected, std::min(254, std::max(0, 255 - nearest * 60)));
+    }
+    ASSERT_EQ(int(inflated.getCost(i)), expected) << i;
+  }
+}
+
+TEST(costMapTest, minCostFollowsUpdates) {
+  CostMap costs(4, 40, 7);
+  EXPECT_EQ(costs.getMinCost(), 7);
+  costs.setCost(5, 3);
+  EXPECT_EQ(costs.getMinCost(), 3);
+  costs.setCost(5, 9);
+  EXPECT_EQ(costs.getMinCost(), 7);
+  costs.raise(std::make_pair(0, 0), 4, 40, 20);
+  EXPECT_EQ(costs.getMinCost(), 20);
+  EXPECT_EQ(costs.getCost(5), 20);
+  costs.fill(std::make_pair(1, 2), 2, 35, 0);
+  EXPECT_EQ(costs.getMinCost(), 0);
+  EXPECT_EQ(costs.getCost(1 * 40 + 36), 0);
+  EXPECT_EQ(costs.getCost(1 * 40 + 37), 20);
+}
+
+TEST(costMapTest, zeroCostsKeepUnitPaths) {
+  OccupancyGrid grid(randomObstacleMap(40, 0.2, 3));
+  optimalPlanner plain, weighted;
+  weighted.setCostMap(std::make_shared<const CostMap>(40, 40));
+  EXPECT_EQ(weighted.search(grid, std::make_pair(0, 0), std::make_pair(39, 39)),
+            plain.search(grid, std::make_pair(0, 0), std::make_pair(39, 39)));
+}
+
+TEST(costMapTest, weightedPathsAreCheapest) {
+  std::mt19937 generator(11);
+  std::uniform_int_distribution<int> terrain(2, 12);
+  std::bernoulli_distribution lethal(0.1);
+  for (unsigned seed = 1; seed <= 6; seed++) {
+    OccupancyGrid grid(randomObstacleMap(30, 0.15, seed));
+    std::shared_ptr<CostMap> costs = std::make_shared<CostMap>(30, 30);
+    for (int i = 0; i < costs->getCellCount(); i++) {
+      costs->setCost(i, lethal(generator) ? CostMap::LETHAL
+                                          : uint8_t(terrain(generator)));
+    }
+    costs->setCost(0, 2);
+    costs->setCost(30 * 30 - 1, 2);
+    int expected = cheapestCost(grid, *costs, 0, 30 * 30 - 1);
+    for (OpenListType type :
+         {OpenListType::QUATERNARY_HEAP, OpenListType::BUCKET_QUEUE}) {
+      for (SearchMode mode : {SearchMode::ASTAR, SearchMode::JUMP_POINT}) {
+        optimalPlanner planner;
+        planner.setCostMap(costs);
+        planner.setOpenListType(type);
+        planner.setSearchMode(mode);
+        std::stack<std::pair<int, int>> path =
+            planner.search(grid, std::make_pair(0, 0), std::make_pair(29, 29));
+        if (expected == -1) {
+          EXPECT_EQ(path.size(), 1u);
+        } else {
+          EXPECT_EQ(pathCost(path, *costs, 30), expected);
+        }
+      }
+    }
+  }
+}
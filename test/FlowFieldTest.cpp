@@ -0,0 +1,181 @@
+/* Copyright (C)
+ * 2019 - Bhargav Dandamudi
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the 'Software'), to deal in the Software without
+ * restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit
+ * persons to whom the Software is furnished to do so,subject to
+ * the following conditions:
+ * The above copyright notice and this permission notice shall
+ * be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED ''AS IS'', WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR
+ * ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM,OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+/**
+ * @file FlowFieldTest.cpp
+ * @brief  Test the goal flow fields and their cache
+ * @author Bhargav Dandamudi
+ * @version 1
+ * @date 2019-04-24
+ */
+#include "../bench/benchMaps.h"
+#include "../include/FlowField.h"
+#include "../include/FlowFieldCache.h"
+#include "../include/OccupancyGrid.h"
+#include "../include/optimalPlanner.h"
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+TEST(flowFieldTest, distancesAndPathsAreShortest) {
+  for (int threads : {1, 4}) {
+    OccupancyGrid grid(randomObstacleMap(48, 0.3, 7));
+    std::pair<int, int> goal(47, 47);
+    FlowField field;
+    field.build(grid, goal, threads);
+    EXPECT_EQ(field.getDistance(goal), 0u);
+    EXPECT_EQ(field.nextStep(goal), goal);
+    optimalPlanner planner;
+    for (int y = 0; y < 48; y += 5) {
+      for (int x = 0; x < 48; x += 3) {
+        std::pair<int, int> start(y, x);
+        if (grid.isOccupied(grid.toIndex(start))) {
+          EXPECT_EQ(field.getDistance(start), FlowField::UNREACHABLE);
+          continue;
+        }
+        std::stack<std::pair<int, int>> expected =
+            planner.search(grid, start, goal);
+        std::stack<std::pair<int, int>> path = field.path(start);
+        ASSERT_EQ(path.size(), expected.size()) << y << "," << x;
+        if (expected.size() == 1 && start != goal) {
+          EXPECT_EQ(field.getDistance(start), FlowField::UNREACHABLE);
+          continue;
+        }
+        EXPECT_EQ(field.getDistance(start), uint32_t(path.size() - 1));
+        // every step goes to a free neighbor
+        std::pair<int, int> previous = path.top();
+        EXPECT_EQ(previous, start);
+        path.pop();
+        while (!path.empty()) {
+          std::pair<int, int> cell = path.top();
+          path.pop();
+          EXPECT_EQ(abs(cell.first - previous.first) +
+                        abs(cell.second - previous.second),
+                    1);
+          EXPECT_FALSE(grid.isOccupied(grid.toIndex(cell)));
+          previous = cell;
+        }
+        EXPECT_EQ(previous, goal);
+      }
+    }
+  }
+}
+
+TEST(flowFieldTest, blockedGoalReachesNothing) {
+  OccupancyGrid grid(openMap(8));
+  grid.setValue(grid.toIndex(std::make_pair(4, 4)), 1);
+  FlowField field;
+  field.build(grid, std::make_pair(4, 4), 2);
+  EXPECT_EQ(field.getDistance(std::make_pair(0, 0)), FlowField::UNREACHABLE);
+  EXPECT_EQ(field.path(std::make_pair(0, 0)).size(), 1u);
+}
+
+TEST(flowFieldTest, cacheFollowsGoalAndVersion) {
+  OccupancyGrid grid(openMap(16));
+  FlowFieldCache cache(2, 2);
+  std::pair<int, int> dock(0, 15);
+  std::shared_ptr<const FlowField> first = cache.get(grid, dock);
+  EXPECT_EQ(cache.get(grid, dock), first);
+  EXPECT_EQ(cache.getBuildCount(), 1);
+  EXPECT_EQ(first->getDistance(std::make_pair(0, 0)), 15u);
+
+  // a wall with a gap at the bottom changes the map version and the field
+  // is built again
+  uint64_t before = grid.getVersion();
+  for (int y = 0; y < 15; y++) {
+    grid.setValue(grid.toIndex(std::make_pair(y, 8)), 1);
+  }
+  EXPECT_GT(grid.getVersion(), before);
+  std::shared_ptr<const FlowField> second = cache.get(grid, dock);
+  EXPECT_NE(second, first);
+  EXPECT_EQ(second->getDistance(std::make_pair(0, 0)), 45u);
+  EXPECT_EQ(first->getDistance(std::make_pair(0, 0)), 15u);
+  EXPECT_EQ(cache.size(), 1);
+
+  // the least recently used goal is dropped
+  cache.get(grid, std::make_pair(15, 15));
+  cache.get(grid, dock);
+  cache.get(grid, std::make_pair(15, 0));
+  EXPECT_EQ(cache.size(), 2);
+  EXPECT_EQ(cache.getBuildCount(), 4);
+  EXPECT_EQ(cache.get(grid, dock), second);
+  cache.get(grid, std::make_pair(15, 15));
+  EXPECT_EQ(cache.getBuildCount(), 5);
+  cache.clear();
+  EXPECT_EQ(cache.size(), 0);
+}
+
+TEST(flowFieldTest, cacheTellsMapsApart) {
+  // two new grids of one size, only the walled one blocks the corner
+  OccupancyGrid open(openMap(4));
+  OccupancyGrid walled(openMap(4));
+  walled.setValue(walled.toIndex(std::make_pair(3, 2)), 1);
+  walled.setValue(walled.toIndex(std::make_pair(2, 3)), 1);
+  OccupancyGrid fresh(openMap(4));
+  EXPECT_NE(open.getVersion(), fresh.getVersion());
+  FlowFieldCache cache(4, 1);
+  std::pair<int, int> goal(3, 3);
+  std::shared_ptr<const FlowField> first = cache.get(open, goal);
+  std::shared_ptr<const FlowField> second = cache.get(walled, goal);
+  EXPECT_NE(first, second);
+  EXPECT_EQ(first->getDistance(std::make_pair(0, 0)), 6u);
+  EXPECT_EQ(second->getDistance(std::make_pair(0, 0)),
+            FlowField::UNREACHABLE);
+}
+
+TEST(flowFieldTest, cacheRebuildsRawViews) {
+  OccupancyGrid grid(openMap(8));
+  // a view of a raw buffer has no version to compare
+  GridView raw(grid.getBytes(), 8, 8, 8);
+  EXPECT_EQ(raw.getVersion(), 0u);
+  FlowFieldCache cache(2, 1);
+  std::pair<int, int> goal(0, 7);
+  std::shared_ptr<const FlowField> first = cache.get(raw, goal);
+  std::shared_ptr<const FlowField> second = cache.get(raw, goal);
+  EXPECT_NE(first, second);
+  EXPECT_EQ(cache.getBuildCount(), 2);
+  EXPECT_EQ(second->getDistance(std::make_pair(7, 0)), 14u);
+  EXPECT_EQ(cache.size(), 1);
+}
+
+TEST(flowFieldTest, cacheSharesBuildsBetweenThreads) {
+  OccupancyGrid grid(openMap(64));
+  FlowFieldCache cache(8, 1);
+  std::vector<std::shared_ptr<const FlowField>> fields(8);
+  std::vector<std::thread> agents;
+  for (int i = 0; i < 8; i++) {
+    agents.emplace_back([&, i]() {
+      // two agents per goal
+      fields[i] = cache.get(grid, std::make_pair(i / 2, 63));
+    });
+  }
+  for (auto &agent : agents) {
+    agent.join();
+  }
+  EXPECT_EQ(cache.getBuildCount(), 4);
+  for (int i = 0; i < 8; i += 2) {
+    EXPECT_EQ(fields[i], fields[i + 1]);
+    EXPECT_EQ(fields[i]->getDistance(std::make_pair(i / 2, 0)), 63u);
+  }
+}
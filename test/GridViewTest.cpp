@@ -0,0 +1,81 @@
+/* Copyright (C)
+ * 2019 - Bhargav Dandamudi
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the 'Software'), to deal in the Software without
+ * restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit
+ * persons to whom the Software is furnished to do so,subject to
+ * the following conditions:
+ * The above copyright notice and this permission notice shall
+ * be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED ''AS IS'', WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR
+ * ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM,OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+/**
+ * @file GridViewTest.cpp
+ * @brief  Test the non-owning map view and planning through it
+ * @author Bhargav Dandamudi
+ * @version 1
+ * @date 2019-04-12
+ */
+#include "../include/GridView.h"
+#include "../include/RandomPlanner.h"
+#include "../include/optimalPlanner.h"
+#include <gtest/gtest.h>
+
+static std::vector<std::vector<int>> view_map{
+    {0, 0, 1, 0, 0, 0}, {0, 0, 1, 0, 0, 0}, {0, 0, 0, 0, 1, 0},
+    {0, 0, 0, 0, 1, 0}, {0, 0, 1, 1, 1, 0}, {0, 0, 0, 0, 0, 0}};
+
+TEST(viewTest, viewSharesGridCells) {
+  OccupancyGrid grid(view_map);
+  GridView view(grid);
+  EXPECT_EQ(view.getBytes(), grid.getBytes());
+  ASSERT_TRUE(view.isOccupied(std::make_pair(4, 3)));
+  grid.setValue(grid.toIndex(std::make_pair(4, 3)), 0);
+  ASSERT_FALSE(view.isOccupied(std::make_pair(4, 3)));
+}
+
+TEST(viewTest, strideSkipsRowPadding) {
+  // 2 x 3 map stored with 5 bytes per row, padding cells are obstacles
+  std::vector<uint8_t> cells{0, 1, 0, 1, 1, 1, 0, 0, 1, 1};
+  GridView view(cells.data(), 2, 3, 5);
+  EXPECT_EQ(view.getCellCount(), 6);
+  ASSERT_TRUE(view.isOccupied(std::make_pair(0, 1)));
+  ASSERT_TRUE(view.isOccupied(std::make_pair(1, 0)));
+  ASSERT_FALSE(view.isOccupied(std::make_pair(1, 2)));
+  ASSERT_FALSE(view.isOccupied(5));
+}
+
+TEST(viewTest, bitViewMatchesGrid) {
+  OccupancyGrid grid(view_map, CellStorage::BIT);
+  GridView view(grid.getWords(), grid.getHeight(), grid.getWidth(),
+                grid.getWordsPerRow());
+  for (int i = 0; i < view.getCellCount(); i++) {
+    EXPECT_EQ(view.getValue(i), grid.getValue(i));
+  }
+}
+
+TEST(viewTest, plannersSearchOnView) {
+  OccupancyGrid grid(view_map);
+  GridView view(grid);
+  optimalPlanner planner;
+  std::stack<std::pair<int, int>> path =
+      planner.search(view, std::make_pair(2, 0), std::make_pair(5, 5));
+  EXPECT_EQ(path.size(), 9u);
+  RandomPlanner random_planner(view, std::make_pair(2, 0),
+                               std::make_pair(5, 5));
+  ASSERT_TRUE(random_planner.isObstacle(std::make_pair(0, 2)));
+  EXPECT_EQ(random_planner.getXLength(), 5);
+}
@@ -0,0 +1,142 @@
+/* Copyright (C)
+ * 2019 - Bhargav Dandamudi
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the 'Software'), to deal in the Software without
+ * restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit
+ * persons to whom the Software is furnished to do so,subject to
+ * the following conditions:
+ * The above copyright notice and this permission notice shall
+ * be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED ''AS IS'', WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR
+ * ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM,OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+/**
+ * @file HierarchicalPlannerTest.cpp
+ * @brief  Test the cluster abstraction against plain astar
+ * @author Bhargav Dandamudi
+ * @version 1
+ * @date 2019-04-17
+ */
+#include "../bench/benchMaps.h"
+#include "../include/HierarchicalPlanner.h"
+#include "../include/OccupancyGrid.h"
+#include "../include/optimalPlanner.h"
+#include <cstdlib>
+#include <gtest/gtest.h>
+
+// checks that consecutive cells are orthogonal neighbors and free
+static bool isConnectedPath(std::stack<std::pair<int, int>> path,
+                            const OccupancyGrid &grid) {
+  std::pair<int, int> previous = path.top();
+  path.pop();
+  while (!path.empty()) {
+    std::pair<int, int> cell = path.top();
+    path.pop();
+    if (abs(cell.first - previous.first) + abs(cell.second - previous.second) !=
+            1 ||
+        grid.isOccupied(grid.toIndex(cell))) {
+      return false;
+    }
+    previous = cell;
+  }
+  return true;
+}
+
+TEST(hierarchicalTest, pathsAreValidAndNearOptimal) {
+  for (unsigned seed = 1; seed <= 10; seed++) {
+    OccupancyGrid grid(randomObstacleMap(48, 0.2, seed));
+    HierarchicalPlanner planner(grid, 8);
+    optimalPlanner astar;
+    std::pair<int, int> start(0, 0), goal(47, 47);
+    std::stack<std::pair<int, int>> optimal = astar.search(grid, start, goal);
+    std::stack<std::pair<int, int>> path = planner.search(start, goal);
+    if (optimal.size() == 1) {
+      EXPECT_EQ(path.size(), 1u);
+      continue;
+    }
+    ASSERT_GT(path.size(), 1u);
+    EXPECT_EQ(path.top(), start);
+    ASSERT_TRUE(isConnectedPath(path, grid));
+    EXPECT_GE(path.size(), optimal.size());
+    EXPECT_LE(path.size(), optimal.size() * 5 / 4);
+  }
+}
+
+TEST(hierarchicalTest, startAndGoalInOneCluster) {
+  OccupancyGrid grid(openMap(32));
+  HierarchicalPlanner planner(grid, 16);
+  std::stack<std::pair<int, int>> path =
+      planner.search(std::make_pair(2, 2), std::make_pair(5, 9));
+  EXPECT_EQ(path.size(), 11u);
+  ASSERT_TRUE(isConnectedPath(path, grid));
+}
+
+TEST(hierarchicalTest, bitStorageMap) {
+  OccupancyGrid grid(roomMap(40, 10, 3), CellStorage::BIT);
+  HierarchicalPlanner planner(grid, 8);
+  std::stack<std::pair<int, int>> path =
+      planner.search(std::make_pair(0, 0), std::make_pair(39, 39));
+  ASSERT_GT(path.size(), 1u);
+  ASSERT_TRUE(isConnectedPath(path, grid));
+}
+
+TEST(hierarchicalTest, unreachableGoal) {
+  OccupancyGrid grid(openMap(32));
+  for (int x = 0; x < 32; x++) {
+    grid.setValue(grid.toIndex(std::make_pair(20, x)), 1);
+  }
+  HierarchicalPlanner planner(grid, 8);
+  std::stack<std::pair<int, int>> path =
+      planner.search(std::make_pair(0, 0), std::make_pair(31, 31));
+  EXPECT_EQ(path.size(), 1u);
+}
+
+TEST(hierarchicalTest, badPosesAreRejected) {
+  OccupancyGrid grid(openMap(32));
+  grid.setValue(grid.toIndex(std::make_pair(5, 5)), 1);
+  HierarchicalPlanner planner(grid, 8);
+  std::pair<int, int> start(0, 0);
+  EXPECT_EQ(planner.search(std::make_pair(-1, 0), start).size(), 1u);
+  EXPECT_EQ(planner.search(start, std::make_pair(32, 3)).size(), 1u);
+  EXPECT_EQ(planner.search(start, std::make_pair(0, 1000)).size(), 1u);
+  EXPECT_EQ(planner.search(std::make_pair(5, 5), start).size(), 1u);
+  EXPECT_EQ(planner.search(start, std::make_pair(5, 5)).size(), 1u);
+  EXPECT_GE(planner.search(start, std::make_pair(31, 31)).size(), 63u);
+}
+
+TEST(hierarchicalTest, updateRebuildsOnlyNearbyClusters) {
+  OccupancyGrid grid(openMap(64));
+  HierarchicalPlanner planner(grid, 8);
+  EXPECT_EQ(planner.getClusterCount(), 64);
+  EXPECT_EQ(planner.getRebuiltClusters(), 64);
+  // wall across the map with a single gap at the right end
+  std::vector<std::pair<int, int>> changed;
+  for (int x = 0; x < 63; x++) {
+    grid.setValue(grid.toIndex(std::make_pair(30, x)), 1);
+    changed.push_back(std::make_pair(30, x));
+  }
+  planner.updateCells(changed);
+  // the row of clusters holding the wall and the rows above and below
+  EXPECT_EQ(planner.getRebuiltClusters(), 24);
+  std::stack<std::pair<int, int>> path =
+      planner.search(std::make_pair(0, 0), std::make_pair(63, 0));
+  ASSERT_TRUE(isConnectedPath(path, grid));
+  EXPECT_GE(path.size(), 63u + 63u * 2 + 1u);
+
+  std::vector<std::pair<int, int>> single{std::make_pair(4, 4)};
+  grid.setValue(grid.toIndex(single[0]), 1);
+  planner.updateCells(single);
+  EXPECT_EQ(planner.getRebuiltClusters(), 3);
+}
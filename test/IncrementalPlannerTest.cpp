@@ -0,0 +1,131 @@
+/* Copyright (C)
+ * 2019 - Bhargav Dandamudi
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the 'Software'), to deal in the Software without
+ * restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit
+ * persons to whom the Software is furnished to do so,subject to
+ * the following conditions:
+ * The above copyright notice and this permission notice shall
+ * be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED ''AS IS'', WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR
+ * ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM,OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+/**
+ * @file IncrementalPlannerTest.cpp
+ * @brief  Test D* Lite replanning against searches from scratch
+ * @author Bhargav Dandamudi
+ * @version 1
+ * @date 2019-04-18
+ */
+#include "../bench/benchMaps.h"
+#include "../include/IncrementalPlanner.h"
+#include "../include/optimalPlanner.h"
+#include <gtest/gtest.h>
+
+static std::vector<std::vector<int>> grid_map{
+    {0, 0, 1, 0, 0, 0}, {0, 0, 1, 0, 0, 0}, {0, 0, 0, 0, 1, 0},
+    {0, 0, 0, 0, 1, 0}, {0, 0, 1, 1, 1, 0}, {0, 0, 0, 0, 0, 0}};
+
+TEST(incrementalTest, firstSearchMatchesAstar) {
+  IncrementalPlanner planner(grid_map, std::make_pair(2, 0),
+                             std::make_pair(5, 5));
+  std::stack<std::pair<int, int>> path = planner.search();
+  EXPECT_EQ(path.size(), 9u);
+  EXPECT_EQ(path.top(), std::make_pair(2, 0));
+}
+
+TEST(incrementalTest, replanAfterBlockingMatchesFreshSearch) {
+  std::vector<std::vector<int>> map = randomObstacleMap(64, 0.2, 7);
+  std::pair<int, int> start(0, 0), goal(63, 63);
+  IncrementalPlanner planner(map, start, goal);
+  std::stack<std::pair<int, int>> path = planner.search();
+  ASSERT_GT(path.size(), 1u);
+  int full_expansions = planner.getExpandedNodes();
+  optimalPlanner astar;
+  // block a cell in the middle of the current path, a few times
+  for (int round = 0; round < 5; round++) {
+    for (int step = 0; step < int(path.size()) / 2; step++) {
+      path.pop();
+    }
+    std::pair<int, int> cell = path.top();
+    map[cell.first][cell.second] = 1;
+    planner.updateCell(cell, 1);
+    path = planner.replan(start);
+    EXPECT_EQ(path.size(), astar.search(map, start, goal).size());
+    EXPECT_LT(planner.getExpandedNodes(), full_expansions);
+  }
+}
+
+TEST(incrementalTest, moveStartAndUnblock) {
+  std::vector<std::vector<int>> map = roomMap(48, 12, 5);
+  std::pair<int, int> goal(47, 47);
+  IncrementalPlanner planner(map, std::make_pair(0, 0), goal);
+  std::stack<std::pair<int, int>> path = planner.search();
+  optimalPlanner astar;
+  // walk a few steps along the path, open a wall and close a door
+  path.pop();
+  path.pop();
+  std::pair<int, int> robot = path.top();
+  for (int y = 1; y < 12; y++) {
+    map[y][12] = 0;
+    planner.updateCell(std::make_pair(y, 12), 0);
+  }
+  path = planner.replan(robot);
+  EXPECT_EQ(path.top(), robot);
+  EXPECT_EQ(path.size(), astar.search(map, robot, goal).size());
+}
+
+TEST(incrementalTest, goalCutOffAndReopened) {
+  std::vector<std::vector<int>> map(8, std::vector<int>(8, 0));
+  IncrementalPlanner planner(map, std::make_pair(0, 0), std::make_pair(7, 7));
+  EXPECT_EQ(planner.search().size(), 15u);
+  planner.updateCell(std::make_pair(6, 7), 1);
+  planner.updateCell(std::make_pair(7, 6), 1);
+  EXPECT_EQ(planner.replan(std::make_pair(0, 0)).size(), 1u);
+  planner.updateCell(std::make_pair(7, 6), 0);
+  EXPECT_EQ(planner.replan(std::make_pair(1, 0)).size(), 14u);
+  ASSERT_TRUE(planner.getWorldMap().isOccupied(
+      planner.getWorldMap().toIndex(std::make_pair(6, 7))));
+}
+
+TEST(incrementalTest, badPosesAreRejected) {
+  std::pair<int, int> start(2, 0);
+  for (std::pair<int, int> goal :
+       {std::make_pair(6, 5), std::make_pair(-1, 0), std::make_pair(0, 2)}) {
+    IncrementalPlanner planner(grid_map, start, goal);
+    EXPECT_FALSE(planner.isValid());
+    std::stack<std::pair<int, int>> path = planner.search();
+    ASSERT_EQ(path.size(), 1u);
+    EXPECT_EQ(path.top(), start);
+    planner.updateCell(std::make_pair(3, 3), 1);
+    EXPECT_EQ(planner.replan(std::make_pair(3, 0)).size(), 1u);
+  }
+  IncrementalPlanner blocked_start(grid_map, std::make_pair(0, 2),
+                                   std::make_pair(5, 5));
+  EXPECT_FALSE(blocked_start.isValid());
+  EXPECT_EQ(blocked_start.search().size(), 1u);
+}
+
+TEST(incrementalTest, cellsOutsideTheMapAreIgnored) {
+  IncrementalPlanner planner(grid_map, std::make_pair(2, 0),
+                             std::make_pair(5, 5));
+  EXPECT_TRUE(planner.isValid());
+  planner.updateCell(std::make_pair(6, 0), 1);
+  planner.updateCell(std::make_pair(0, -1), 1);
+  planner.updateCell(std::make_pair(-3, 9), 1);
+  EXPECT_EQ(planner.search().size(), 9u);
+  EXPECT_EQ(planner.replan(std::make_pair(-1, 0)).size(), 1u);
+  EXPECT_EQ(planner.replan(std::make_pair(2, 0)).size(), 9u);
+}
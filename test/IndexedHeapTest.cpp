@@ -0,0 +1,132 @@
+/* Copyright (C)
+ * 2019 - Bhargav Dandamudi
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the 'Software'), to deal in the Software without
+ * restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit
+ * persons to whom the Software is furnished to do so,subject to
+ * the following conditions:
+ * The above copyright notice and this permission notice shall
+ * be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED ''AS IS'', WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR
+ * ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM,OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+/**
+ * @file IndexedHeapTest.cpp
+ * @brief  Test the indexed d-ary heap used as open list
+ * @author Bhargav Dandamudi
+ * @version 1
+ * @date 2019-04-10
+ */
+#include "../include/IndexedHeap.h"
+#include "../include/optimalPlanner.h"
+#include <algorithm>
+#include <gtest/gtest.h>
+
+TEST(heapTest, popsInPriorityOrder) {
+  IndexedHeap<4> heap(10);
+  heap.push(3, 5.0);
+  heap.push(7, 1.0);
+  heap.push(1, 3.0);
+  heap.push(9, 2.0);
+  EXPECT_EQ(heap.pop(), 7);
+  EXPECT_EQ(heap.pop(), 9);
+  EXPECT_EQ(heap.pop(), 1);
+  EXPECT_EQ(heap.pop(), 3);
+  ASSERT_TRUE(heap.empty());
+}
+
+TEST(heapTest, tiesBrokenBySmallerIndex) {
+  IndexedHeap<2> heap(10);
+  heap.push(6, 4.0);
+  heap.push(2, 4.0);
+  heap.push(4, 4.0);
+  EXPECT_EQ(heap.pop(), 2);
+  EXPECT_EQ(heap.pop(), 4);
+  EXPECT_EQ(heap.pop(), 6);
+}
+
+TEST(heapTest, decreaseKeyKeepsSingleEntry) {
+  IndexedHeap<4> heap(10);
+  heap.push(5, 8.0);
+  heap.push(2, 6.0);
+  heap.push(5, 3.0); // decrease
+  heap.push(5, 9.0); // higher priority is ignored
+  EXPECT_EQ(heap.size(), 2);
+  EXPECT_EQ(heap.priority(5), 3.0);
+  EXPECT_EQ(heap.pop(), 5);
+  EXPECT_EQ(heap.pop(), 2);
+}
+
+TEST(heapTest, updateAndRemoveAnywhere) {
+  IndexedHeap<2> heap(10);
+  for (int i = 0; i < 8; i++) {
+    heap.push(i, double(i));
+  }
+  heap.update(0, 10.0); // raise
+  heap.update(6, 0.5);  // lower
+  heap.update(9, 2.5);  // insert
+  heap.remove(3);
+  heap.remove(7); // last slot
+  ASSERT_FALSE(heap.contains(3));
+  std::vector<int> order;
+  while (!heap.empty()) {
+    order.push_back(heap.pop());
+  }
+  EXPECT_EQ(order, (std::vector<int>{6, 1, 2, 9, 4, 5, 0}));
+}
+
+TEST(heapTest, clearResetsPositions) {
+  IndexedHeap<2> heap(4);
+  heap.push(0, 1.0);
+  heap.push(3, 2.0);
+  heap.clear();
+  ASSERT_TRUE(heap.empty());
+  ASSERT_FALSE(heap.contains(3));
+  heap.push(3, 7.0);
+  EXPECT_EQ(heap.top(), 3);
+}
+
+TEST(heapTest, slotsVisitEveryCellOnce) {
+  IndexedHeap<4> heap(8);
+  for (int i : {5, 2, 7, 0, 3}) {
+    heap.push(i, 10.0 - i);
+  }
+  std::vector<int> cells;
+  for (int slot = 0; slot < heap.size(); slot++) {
+    cells.push_back(heap.at(slot));
+  }
+  std::sort(cells.begin(), cells.end());
+  EXPECT_EQ(cells, (std::vector<int>{0, 2, 3, 5, 7}));
+  EXPECT_EQ(heap.top(), 7);
+}
+
+TEST(heapTest, openListsGiveSamePathLength) {
+  std::vector<std::vector<int>> map{
+      {0, 0, 1, 0, 0, 0}, {0, 0, 1, 0, 0, 0}, {0, 0, 0, 0, 1, 0},
+      {0, 0, 0, 0, 1, 0}, {0, 0, 1, 1, 1, 0}, {0, 0, 0, 0, 0, 0}};
+  optimalPlanner planner;
+  planner.setOpenListType(OpenListType::SET);
+  auto set_path =
+      planner.search(map, std::make_pair(2, 0), std::make_pair(5, 5));
+  planner.setOpenListType(OpenListType::BINARY_HEAP);
+  auto binary_path =
+      planner.search(map, std::make_pair(2, 0), std::make_pair(5, 5));
+  planner.setOpenListType(OpenListType::QUATERNARY_HEAP);
+  auto quaternary_path =
+      planner.search(map, std::make_pair(2, 0), std::make_pair(5, 5));
+  EXPECT_EQ(set_path.size(), 9u);
+  EXPECT_EQ(binary_path, set_path);
+  EXPECT_EQ(quaternary_path, set_path);
+}
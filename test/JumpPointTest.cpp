@@ -0,0 +1,115 @@
+/* Copyright (C)
+ * 2019 - Bhargav Dandamudi
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the 'Software'), to deal in the Software without
+ * restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit
+ * persons to whom the Software is furnished to do so,subject to
+ * the following conditions:
+ * The above copyright notice and this permission notice shall
+ * be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED ''AS IS'', WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR
+ * ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM,OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+/**
+ * @file JumpPointTest.cpp
+ * @brief  Test jump point search against the plain astar search
+ * @author Bhargav Dandamudi
+ * @version 1
+ * @date 2019-04-14
+ */
+#include "../include/optimalPlanner.h"
+#include <gtest/gtest.h>
+#include <random>
+
+static std::vector<std::vector<int>> jump_map{
+    {0, 0, 1, 0, 0, 0}, {0, 0, 1, 0, 0, 0}, {0, 0, 0, 0, 1, 0},
+    {0, 0, 0, 0, 1, 0}, {0, 0, 1, 1, 1, 0}, {0, 0, 0, 0, 0, 0}};
+
+// converts the stack into a vector from start to goal
+static std::vector<std::pair<int, int>>
+toVector(std::stack<std::pair<int, int>> path) {
+  std::vector<std::pair<int, int>> steps;
+  while (!path.empty()) {
+    steps.push_back(path.top());
+    path.pop();
+  }
+  return steps;
+}
+
+// every step moves to a free orthogonal neighbor
+static bool isConnected(const std::vector<std::pair<int, int>> &steps,
+                        const OccupancyGrid &grid) {
+  for (int i = 0; i < int(steps.size()); i++) {
+    if (grid.isOccupied(grid.toIndex(steps[i]))) {
+      return false;
+    }
+    if (i > 0 && abs(steps[i].first - steps[i - 1].first) +
+                         abs(steps[i].second - steps[i - 1].second) !=
+                     1) {
+      return false;
+    }
+  }
+  return true;
+}
+
+TEST(jumpPointTest, sameLengthOnSmallMap) {
+  optimalPlanner planner;
+  planner.setSearchMode(SearchMode::JUMP_POINT);
+  EXPECT_EQ(planner.getSearchMode(), SearchMode::JUMP_POINT);
+  std::vector<std::pair<int, int>> steps = toVector(
+      planner.search(jump_map, std::make_pair(2, 0), std::make_pair(5, 5)));
+  EXPECT_EQ(steps.size(), 9u);
+  EXPECT_EQ(steps.front(), std::make_pair(2, 0));
+  EXPECT_EQ(steps.back(), std::make_pair(5, 5));
+  ASSERT_TRUE(isConnected(steps, OccupancyGrid(jump_map)));
+}
+
+TEST(jumpPointTest, matchesAstarOnRandomMaps) {
+  std::mt19937 generator(7);
+  for (int trial = 0; trial < 40; trial++) {
+    std::bernoulli_distribution obstacle(0.1 + 0.01 * trial);
+    OccupancyGrid grid(24, 31);
+    for (int i = 0; i < grid.getCellCount(); i++) {
+      grid.setValue(i, obstacle(generator) ? 1 : 0);
+    }
+    std::pair<int, int> start = std::make_pair(0, 0);
+    std::pair<int, int> goal = std::make_pair(23, 30);
+    grid.setValue(grid.toIndex(start), 0);
+    grid.setValue(grid.toIndex(goal), 0);
+
+    optimalPlanner astar;
+    optimalPlanner jps;
+    jps.setSearchMode(SearchMode::JUMP_POINT);
+    std::vector<std::pair<int, int>> astar_steps =
+        toVector(astar.search(grid, start, goal));
+    std::vector<std::pair<int, int>> jps_steps =
+        toVector(jps.search(grid, start, goal));
+    EXPECT_EQ(jps_steps.size(), astar_steps.size()) << "trial " << trial;
+    ASSERT_TRUE(isConnected(jps_steps, grid));
+  }
+}
+
+TEST(jumpPointTest, fewerExpansionsOnOpenMap) {
+  OccupancyGrid grid(64, 64);
+  optimalPlanner astar;
+  optimalPlanner jps;
+  jps.setSearchMode(SearchMode::JUMP_POINT);
+  std::stack<std::pair<int, int>> astar_path =
+      astar.search(grid, std::make_pair(0, 0), std::make_pair(63, 63));
+  std::stack<std::pair<int, int>> jps_path =
+      jps.search(grid, std::make_pair(0, 0), std::make_pair(63, 63));
+  EXPECT_EQ(jps_path.size(), astar_path.size());
+  EXPECT_LT(jps.getExpandedNodes(), astar.getExpandedNodes());
+}
@@ -0,0 +1,199 @@
+/* Copyright (C)
+ * 2019 - Bhargav Dandamudi
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the 'Software'), to deal in the Software without
+ * restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit
+ * persons to whom the Software is furnished to do so,subject to
+ * the following conditions:
+ * The above copyright notice and this permission notice shall
+ * be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED ''AS IS'', WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR
+ * ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM,OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+/**
+ * @file LandmarkHeuristicTest.cpp
+ * @brief  Test the landmark tables, their bound and persistence
+ * @author Bhargav Dandamudi
+ * @version 1
+ * @date 2019-04-19
+ */
+#include "../bench/benchMaps.h"
+#include "../include/LandmarkHeuristic.h"
+#include "../include/MapFile.h"
+#include "../include/OccupancyGrid.h"
+#include "../include/optimalPlanner.h"
+#include <cstdio>
+#include <fstream>
+#include <gtest/gtest.h>
+
+TEST(landmarkTest, tablesHoldExactDistances) {
+  OccupancyGrid grid(openMap(20));
+  LandmarkHeuristic landmarks;
+  landmarks.build(grid, 4, 2);
+  ASSERT_EQ(landmarks.getLandmarkCount(), 4);
+  for (int l = 0; l < 4; l++) {
+    int source = landmarks.getLandmarks()[l];
+    EXPECT_EQ(landmarks.getDistance(l, source), 0u);
+    std::pair<int, int> a = grid.toPosition(source);
+    // on an open map the distance is the Manhattan distance
+    EXPECT_EQ(landmarks.getDistance(l, grid.toIndex(std::make_pair(7, 3))),
+              uint32_t(abs(a.first - 7) + abs(a.second - 3)));
+  }
+}
+
+TEST(landmarkTest, boundIsAdmissible) {
+  OccupancyGrid grid(roomMap(40, 8, 11));
+  LandmarkHeuristic landmarks;
+  landmarks.build(grid, 6);
+  optimalPlanner planner;
+  std::pair<int, int> goal(39, 39);
+  for (int y = 0; y < 40; y += 7) {
+    for (int x = 0; x < 40; x += 5) {
+      std::pair<int, int> start(y, x);
+      if (grid.isOccupied(grid.toIndex(start))) {
+        continue;
+      }
+      size_t steps = planner.search(grid, start, goal).size() - 1;
+      EXPECT_LE(landmarks.estimate(grid.toIndex(start), grid.toIndex(goal)),
+                double(steps));
+    }
+  }
+}
+
+TEST(landmarkTest, plannerExpandsFewerNodes) {
+  OccupancyGrid grid(roomMap(64, 16, 3));
+  std::shared_ptr<LandmarkHeuristic> landmarks(new LandmarkHeuristic());
+  landmarks->build(grid, 8);
+  optimalPlanner planner, plain_planner;
+  planner.setLandmarks(landmarks);
+  std::pair<int, int> start(0, 63), goal(63, 0);
+  std::stack<std::pair<int, int>> plain =
+      plain_planner.search(grid, start, goal);
+  int plain_expansions = plain_planner.getExpandedNodes();
+  std::stack<std::pair<int, int>> guided = planner.search(grid, start, goal);
+  EXPECT_EQ(guided.size(), plain.size());
+  EXPECT_LT(planner.getExpandedNodes(), plain_expansions);
+  planner.setSearchMode(SearchMode::BIDIRECTIONAL);
+  EXPECT_EQ(planner.search(grid, start, goal).size(), plain.size());
+}
+
+TEST(landmarkTest, plannerIgnoresTablesOfOtherMaps) {
+  OccupancyGrid wide(20, 40), tall(40, 20);
+  std::shared_ptr<LandmarkHeuristic> landmarks(new LandmarkHeuristic());
+  landmarks->build(wide, 4);
+  optimalPlanner planner, plain_planner;
+  planner.setLandmarks(landmarks);
+  // the same cell count transposed
+  std::pair<int, int> start(0, 0), goal(39, 19);
+  EXPECT_EQ(planner.search(tall, start, goal).size(),
+            plain_planner.search(tall, start, goal).size());
+  EXPECT_EQ(planner.getExpandedNodes(), plain_planner.getExpandedNodes());
+
+  // an edited map of the same size: a wall the tables do not know
+  goal = std::make_pair(0, 39);
+  planner.search(wide, start, goal);
+  int guided = planner.getExpandedNodes();
+  for (int y = 0; y < 19; y++) {
+    wide.setValue(wide.toIndex(std::make_pair(y, 20)), 1);
+  }
+  std::stack<std::pair<int, int>> plain =
+      plain_planner.search(wide, start, goal);
+  EXPECT_EQ(planner.search(wide, start, goal).size(), plain.size());
+  EXPECT_EQ(planner.getExpandedNodes(), plain_planner.getExpandedNodes());
+  EXPECT_NE(planner.getExpandedNodes(), guided);
+}
+
+TEST(landmarkTest, plannerChecksMappedFilesOncePerOpen) {
+  OccupancyGrid grid(randomObstacleMap(32, 0.2, 6));
+  std::pair<int, int> start(0, 0), goal(31, 31);
+  grid.setValue(grid.toIndex(start), 0);
+  grid.setValue(grid.toIndex(goal), 0);
+  std::shared_ptr<LandmarkHeuristic> landmarks(new LandmarkHeuristic());
+  landmarks->build(grid, 4);
+  std::string file_name = "landmark_test.gmap";
+  ASSERT_TRUE(MapFile::save(file_name, grid));
+  MapFile map;
+  ASSERT_TRUE(map.open(file_name));
+  // mapped views carry a version, so the checksum is compared once
+  EXPECT_NE(map.getView().getVersion(), 0u);
+  EXPECT_EQ(map.getView().getVersion(), map.getVersion());
+  optimalPlanner planner, grid_planner, plain_planner;
+  planner.setLandmarks(landmarks);
+  grid_planner.setLandmarks(landmarks);
+  for (int round = 0; round < 2; round++) {
+    planner.search(map.getView(), start, goal);
+    grid_planner.search(grid, start, goal);
+    EXPECT_EQ(planner.getExpandedNodes(), grid_planner.getExpandedNodes());
+  }
+  plain_planner.search(grid, start, goal);
+  EXPECT_LT(planner.getExpandedNodes(), plain_planner.getExpandedNodes());
+
+  // another file of the same size is a new version and checked again
+  uint64_t before = map.getVersion();
+  grid.setValue(grid.toIndex(std::make_pair(16, 16)),
+                1 - grid.getValue(grid.toIndex(std::make_pair(16, 16))));
+  ASSERT_TRUE(MapFile::save(file_name, grid));
+  ASSERT_TRUE(map.open(file_name));
+  EXPECT_NE(map.getVersion(), before);
+  planner.search(map.getView(), start, goal);
+  plain_planner.search(grid, start, goal);
+  EXPECT_EQ(planner.getExpandedNodes(), plain_planner.getExpandedNodes());
+  map.close();
+  std::remove(file_name.c_str());
+}
+
+TEST(landmarkTest, saveAndLoad) {
+  OccupancyGrid grid(randomObstacleMap(32, 0.25, 4));
+  LandmarkHeuristic landmarks;
+  landmarks.build(grid, 5);
+  std::string file_name = "landmark_test.bin";
+  ASSERT_TRUE(landmarks.save(file_name));
+  LandmarkHeuristic loaded;
+  ASSERT_TRUE(loaded.load(file_name, grid));
+  ASSERT_TRUE(loaded.matches(grid));
+  EXPECT_EQ(loaded.getLandmarks(), landmarks.getLandmarks());
+  EXPECT_EQ(loaded.estimate(0, 1000), landmarks.estimate(0, 1000));
+  // a new map version does not accept the old tables
+  grid.setValue(grid.toIndex(std::make_pair(5, 5)),
+                1 - grid.getValue(grid.toIndex(std::make_pair(5, 5))));
+  ASSERT_FALSE(landmarks.matches(grid));
+  LandmarkHeuristic stale;
+  ASSERT_FALSE(stale.load(file_name, grid));
+  ASSERT_FALSE(stale.load("missing_landmarks.bin", grid));
+  std::remove(file_name.c_str());
+}
+
+TEST(landmarkTest, corruptedFileIsRejected) {
+  OccupancyGrid grid(openMap(100));
+  LandmarkHeuristic landmarks;
+  landmarks.build(grid, 4);
+  std::string file_name = "landmark_corrupt_test.bin";
+  // landmark count after magic, version, height, width and checksum, the
+  // landmark cells follow it
+  const std::streamoff count_offset = 24;
+  for (int32_t value : {INT32_MAX, -1, 10000}) {
+    ASSERT_TRUE(landmarks.save(file_name));
+    {
+      std::fstream file(file_name,
+                        std::ios::binary | std::ios::in | std::ios::out);
+      file.seekp(value == INT32_MAX ? count_offset : count_offset + 4);
+      file.write(reinterpret_cast<const char *>(&value), sizeof(value));
+    }
+    LandmarkHeuristic loaded;
+    EXPECT_FALSE(loaded.load(file_name, grid)) << value;
+    EXPECT_EQ(loaded.getLandmarkCount(), 0) << value;
+  }
+  std::remove(file_name.c_str());
+}
@@ -0,0 +1,193 @@
+/* Copyright (C)
+ * 2019 - Bhargav Dandamudi
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the 'Software'), to deal in the Software without
+ * restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit
+ * persons to whom the Software is furnished to do so,subject to
+ * the following conditions:
+ * The above copyright notice and this permission notice shall
+ * be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED ''AS IS'', WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR
+ * ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM,OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+/**
+ * @file MapFileTest.cpp
+ * @brief  Test the binary map files and the converters
+ * @author Bhargav Dandamudi
+ * @version 1
+ * @date 2019-04-26
+ */
+#include "../bench/benchMaps.h"
+#include "../include/MapFile.h"
+#include "../include/optimalPlanner.h"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <gtest/gtest.h>
+
+static void expectSameCells(const GridView &a, const GridView &b) {
+  ASSERT_EQ(a.getHeight(), b.getHeight());
+  ASSERT_EQ(a.getWidth(), b.getWidth());
+  for (int i = 0; i < a.getCellCount(); i++) {
+    ASSERT_EQ(a.getValue(i), b.getValue(i)) << i;
+  }
+}
+
+TEST(mapFileTest, saveAndMap) {
+  std::string file_name = "map_file_test.gmap";
+  for (CellStorage storage : {CellStorage::BYTE, CellStorage::BIT}) {
+    OccupancyGrid grid(randomObstacleMap(70, 0.3, 2), storage);
+    ASSERT_TRUE(MapFile::save(file_name, grid, 0.05));
+    MapFile map;
+    ASSERT_TRUE(map.open(file_name));
+    EXPECT_TRUE(map.isOpen());
+    EXPECT_TRUE(map.verify());
+    EXPECT_DOUBLE_EQ(map.getResolution(), 0.05);
+    EXPECT_EQ(map.getView().getStorage(), storage);
+    expectSameCells(map.getView(), grid);
+    // planners run on the mapped cells directly
+    optimalPlanner planner;
+    EXPECT_EQ(
+        planner.search(map.getView(), std::make_pair(0, 0),
+                       std::make_pair(69, 69)),
+        optimalPlanner().search(grid, std::make_pair(0, 0),
+                                std::make_pair(69, 69)));
+    map.close();
+    EXPECT_FALSE(map.isOpen());
+  }
+  std::remove(file_name.c_str());
+}
+
+TEST(mapFileTest, rejectsBadFiles) {
+  std::string file_name = "map_file_test.gmap";
+  OccupancyGrid grid(randomObstacleMap(40, 0.3, 3));
+  ASSERT_TRUE(MapFile::save(file_name, grid));
+  MapFile map;
+  EXPECT_FALSE(map.open("missing_map_file.gmap"));
+
+  // a changed cell is caught by verify, not by open
+  {
+    std::fstream file(file_name,
+                      std::ios::in | std::ios::out | std::ios::binary);
+    file.seekp(64 + 100);
+    file.put(char(7));
+  }
+  ASSERT_TRUE(map.open(file_name));
+  EXPECT_FALSE(map.verify());
+  map.close();
+
+  // cut off cells and a wrong magic are caught by open
+  std::string bytes;
+  {
+    std::ifstream file(file_name, std::ios::binary);
+    bytes.assign(std::istreambuf_iterator<char>(file),
+                 std::istreambuf_iterator<char>());
+  }
+  std::ofstream(file_name, std::ios::binary)
+      .write(bytes.data(), bytes.size() - 8);
+  EXPECT_FALSE(map.open(file_name));
+  bytes[0] = 'X';
+  std::ofstream(file_name, std::ios::binary).write(bytes.data(), bytes.size());
+  EXPECT_FALSE(map.open(file_name));
+  std::remove(file_name.c_str());
+}
+
+TEST(mapFileTest, rejectsOverflowingHeaders) {
+  std::string file_name = "map_file_test.gmap";
+  OccupancyGrid grid(randomObstacleMap(40, 0.3, 3));
+  ASSERT_TRUE(MapFile::save(file_name, grid));
+  std::string bytes;
+  {
+    std::ifstream file(file_name, std::ios::binary);
+    bytes.assign(std::istreambuf_iterator<char>(file),
+                 std::istreambuf_iterator<char>());
+  }
+  // header fields by offset: height 8, storage 16, stride 20, data offset 40
+  auto opensPatched = [&](std::size_t offset, const void *value,
+                          std::size_t length) {
+    std::string patched = bytes;
+    std::memcpy(&patched[offset], value, length);
+    std::ofstream(file_name, std::ios::binary)
+        .write(patched.data(), patched.size());
+    MapFile map;
+    return map.open(file_name);
+  };
+  // offset plus cell bytes wraps around to less than the file size
+  uint64_t far_offset = ~uint64_t(7);
+  EXPECT_FALSE(opensPatched(40, &far_offset, 8));
+  // rows times row bytes is 2^64 + 64, which wraps to 64 cell bytes
+  uint32_t bit_header[4] = {2147352580u, 40, 0, 1073807362u};
+  EXPECT_FALSE(opensPatched(8, bit_header, 16));
+  // a stride above INT32_MAX with no rows
+  uint32_t wide_header[4] = {0, 40, 1, uint32_t(1) << 31};
+  EXPECT_FALSE(opensPatched(8, wide_header, 16));
+  // the untouched header still opens
+  EXPECT_TRUE(opensPatched(8, &bytes[8], 4));
+  std::remove(file_name.c_str());
+}
+
+TEST(mapFileTest, readsMovingAiMaps) {
+  std::string map_name = "moving_ai_test.map";
+  std::ofstream(map_name) << "type octile\nheight 3\nwidth 5\nmap\n"
+                             ".@T..\n"
+                             ".G.W.\n"
+                             "S...O\n";
+  OccupancyGrid grid;
+  ASSERT_TRUE(MapFile::readMovingAi(map_name, grid));
+  std::vector<std::vector<int>> expected = {
+      {0, 1, 1, 0, 0}, {0, 0, 0, 1, 0}, {0, 0, 0, 0, 1}};
+  expectSameCells(grid, OccupancyGrid(expected));
+
+  std::string file_name = "moving_ai_test.gmap";
+  ASSERT_TRUE(MapFile::convertMovingAi(map_name, file_name));
+  MapFile map;
+  ASSERT_TRUE(map.open(file_name));
+  expectSameCells(map.getView(), OccupancyGrid(expected));
+  std::ofstream(map_name) << "type octile\nheight 3\nwidth 5\nmap\n.....\n";
+  EXPECT_FALSE(MapFile::readMovingAi(map_name, grid));
+  std::remove(map_name.c_str());
+  std::remove(file_name.c_str());
+}
+
+TEST(mapFileTest, readsPgmImages) {
+  std::string pgm_name = "pgm_test.pgm";
+  // white is free, black occupied and grey (unknown) blocked as well
+  std::vector<std::vector<int>> expected = {{0, 1, 1}, {1, 0, 0}};
+  std::ofstream(pgm_name) << "P2\n# map_saver\n3 2\n255\n254 0 205\n0 255 "
+                             "230\n";
+  OccupancyGrid grid;
+  ASSERT_TRUE(MapFile::readPgm(pgm_name, grid));
+  expectSameCells(grid, OccupancyGrid(expected));
+
+  {
+    std::ofstream file(pgm_name, std::ios::binary);
+    file << "P5\n3 2\n255\n";
+    const unsigned char pixels[6] = {254, 0, 205, 0, 255, 230};
+    file.write(reinterpret_cast<const char *>(pixels), sizeof(pixels));
+  }
+  ASSERT_TRUE(MapFile::readPgm(pgm_name, grid));
+  expectSameCells(grid, OccupancyGrid(expected));
+
+  std::string file_name = "pgm_test.gmap";
+  ASSERT_TRUE(MapFile::convertPgm(pgm_name, file_name, 0.1));
+  MapFile map;
+  ASSERT_TRUE(map.open(file_name));
+  EXPECT_DOUBLE_EQ(map.getResolution(), 0.1);
+  expectSameCells(map.getView(), OccupancyGrid(expected));
+  std::ofstream(pgm_name) << "P6\n3 2\n255\n";
+  EXPECT_FALSE(MapFile::readPgm(pgm_name, grid));
+  std::remove(pgm_name.c_str());
+  std::remove(file_name.c_str());
+}
@@ -0,0 +1,249 @@
+/* Copyright (C)
+ * 2019 - Bhargav Dandamudi
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the 'Software'), to deal in the Software without
+ * restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit
+ * persons to whom the Software is furnished to do so,subject to
+ * the following conditions:
+ * The above copyright notice and this permission notice shall
+ * be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED ''AS IS'', WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR
+ * ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM,OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+/**
+ * @file NeighborhoodTest.cpp
+ * @brief  Test the neighborhood policies and eight connected planning
+ * @author Bhargav Dandamudi
+ * @version 1
+ * @date 2019-04-24
+ */
+#include "../bench/benchMaps.h"
+#include "../include/ComponentIndex.h"
+#include "../include/CostMap.h"
+#include "../include/LandmarkHeuristic.h"
+#include "../include/Neighborhood.h"
+#include "../include/OccupancyGrid.h"
+#include "../include/optimalPlanner.h"
+#include <cmath>
+#include <gtest/gtest.h>
+#include <queue>
+
+// cost of the cheapest eight connected path without corner cutting with
+// Dijkstra, -1 if there is none
+static double cheapestCost(const OccupancyGrid &grid, const CostMap &costs,
+                           int start, int goal) {
+  int width = grid.getWidth();
+  std::vector<double> distance(grid.getCellCount(), -1);
+  typedef std::pair<double, int> Entry;
+  std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> open;
+  open.push(std::make_pair(0.0, start));
+  auto free = [&](int y, int x) {
+    return grid.isInside(std::make_pair(y, x)) &&
+           !grid.isOccupied(y * width + x) && !costs.isLethal(y * width + x);
+  };
+  while (!open.empty()) {
+    Entry entry = open.top();
+    open.pop();
+    if (distance[entry.second] != -1) {
+      continue;
+    }
+    distance[entry.second] = entry.first;
+    int y = entry.second / width;
+    int x = entry.second % width;
+    for (int dy = -1; dy <= 1; dy++) {
+      for (int dx = -1; dx <= 1; dx++) {
+        if ((dy == 0 && dx == 0) || !free(y + dy, x + dx) ||
+            (dy != 0 && dx != 0 && (!free(y + dy, x) || !free(y, x + dx)))) {
+          continue;
+        }
+        int cell = (y + dy) * width + x + dx;
+        double length = (dy != 0 && dx != 0) ? std::sqrt(2.0) : 1.0;
+        open.push(std::make_pair(
+            entry.first + length * (1 + costs.getCost(cell)), cell));
+      }
+    }
+  }
+  return distance[goal];
+}
+
+// cost of a returned path, checking that every step is a legal move
+static double pathCost(std::stack<std::pair<int, int>> path,
+                       const OccupancyGrid &grid, const CostMap &costs) {
+  double total = 0;
+  std::pair<int, int> previous = path.top();
+  path.pop();
+  while (!path.empty()) {
+    std::pair<int, int> cell = path.top();
+    path.pop();
+    int dy = cell.first - previous.first;
+    int dx = cell.second - previous.second;
+    EXPECT_TRUE(abs(dy) <= 1 && abs(dx) <= 1 && (dy != 0 || dx != 0));
+    EXPECT_FALSE(grid.isOccupied(grid.toIndex(cell)));
+    if (dy != 0 && dx != 0) {
+      EXPECT_FALSE(grid.isOccupied(
+          grid.toIndex(std::make_pair(previous.first + dy, previous.second))));
+      EXPECT_FALSE(grid.isOccupied(
+          grid.toIndex(std::make_pair(previous.first, previous.second + dx))));
+    }
+    double length = (dy != 0 && dx != 0) ? std::sqrt(2.0) : 1.0;
+    total += length * (1 + costs.getCost(grid.toIndex(cell)));
+    previous = cell;
+  }
+  return total;
+}
+
+TEST(neighborhoodTest, tablesAndDistances) {
+  EXPECT_EQ(FourConnected::SIZE, 4);
+  EXPECT_EQ(EightConnected::SIZE, 8);
+  for (int k = 0; k < EightConnected::SIZE; k++) {
+    bool diagonal = EightConnected::DY[k] != 0 && EightConnected::DX[k] != 0;
+    EXPECT_FLOAT_EQ(EightConnected::COST[k], diagonal ? std::sqrt(2.0f) : 1);
+    if (k < FourConnected::SIZE) {
+      EXPECT_EQ(EightConnected::DY[k], FourConnected::DY[k]);
+      EXPECT_EQ(EightConnected::DX[k], FourConnected::DX[k]);
+    }
+  }
+  static_assert(FourConnected::distance(3, 5) == 8, "manhattan");
+  EXPECT_NEAR(EightConnected::distance(3, 5), 2 + 3 * std::sqrt(2.0), 1e-6);
+  EXPECT_NEAR(EightConnected::distance(4, 0), 4, 1e-9);
+}
+
+TEST(neighborhoodTest, diagonalAcrossOpenMap) {
+  OccupancyGrid grid(openMap(10));
+  optimalPlanner planner;
+  planner.setConnectivity(Connectivity::EIGHT_CONNECTED);
+  EXPECT_EQ(planner.getConnectivity(), Connectivity::EIGHT_CONNECTED);
+  std::stack<std::pair<int, int>> path =
+      planner.search(grid, std::make_pair(0, 0), std::make_pair(9, 9));
+  EXPECT_EQ(path.size(), 10u);
+  EXPECT_NEAR(pathCost(path, grid, CostMap(10, 10)), 9 * std::sqrt(2.0),
+              1e-4);
+}
+
+TEST(neighborhoodTest, noCornerCutting) {
+  std::vector<std::vector<int>> map = {{0, 1}, {1, 0}};
+  optimalPlanner planner;
+  planner.setConnectivity(Connectivity::EIGHT_CONNECTED);
+  EXPECT_EQ(planner.search(map, std::make_pair(0, 0), std::make_pair(1, 1))
+                .size(),
+            1u);
+}
+
+TEST(neighborhoodTest, cornerCuttingVariant) {
+  std::vector<std::vector<int>> map = {{0, 1}, {1, 0}};
+  OccupancyGrid grid(map);
+  optimalPlanner planner;
+  planner.setConnectivity(Connectivity::EIGHT_CONNECTED_CUT_CORNERS);
+  // the orthogonal regions of the two cells differ and must not be used
+  planner.setComponentIndex(std::make_shared<ComponentIndex>(grid));
+  EXPECT_EQ(planner.search(grid, std::make_pair(0, 0), std::make_pair(1, 1))
+                .size(),
+            2u);
+  optimalPlanner policy_planner;
+  EXPECT_EQ(policy_planner
+                .search<EightConnectedCutCorners>(grid, std::make_pair(1, 1),
+                                                  std::make_pair(0, 0))
+                .size(),
+            2u);
+  EXPECT_EQ(policy_planner
+                .search<EightConnected>(grid, std::make_pair(1, 1),
+                                        std::make_pair(0, 0))
+                .size(),
+            1u);
+}
+
+// a policy of the caller: knight moves of unit length
+struct KnightMoves {
+  static constexpr int SIZE = 8;
+  static constexpr int DY[SIZE] = {-2, -1, 1, 2, 2, 1, -1, -2};
+  static constexpr int DX[SIZE] = {1, 2, 2, 1, -1, -2, -2, -1};
+  static constexpr float COST[SIZE] = {1, 1, 1, 1, 1, 1, 1, 1};
+  static constexpr bool UNIFORM = true;
+  static constexpr bool CUT_CORNERS = true;
+
+  // a move shortens dy + dx by at most 3
+  static constexpr double distance(int dy, int dx) { return (dy + dx) / 3.0; }
+};
+constexpr int KnightMoves::DY[];
+constexpr int KnightMoves::DX[];
+constexpr float KnightMoves::COST[];
+
+TEST(neighborhoodTest, customPolicy) {
+  OccupancyGrid grid(openMap(8));
+  optimalPlanner planner;
+  std::stack<std::pair<int, int>> path = planner.search<KnightMoves>(
+      grid, std::make_pair(0, 0), std::make_pair(7, 7));
+  // the fewest knight moves between opposite corners of a chessboard
+  EXPECT_EQ(path.size(), 7u);
+  std::pair<int, int> previous = path.top();
+  path.pop();
+  while (!path.empty()) {
+    int dy = std::abs(path.top().first - previous.first);
+    int dx = std::abs(path.top().second - previous.second);
+    EXPECT_EQ(dy * dx, 2);
+    previous = path.top();
+    path.pop();
+  }
+  EXPECT_EQ(planner.getStatus(), PlanStatus::SUCCESS);
+}
+
+TEST(neighborhoodTest, eightConnectedPathsAreCheapest) {
+  std::mt19937 generator(3);
+  std::uniform_int_distribution<int> terrain(0, 9);
+  for (unsigned seed = 1; seed <= 5; seed++) {
+    OccupancyGrid grid(randomObstacleMap(32, 0.25, seed));
+    std::shared_ptr<CostMap> costs = std::make_shared<CostMap>(32, 32);
+    for (int i = 0; i < costs->getCellCount(); i++) {
+      costs->setCost(i, uint8_t(terrain(generator)));
+    }
+    std::shared_ptr<LandmarkHeuristic> landmarks(new LandmarkHeuristic());
+    landmarks->build(grid, 4);
+    for (bool weighted : {false, true}) {
+      CostMap zero(32, 32);
+      const CostMap &used = weighted ? *costs : zero;
+      double expected = cheapestCost(grid, used, 0, 32 * 32 - 1);
+      for (OpenListType type : {OpenListType::SET, OpenListType::BINARY_HEAP,
+                                OpenListType::QUATERNARY_HEAP,
+                                OpenListType::BUCKET_QUEUE}) {
+        optimalPlanner planner;
+        planner.setConnectivity(Connectivity::EIGHT_CONNECTED);
+        planner.setOpenListType(type);
+        // four connected tables and modes must not be used
+        planner.setLandmarks(landmarks);
+        planner.setSearchMode(SearchMode::JUMP_POINT);
+        if (weighted) {
+          planner.setCostMap(costs);
+        }
+        std::stack<std::pair<int, int>> path =
+            planner.search(grid, std::make_pair(0, 0), std::make_pair(31, 31));
+        if (expected < 0) {
+          EXPECT_EQ(path.size(), 1u);
+        } else {
+          EXPECT_NEAR(pathCost(path, grid, used), expected, 1e-3)
+              << seed << " " << weighted;
+        }
+      }
+    }
+  }
+}
+
+TEST(neighborhoodTest, fourConnectedStaysDefault) {
+  OccupancyGrid grid(openMap(10));
+  optimalPlanner planner;
+  EXPECT_EQ(planner.getConnectivity(), Connectivity::FOUR_CONNECTED);
+  EXPECT_EQ(planner.search(grid, std::make_pair(0, 0), std::make_pair(9, 9))
+                .size(),
+            19u);
+}
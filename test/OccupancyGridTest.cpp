@@ -0,0 +1,124 @@
+/* Copyright (C)
+ * 2019 - Bhargav Dandamudi
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the 'Software'), to deal in the Software without
+ * restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit
+ * persons to whom the Software is furnished to do so,subject to
+ * the following conditions:
+ * The above copyright notice and this permission notice shall
+ * be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED ''AS IS'', WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR
+ * ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM,OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+/**
+ * @file OccupancyGridTest.cpp
+ * @brief  Test the flat occupancy grid in both storages
+ * @author Bhargav Dandamudi
+ * @version 1
+ * @date 2019-04-11
+ */
+#include "../include/OccupancyGrid.h"
+#include "../include/RandomPlanner.h"
+#include "../include/optimalPlanner.h"
+#include <algorithm>
+#include <gtest/gtest.h>
+
+static std::vector<std::vector<int>> grid_map{
+    {0, 0, 1, 0, 0, 0}, {0, 0, 1, 0, 0, 0}, {0, 0, 0, 0, 1, 0},
+    {0, 0, 0, 0, 1, 0}, {0, 0, 1, 1, 1, 0}, {0, 0, 0, 0, 0, 0}};
+
+TEST(gridTest, indexRoundTrip) {
+  OccupancyGrid grid(4, 7);
+  EXPECT_EQ(grid.toIndex(std::make_pair(2, 5)), 19);
+  EXPECT_EQ(grid.toPosition(19), std::make_pair(2, 5));
+  ASSERT_TRUE(grid.isInside(std::make_pair(3, 6)));
+  ASSERT_FALSE(grid.isInside(std::make_pair(4, 0)));
+  ASSERT_FALSE(grid.isInside(std::make_pair(0, -1)));
+}
+
+TEST(gridTest, byteStorageKeepsValues) {
+  OccupancyGrid grid(2, 2, CellStorage::BYTE);
+  grid.setValue(3, 7);
+  EXPECT_EQ(grid.getValue(3), 7);
+  ASSERT_FALSE(grid.isOccupied(3));
+  grid.setValue(3, 1);
+  ASSERT_TRUE(grid.isOccupied(3));
+}
+
+TEST(gridTest, bitStorageMatchesVectorMap) {
+  OccupancyGrid grid(grid_map, CellStorage::BIT);
+  EXPECT_EQ(grid.toVector(), grid_map);
+  EXPECT_EQ(grid.getWordsPerRow(), 1);
+}
+
+TEST(gridTest, bitStorageWideRows) {
+  OccupancyGrid grid(3, 130, CellStorage::BIT);
+  EXPECT_EQ(grid.getWordsPerRow(), 3);
+  grid.setValue(grid.toIndex(std::make_pair(1, 129)), 1);
+  grid.setValue(grid.toIndex(std::make_pair(2, 64)), 1);
+  ASSERT_TRUE(grid.isOccupied(grid.toIndex(std::make_pair(1, 129))));
+  ASSERT_TRUE(grid.isOccupied(grid.toIndex(std::make_pair(2, 64))));
+  ASSERT_FALSE(grid.isOccupied(grid.toIndex(std::make_pair(2, 63))));
+  grid.setValue(grid.toIndex(std::make_pair(1, 129)), 0);
+  ASSERT_FALSE(grid.isOccupied(grid.toIndex(std::make_pair(1, 129))));
+}
+
+TEST(gridTest, fillRowsTakesOneVersion) {
+  for (CellStorage storage : {CellStorage::BYTE, CellStorage::BIT}) {
+    OccupancyGrid grid(6, 6, storage);
+    uint64_t before = grid.getVersion();
+    EXPECT_TRUE(grid.fillRows([](int y, uint8_t *cells) {
+      for (int x = 0; x < 6; x++) {
+        cells[x] = uint8_t(grid_map[y][x]);
+      }
+      return true;
+    }));
+    EXPECT_EQ(grid.toVector(), grid_map);
+    EXPECT_NE(grid.getVersion(), before);
+    // the next number of the counter is still free: one version per fill
+    EXPECT_EQ(OccupancyGrid().getVersion(), grid.getVersion() + 1);
+    // a failing reader stops the fill, the version still changes
+    before = grid.getVersion();
+    EXPECT_FALSE(grid.fillRows([](int y, uint8_t *cells) {
+      std::fill(cells, cells + 6, uint8_t(0));
+      return y < 2;
+    }));
+    EXPECT_EQ(grid.getValue(grid.toIndex(std::make_pair(1, 2))), 0);
+    EXPECT_EQ(grid.getValue(grid.toIndex(std::make_pair(4, 2))), 1);
+    EXPECT_NE(grid.getVersion(), before);
+  }
+}
+
+TEST(gridTest, plannersRunOnBitGrid) {
+  OccupancyGrid grid(grid_map, CellStorage::BIT);
+  optimalPlanner planner;
+  std::stack<std::pair<int, int>> path =
+      planner.search(grid, std::make_pair(2, 0), std::make_pair(5, 5));
+  EXPECT_EQ(path.size(), 9u);
+  RandomPlanner random_planner(grid, std::make_pair(2, 0),
+                               std::make_pair(5, 5));
+  ASSERT_TRUE(random_planner.isObstacle(std::make_pair(4, 3)));
+  ASSERT_FALSE(random_planner.isObstacle(std::make_pair(4, 0)));
+}
+
+TEST(gridTest, nonSquareMapLengths) {
+  std::vector<std::vector<int>> wide(3, std::vector<int>(8, 0));
+  RandomPlanner random_planner(wide, std::make_pair(0, 0),
+                               std::make_pair(2, 7));
+  EXPECT_EQ(random_planner.getXLength(), 7);
+  EXPECT_EQ(random_planner.getYLength(), 2);
+  ASSERT_FALSE(random_planner.isObstacle(std::make_pair(2, 7)));
+  ASSERT_TRUE(random_planner.isObstacle(std::make_pair(3, 0)));
+}
@@ -0,0 +1,258 @@
+/* Copyright (C)
+ * 2019 - Bhargav Dandamudi
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the 'Software'), to deal in the Software without
+ * restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit
+ * persons to whom the Software is furnished to do so,subject to
+ * the following conditions:
+ * The above copyright notice and this permission notice shall
+ * be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED ''AS IS'', WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR
+ * ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM,OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+/**
+ * @file PathCacheTest.cpp
+ * @brief  Test the path cache and its invalidation on map changes
+ * @author Bhargav Dandamudi
+ * @version 1
+ * @date 2019-04-27
+ */
+#include "../bench/benchMaps.h"
+#include "../include/PathCache.h"
+#include <gtest/gtest.h>
+#include <thread>
+
+TEST(pathCacheTest, repeatedQueriesHit) {
+  OccupancyGrid grid(randomObstacleMap(40, 0.2, 5));
+  grid.setValue(0, 0);
+  grid.setValue(grid.toIndex(std::make_pair(39, 39)), 0);
+  PathCache cache;
+  optimalPlanner planner;
+  std::stack<std::pair<int, int>> path = cache.search(
+      planner, grid, std::make_pair(0, 0), std::make_pair(39, 39), 1);
+  EXPECT_EQ(path, optimalPlanner().search(grid, std::make_pair(0, 0),
+                                          std::make_pair(39, 39)));
+  EXPECT_EQ(cache.search(planner, grid, std::make_pair(0, 0),
+                         std::make_pair(39, 39), 1),
+            path);
+  EXPECT_EQ(cache.getHits(), 1u);
+  EXPECT_EQ(cache.getMisses(), 1u);
+  // other planner types and map versions are other keys
+  EXPECT_FALSE(cache.find(std::make_pair(0, 0), std::make_pair(39, 39), 1, 1,
+                          path));
+  EXPECT_FALSE(cache.find(std::make_pair(0, 0), std::make_pair(39, 39), 0, 2,
+                          path));
+  EXPECT_EQ(cache.size(), 1);
+}
+
+TEST(pathCacheTest, leastRecentlyUsedPathsAreDropped) {
+  OccupancyGrid grid(openMap(20));
+  PathCache cache(30); // two paths of 11 cells
+  optimalPlanner planner;
+  for (int row : {0, 1, 2, 0}) {
+    cache.search(planner, grid, std::make_pair(row, 0),
+                 std::make_pair(row, 10), 0);
+  }
+  EXPECT_EQ(cache.size(), 2);
+  EXPECT_EQ(cache.getCellCount(), 22u);
+  std::stack<std::pair<int, int>> path;
+  EXPECT_TRUE(cache.find(std::make_pair(0, 0), std::make_pair(0, 10), 0, 0,
+                         path));
+  EXPECT_TRUE(cache.find(std::make_pair(2, 0), std::make_pair(2, 10), 0, 0,
+                         path));
+  EXPECT_FALSE(cache.find(std::make_pair(1, 0), std::make_pair(1, 10), 0, 0,
+                          path));
+  // longer than the whole cache, not kept
+  cache.search(planner, grid, std::make_pair(0, 0), std::make_pair(19, 19), 0);
+  EXPECT_EQ(cache.size(), 2);
+}
+
+TEST(pathCacheTest, blockedCellDropsPathsThroughIt) {
+  OccupancyGrid grid(openMap(20));
+  PathCache cache;
+  optimalPlanner planner;
+  cache.search(planner, grid, std::make_pair(0, 0), std::make_pair(0, 10),
+               grid.getVersion());
+  cache.search(planner, grid, std::make_pair(10, 0), std::make_pair(10, 10),
+               grid.getVersion());
+  uint64_t before = grid.getVersion();
+  grid.setValue(grid.toIndex(std::make_pair(0, 5)), 1);
+  EXPECT_EQ(cache.updateCells(grid, {std::make_pair(0, 5)}, before,
+                              grid.getVersion()),
+            1);
+  std::stack<std::pair<int, int>> path;
+  EXPECT_FALSE(cache.find(std::make_pair(0, 0), std::make_pair(0, 10), 0,
+                          grid.getVersion(), path));
+  EXPECT_TRUE(cache.find(std::make_pair(10, 0), std::make_pair(10, 10), 0,
+                         grid.getVersion(), path));
+  EXPECT_EQ(path.size(), 11u);
+}
+
+TEST(pathCacheTest, freedCellDropsShortcutsAndFailures) {
+  // wall across column 5 with a gap at the bottom
+  std::vector<std::vector<int>> map = openMap(20);
+  for (int y = 0; y < 19; y++) {
+    map[y][5] = 1;
+  }
+  OccupancyGrid grid(map);
+  PathCache cache;
+  optimalPlanner planner;
+  cache.search(planner, grid, std::make_pair(0, 0), std::make_pair(0, 10), 0);
+  cache.search(planner, grid, std::make_pair(0, 10), std::make_pair(0, 19),
+               0);
+  grid.setValue(grid.toIndex(std::make_pair(19, 5)), 1);
+  cache.updateCells(grid, {std::make_pair(19, 5)}, 0, 1);
+  cache.search(planner, grid, std::make_pair(0, 0), std::make_pair(0, 10), 1);
+  EXPECT_EQ(cache.size(), 2);
+
+  // opening the wall shortens the way around and connects the failed query,
+  // the path right of the wall can not get shorter
+  grid.setValue(grid.toIndex(std::make_pair(0, 5)), 0);
+  EXPECT_EQ(cache.updateCells(grid, {std::make_pair(0, 5)}, 1, 2), 1);
+  std::stack<std::pair<int, int>> path;
+  EXPECT_FALSE(cache.find(std::make_pair(0, 0), std::make_pair(0, 10), 0, 2,
+                          path));
+  EXPECT_TRUE(cache.find(std::make_pair(0, 10), std::make_pair(0, 19), 0, 2,
+                         path));
+  EXPECT_EQ(cache.search(planner, grid, std::make_pair(0, 0),
+                         std::make_pair(0, 10), 2)
+                .size(),
+            11u);
+}
+
+TEST(pathCacheTest, freedCellOpensDiagonalPastItsCorner) {
+  OccupancyGrid grid(openMap(4));
+  grid.setValue(grid.toIndex(std::make_pair(0, 1)), 1);
+  PathCache cache;
+  optimalPlanner planner;
+  planner.setConnectivity(Connectivity::EIGHT_CONNECTED);
+  std::pair<int, int> start(0, 0), goal(1, 1);
+  uint64_t before = grid.getVersion();
+  EXPECT_EQ(cache.search(planner, grid, start, goal, before).size(), 3u);
+  // the diagonal (0,0)-(1,1) passes the freed cell without entering it
+  grid.setValue(grid.toIndex(std::make_pair(0, 1)), 0);
+  EXPECT_EQ(cache.updateCells(grid, {std::make_pair(0, 1)}, before,
+                              grid.getVersion()),
+            1);
+  EXPECT_EQ(cache.search(planner, grid, start, goal, grid.getVersion()).size(),
+            2u);
+}
+
+TEST(pathCacheTest, blockedCellBreaksDiagonalPastItsCorner) {
+  OccupancyGrid grid(openMap(4));
+  PathCache cache;
+  optimalPlanner planner, cutting;
+  planner.setConnectivity(Connectivity::EIGHT_CONNECTED);
+  cutting.setConnectivity(Connectivity::EIGHT_CONNECTED_CUT_CORNERS);
+  std::pair<int, int> start(0, 0), goal(1, 1);
+  uint64_t before = grid.getVersion();
+  EXPECT_EQ(cache.search(planner, grid, start, goal, before).size(), 2u);
+  EXPECT_EQ(cache.search(cutting, grid, start, goal, before).size(), 2u);
+  // the diagonal (0,0)-(1,1) may not pass the blocked cell any more, unless
+  // the planner cuts corners
+  grid.setValue(grid.toIndex(std::make_pair(0, 1)), 1);
+  EXPECT_EQ(cache.updateCells(grid, {std::make_pair(0, 1)}, before,
+                              grid.getVersion()),
+            1);
+  EXPECT_EQ(cache.search(planner, grid, start, goal, grid.getVersion()).size(),
+            3u);
+  EXPECT_EQ(cache.search(cutting, grid, start, goal, grid.getVersion()).size(),
+            2u);
+  EXPECT_EQ(cache.getHits(), 1u);
+}
+
+TEST(pathCacheTest, costMapsAreOtherPlannerTypes) {
+  OccupancyGrid grid(openMap(10));
+  std::shared_ptr<CostMap> costs = std::make_shared<CostMap>(10, 10);
+  for (int x = 1; x < 9; x++) {
+    costs->setCost(grid.toIndex(std::make_pair(0, x)), 9);
+  }
+  PathCache cache;
+  optimalPlanner plain, weighted;
+  weighted.setCostMap(costs);
+  std::pair<int, int> start(0, 0), goal(0, 9);
+  std::stack<std::pair<int, int>> straight =
+      cache.search(plain, grid, start, goal, grid.getVersion());
+  std::stack<std::pair<int, int>> detour =
+      cache.search(weighted, grid, start, goal, grid.getVersion());
+  EXPECT_EQ(straight.size(), 10u);
+  EXPECT_EQ(detour, weighted.search(grid, start, goal));
+  EXPECT_GT(detour.size(), 10u);
+  EXPECT_EQ(cache.getMisses(), 2u);
+  EXPECT_EQ(cache.size(), 2);
+}
+
+TEST(pathCacheTest, freedCellOpensCheaperLongerWay) {
+  // costly top row above a wall across row 1, open below the wall
+  std::vector<std::vector<int>> map = openMap(10);
+  for (int x = 1; x < 10; x++) {
+    map[1][x] = 1;
+  }
+  OccupancyGrid grid(map);
+  std::shared_ptr<CostMap> costs = std::make_shared<CostMap>(10, 10);
+  for (int x = 1; x < 9; x++) {
+    costs->setCost(grid.toIndex(std::make_pair(0, x)), 9);
+  }
+  PathCache cache;
+  optimalPlanner planner;
+  planner.setCostMap(costs);
+  std::pair<int, int> start(0, 0), goal(0, 9);
+  EXPECT_EQ(cache.search(planner, grid, start, goal, 0).size(), 10u);
+
+  // the way below the wall takes more steps than the top row but costs less
+  grid.setValue(grid.toIndex(std::make_pair(1, 9)), 0);
+  EXPECT_EQ(cache.updateCells(grid, {std::make_pair(1, 9)}, 0, 1), 1);
+  std::stack<std::pair<int, int>> detour =
+      cache.search(planner, grid, start, goal, 1);
+  EXPECT_EQ(detour, planner.search(grid, start, goal));
+  EXPECT_EQ(detour.size(), 14u);
+}
+
+TEST(pathCacheTest, sharedBetweenThreads) {
+  OccupancyGrid grid(randomObstacleMap(64, 0.2, 9));
+  std::vector<std::pair<int, int>> cells;
+  for (int i = 0; i < grid.getCellCount() && cells.size() < 16; i += 97) {
+    if (grid.getValue(i) == 0) {
+      cells.push_back(grid.toPosition(i));
+    }
+  }
+  PathCache cache(4096);
+  std::vector<std::thread> threads;
+  std::vector<int> mismatches(4, 0);
+  for (int t = 0; t < 4; t++) {
+    threads.emplace_back([&, t]() {
+      optimalPlanner planner;
+      optimalPlanner reference;
+      for (int round = 0; round < 3; round++) {
+        for (std::size_t i = 0; i + 1 < cells.size(); i++) {
+          std::pair<int, int> start = cells[(i + t) % cells.size()];
+          std::pair<int, int> goal = cells[(i * 7 + 3) % cells.size()];
+          if (cache.search(planner, grid, start, goal, 0).size() !=
+              reference.search(grid, start, goal).size()) {
+            mismatches[t]++;
+          }
+        }
+      }
+    });
+  }
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+  for (int t = 0; t < 4; t++) {
+    EXPECT_EQ(mismatches[t], 0);
+  }
+  EXPECT_GT(cache.getHits(), 0u);
+  EXPECT_LE(cache.getCellCount(), 4096u);
+}
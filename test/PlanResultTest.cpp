@@ -0,0 +1,131 @@
+/* Copyright (C)
+ * 2019 - Bhargav Dandamudi
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the 'Software'), to deal in the Software without
+ * restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit
+ * persons to whom the Software is furnished to do so,subject to
+ * the following conditions:
+ * The above copyright notice and this permission notice shall
+ * be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED ''AS IS'', WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR
+ * ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM,OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+/**
+ * @file PlanResultTest.cpp
+ * @brief  Test the status codes returned by the planners
+ * @author Bhargav Dandamudi
+ * @version 1
+ * @date 2019-04-27
+ */
+#include "../include/PlanResult.h"
+#include "../include/RandomPlanner.h"
+#include "../include/optimalPlanner.h"
+#include <gtest/gtest.h>
+
+// wall across the map, (0,4) is closed in on the right
+static OccupancyGrid walledMap() {
+  std::vector<std::vector<int>> map{{0, 0, 1, 0, 0}, {0, 0, 1, 0, 0},
+                                    {0, 0, 1, 0, 0}, {0, 0, 1, 1, 1},
+                                    {0, 0, 0, 1, 0}};
+  return OccupancyGrid(map);
+}
+
+TEST(planResultTest, optimalPlannerStatus) {
+  OccupancyGrid grid = walledMap();
+  optimalPlanner planner;
+  PlanResult result =
+      planner.plan(grid, std::make_pair(0, 0), std::make_pair(4, 2));
+  EXPECT_TRUE(result.found());
+  EXPECT_EQ(result.path.front(), std::make_pair(0, 0));
+  EXPECT_EQ(result.path.back(), std::make_pair(4, 2));
+  EXPECT_EQ(result.path.size(), 7u);
+  EXPECT_EQ(result.stats.expansions, uint64_t(planner.getExpandedNodes()));
+
+  EXPECT_EQ(planner.plan(grid, std::make_pair(-1, 0), std::make_pair(4, 2))
+                .status,
+            PlanStatus::INVALID_START);
+  EXPECT_EQ(planner.plan(grid, std::make_pair(0, 0), std::make_pair(4, 5))
+                .status,
+            PlanStatus::INVALID_GOAL);
+  EXPECT_EQ(planner.plan(grid, std::make_pair(0, 2), std::make_pair(4, 2))
+                .status,
+            PlanStatus::BLOCKED_START);
+  result = planner.plan(grid, std::make_pair(0, 0), std::make_pair(3, 2));
+  EXPECT_EQ(result.status, PlanStatus::BLOCKED_GOAL);
+  EXPECT_TRUE(result.path.empty());
+  EXPECT_EQ(result.stats.expansions, 0u);
+  result = planner.plan(grid, std::make_pair(0, 0), std::make_pair(0, 4));
+  EXPECT_EQ(result.status, PlanStatus::UNREACHABLE);
+  EXPECT_TRUE(result.path.empty());
+  EXPECT_EQ(planner.getStatus(), PlanStatus::UNREACHABLE);
+  // search keeps returning the start for failed queries
+  EXPECT_EQ(planner.search(grid, std::make_pair(0, 0), std::make_pair(0, 4))
+                .size(),
+            1u);
+
+  TiledGrid tiled(2);
+  tiled.assign(grid);
+  EXPECT_EQ(planner.plan(tiled, std::make_pair(0, 0), std::make_pair(4, 2))
+                .path.size(),
+            7u);
+  EXPECT_EQ(planner.plan(tiled, std::make_pair(0, 0), std::make_pair(3, 2))
+                .status,
+            PlanStatus::BLOCKED_GOAL);
+}
+
+TEST(planResultTest, randomPlannerStatus) {
+  OccupancyGrid grid = walledMap();
+  RandomPlanner planner;
+  PlanResult result =
+      planner.plan(grid, std::make_pair(1, 1), std::make_pair(1, 1));
+  EXPECT_TRUE(result.found());
+  EXPECT_EQ(result.path.size(), 1u);
+  EXPECT_EQ(planner.plan(grid, std::make_pair(5, 0), std::make_pair(1, 1))
+                .status,
+            PlanStatus::INVALID_START);
+  EXPECT_EQ(planner.plan(grid, std::make_pair(0, 0), std::make_pair(0, 2))
+                .status,
+            PlanStatus::BLOCKED_GOAL);
+  // the walk can not get past the wall
+  result = planner.plan(grid, std::make_pair(0, 0), std::make_pair(0, 4));
+  EXPECT_EQ(result.status, PlanStatus::STEP_LIMIT);
+  EXPECT_EQ(result.stats.expansions, uint64_t(result.path.size() - 1));
+  planner.setComponentIndex(std::make_shared<ComponentIndex>(grid));
+  EXPECT_EQ(planner.plan(grid, std::make_pair(0, 0), std::make_pair(0, 4))
+                .status,
+            PlanStatus::UNREACHABLE);
+}
+
+TEST(planResultTest, mapsBeyondIntIndicesAreRejected) {
+  // 2^32 bit cells, rejected before any cell is read
+  uint64_t word = 0;
+  GridView view(&word, 65536, 65536, 0);
+  optimalPlanner planner;
+  PlanResult result =
+      planner.plan(view, std::make_pair(0, 0), std::make_pair(65535, 65535));
+  EXPECT_EQ(result.status, PlanStatus::MAP_TOO_LARGE);
+  EXPECT_TRUE(result.path.empty());
+  EXPECT_EQ(result.stats.expansions, 0u);
+}
+
+TEST(planResultTest, everyStatusIsDescribed) {
+  for (PlanStatus status :
+       {PlanStatus::SUCCESS, PlanStatus::INVALID_START,
+        PlanStatus::INVALID_GOAL, PlanStatus::BLOCKED_START,
+        PlanStatus::BLOCKED_GOAL, PlanStatus::UNREACHABLE,
+        PlanStatus::STEP_LIMIT, PlanStatus::MAP_TOO_LARGE}) {
+    EXPECT_STRNE(toString(status), "unknown status");
+  }
+}
@@ -32,6 +32,7 @@
 #include "../include/RandomPlanner.h"
 #include "../include/Node.h"
 #include <gtest/gtest.h>
+#include <thread>
 
 std::vector<std::vector<int>> world{{0, 0, 1, 0, 0, 0}, {0, 0, 1, 0, 0, 0},
                                     {0, 0, 0, 0, 1, 0}, {0, 0, 0, 0, 1, 0},
@@ -110,3 +111,58 @@ TEST(randomTest, findNeighborsTest) {
 
   EXPECT_EQ(rp_test.findNeighbors(test.position_), neighbor_t);
 }
+TEST(randomTest, directionsCoverAllMoves) {
+  RandomPlanner planner;
+  planner.setSeed(3);
+  int counts[5] = {0, 0, 0, 0, 0};
+  for (int i = 0; i < 4000; i++) {
+    int direction = planner.randomDirection();
+    ASSERT_GE(direction, 1);
+    ASSERT_LE(direction, 4);
+    counts[direction]++;
+  }
+  for (int direction = 1; direction <= 4; direction++) {
+    EXPECT_GT(counts[direction], 800);
+  }
+}
+TEST(randomTest, seedReplaysWalks) {
+  std::vector<std::vector<int>> open(40, std::vector<int>(40, 0));
+  RandomPlanner first;
+  RandomPlanner second;
+  first.setSeed(17);
+  second.setSeed(17);
+  EXPECT_EQ(second.getSeed(), 17u);
+  std::vector<std::pair<int, int>> walk =
+      first.search(open, std::make_pair(20, 20), std::make_pair(0, 0));
+  EXPECT_EQ(second.search(open, std::make_pair(20, 20), std::make_pair(0, 0)),
+            walk);
+  // seeding again restarts the sequence
+  first.setSeed(17);
+  EXPECT_EQ(first.search(open, std::make_pair(20, 20), std::make_pair(0, 0)),
+            walk);
+  second.setSeed(18);
+  EXPECT_NE(second.search(open, std::make_pair(20, 20), std::make_pair(0, 0)),
+            walk);
+}
+TEST(randomTest, plannersOnThreadsAreIndependent) {
+  OccupancyGrid grid(std::vector<std::vector<int>>(
+      40, std::vector<int>(40, 0)));
+  std::vector<std::vector<std::pair<int, int>>> walks(4);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; t++) {
+    threads.emplace_back([&grid, &walks, t]() {
+      RandomPlanner planner;
+      planner.setSeed(99);
+      for (int i = 0; i < 50; i++) {
+        walks[t] = planner.search(grid, std::make_pair(20, 20),
+                                  std::make_pair(0, 0));
+      }
+    });
+  }
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+  for (int t = 1; t < 4; t++) {
+    EXPECT_EQ(walks[t], walks[0]);
+  }
+}
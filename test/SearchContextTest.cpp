@@ -0,0 +1,101 @@
+/* Copyright (C)
+ * 2019 - Bhargav Dandamudi
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the 'Software'), to deal in the Software without
+ * restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit
+ * persons to whom the Software is furnished to do so,subject to
+ * the following conditions:
+ * The above copyright notice and this permission notice shall
+ * be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED ''AS IS'', WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR
+ * ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM,OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+/**
+ * @file SearchContextTest.cpp
+ * @brief  Test generation stamped search state and its reuse by the planner
+ * @author Bhargav Dandamudi
+ * @version 1
+ * @date 2019-04-13
+ */
+#include "../include/SearchContext.h"
+#include "../include/optimalPlanner.h"
+#include <gtest/gtest.h>
+
+static std::vector<std::vector<int>> context_map{
+    {0, 0, 1, 0, 0, 0}, {0, 0, 1, 0, 0, 0}, {0, 0, 0, 0, 1, 0},
+    {0, 0, 0, 0, 1, 0}, {0, 0, 1, 1, 1, 0}, {0, 0, 0, 0, 0, 0}};
+
+TEST(contextTest, newSearchForgetsOldState) {
+  SearchContext context;
+  context.beginSearch(4);
+  context.reach(2, 3.0f, 1);
+  context.close(2);
+  ASSERT_TRUE(context.isClosed(2));
+  EXPECT_EQ(context.getGCost(2), 3.0f);
+  EXPECT_EQ(context.getParent(2), 1);
+
+  context.beginSearch(4);
+  ASSERT_FALSE(context.isClosed(2));
+  ASSERT_FALSE(context.isReached(2));
+  EXPECT_EQ(context.getGCost(2), FLT_MAX);
+  EXPECT_EQ(context.getParent(2), -1);
+  EXPECT_EQ(context.getGeneration(), 2u);
+}
+
+TEST(contextTest, resizeRestartsGenerations) {
+  SearchContext context;
+  context.beginSearch(4);
+  context.beginSearch(4);
+  context.beginSearch(9);
+  EXPECT_EQ(context.getCellCount(), 9);
+  EXPECT_EQ(context.getGeneration(), 1u);
+  ASSERT_FALSE(context.isClosed(8));
+}
+
+TEST(contextTest, compactLayoutsUseTwelveBytesPerCell) {
+  SearchContext context;
+  context.beginSearch(100);
+  EXPECT_EQ(context.getMemoryUsage(), 1200u);
+  context.setLayout(NodeLayout::STRUCT_OF_ARRAYS);
+  context.beginSearch(100);
+  EXPECT_EQ(context.getMemoryUsage(), 1200u);
+  context.reach(7, 2.0f, 6);
+  ASSERT_TRUE(context.isReached(7));
+  EXPECT_EQ(context.getParent(7), 6);
+}
+
+TEST(contextTest, layoutsGiveSamePath) {
+  OccupancyGrid grid(context_map);
+  optimalPlanner planner;
+  std::stack<std::pair<int, int>> structs =
+      planner.search(grid, std::make_pair(2, 0), std::make_pair(5, 5));
+  planner.setNodeLayout(NodeLayout::STRUCT_OF_ARRAYS);
+  std::stack<std::pair<int, int>> arrays =
+      planner.search(grid, std::make_pair(2, 0), std::make_pair(5, 5));
+  EXPECT_EQ(structs, arrays);
+  EXPECT_EQ(planner.getNodeInformation(std::make_pair(3, 1)).g_cost, 2.0);
+}
+
+TEST(contextTest, repeatedSearchesGiveSamePath) {
+  OccupancyGrid grid(context_map);
+  optimalPlanner planner;
+  std::stack<std::pair<int, int>> first =
+      planner.search(grid, std::make_pair(2, 0), std::make_pair(5, 5));
+  // a short query in between must not leave state behind
+  planner.search(grid, std::make_pair(0, 0), std::make_pair(0, 1));
+  std::stack<std::pair<int, int>> second =
+      planner.search(grid, std::make_pair(2, 0), std::make_pair(5, 5));
+  EXPECT_EQ(first, second);
+}
@@ -0,0 +1,132 @@
+/* Copyright (C)
+ * 2019 - Bhargav Dandamudi
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the 'Software'), to deal in the Software without
+ * restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit
+ * persons to whom the Software is furnished to do so,subject to
+ * the following conditions:
+ * The above copyright notice and this permission notice shall
+ * be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED ''AS IS'', WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR
+ * ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM,OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+/**
+ * @file SearchStatsTest.cpp
+ * @brief  Test the search statistics of optimalPlanner and BatchPlanner
+ * @author Bhargav Dandamudi
+ * @version 1
+ * @date 2019-04-27
+ */
+#include "../bench/benchMaps.h"
+#include "../include/BatchPlanner.h"
+#include "../include/SearchStats.h"
+#include "../include/optimalPlanner.h"
+#include <gtest/gtest.h>
+
+TEST(searchStatsTest, sumKeepsLargestOpenList) {
+  SearchStats a;
+  a.searches = 1;
+  a.pushes = 10;
+  a.peak_open = 7;
+  a.search_ms = 1.5;
+  SearchStats b;
+  b.searches = 2;
+  b.pushes = 5;
+  b.peak_open = 4;
+  b.search_ms = 0.5;
+  a += b;
+  EXPECT_EQ(a.searches, 3u);
+  EXPECT_EQ(a.pushes, 15u);
+  EXPECT_EQ(a.peak_open, 7u);
+  EXPECT_DOUBLE_EQ(a.search_ms, 2.0);
+}
+
+TEST(searchStatsTest, countersMatchTheSearch) {
+  OccupancyGrid grid(randomObstacleMap(60, 0.25, 3));
+  for (OpenListType type : {OpenListType::SET, OpenListType::QUATERNARY_HEAP,
+                            OpenListType::BUCKET_QUEUE}) {
+    optimalPlanner planner;
+    planner.setOpenListType(type);
+    planner.search(grid, std::make_pair(0, 0), std::make_pair(59, 59));
+    SearchStats stats = planner.getSearchStats();
+    // set once per search, also without the hooks
+    EXPECT_EQ(stats.searches, 1u);
+    EXPECT_EQ(stats.expansions, uint64_t(planner.getExpandedNodes()));
+    if (!SearchStats::ENABLED) {
+      EXPECT_EQ(stats.pushes, 0u);
+      EXPECT_EQ(stats.search_ms, 0.0);
+      continue;
+    }
+    // every pop is an expansion or an entry left behind by an improvement
+    EXPECT_EQ(stats.pops, stats.expansions + stats.stale_pops);
+    EXPECT_LE(stats.stale_pops, stats.reopenings);
+    EXPECT_GE(stats.pushes, stats.pops);
+    EXPECT_GT(stats.peak_open, 0u);
+    EXPECT_LE(stats.peak_open, stats.pushes);
+    EXPECT_GE(stats.setup_ms, 0.0);
+    EXPECT_GE(stats.search_ms, 0.0);
+    EXPECT_GE(stats.track_path_ms, 0.0);
+    if (type == OpenListType::QUATERNARY_HEAP) {
+      // the heap lowers queued cells in place
+      EXPECT_EQ(stats.stale_pops, 0u);
+    }
+  }
+}
+
+TEST(searchStatsTest, everySearchModeCounts) {
+  if (!SearchStats::ENABLED) {
+    return;
+  }
+  OccupancyGrid grid(randomObstacleMap(60, 0.2, 8));
+  for (SearchMode mode : {SearchMode::JUMP_POINT, SearchMode::BIDIRECTIONAL}) {
+    optimalPlanner planner;
+    planner.setSearchMode(mode);
+    planner.search(grid, std::make_pair(0, 0), std::make_pair(59, 59));
+    SearchStats stats = planner.getSearchStats();
+    EXPECT_EQ(stats.expansions, uint64_t(planner.getExpandedNodes()));
+    EXPECT_GE(stats.pops, stats.expansions);
+    EXPECT_GT(stats.pushes, 0u);
+  }
+  TiledGrid tiled(4);
+  tiled.assign(grid);
+  optimalPlanner planner;
+  planner.search(tiled, std::make_pair(0, 0), std::make_pair(59, 59));
+  SearchStats stats = planner.getSearchStats();
+  EXPECT_EQ(stats.expansions, uint64_t(planner.getExpandedNodes()));
+  EXPECT_EQ(stats.pops, stats.expansions + stats.stale_pops);
+}
+
+TEST(searchStatsTest, batchSumsItsQueries) {
+  OccupancyGrid grid(randomObstacleMap(50, 0.2, 6));
+  std::vector<PlanQuery> queries;
+  for (int i = 0; i < 8; i++) {
+    std::pair<int, int> start(i * 6, 0);
+    std::pair<int, int> goal(49 - i * 5, 49);
+    grid.setValue(grid.toIndex(start), 0);
+    grid.setValue(grid.toIndex(goal), 0);
+    queries.push_back(PlanQuery(start, goal));
+  }
+  uint64_t expansions = 0;
+  for (const PlanQuery &query : queries) {
+    optimalPlanner planner;
+    planner.search(grid, query.first, query.second);
+    expansions += planner.getSearchStats().expansions;
+  }
+  BatchPlanner batch(2);
+  batch.planBatch(grid, queries);
+  SearchStats stats = batch.getBatchStats();
+  EXPECT_EQ(stats.searches, 8u);
+  EXPECT_EQ(stats.expansions, expansions);
+}
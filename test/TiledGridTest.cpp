@@ -0,0 +1,170 @@
+/* Copyright (C)
+ * 2019 - Bhargav Dandamudi
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the 'Software'), to deal in the Software without
+ * restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit
+ * persons to whom the Software is furnished to do so,subject to
+ * the following conditions:
+ * The above copyright notice and this permission notice shall
+ * be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED ''AS IS'', WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR
+ * ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM,OUT OF OR IN CONNECTION WITH
+ * THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+/**
+ * @file TiledGridTest.cpp
+ * @brief  Test the tiled map and the planner searches on it
+ * @author Bhargav Dandamudi
+ * @version 1
+ * @date 2019-04-27
+ */
+#include "../bench/benchMaps.h"
+#include "../include/TiledGrid.h"
+#include "../include/optimalPlanner.h"
+#include <cstdio>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+TEST(tiledGridTest, tilesMatchTheMap) {
+  // sizes off the tile grid, both cell storages
+  for (CellStorage storage : {CellStorage::BYTE, CellStorage::BIT}) {
+    OccupancyGrid grid(randomObstacleMap(150, 0.3, 4), storage);
+    TiledGrid tiled(2);
+    tiled.assign(grid);
+    EXPECT_EQ(tiled.getTileRows(), 3);
+    EXPECT_EQ(tiled.getTileColumns(), 3);
+    for (int y = 0; y < 150; y++) {
+      for (int x = 0; x < 150; x++) {
+        ASSERT_EQ(tiled.isOccupied(y, x), grid.getValue(y * 150 + x) == 1);
+      }
+    }
+    EXPECT_TRUE(tiled.isOccupied(150, 0));
+    EXPECT_TRUE(tiled.isOccupied(0, -1));
+    EXPECT_LE(tiled.getResidentTiles(), 2);
+  }
+}
+
+TEST(tiledGridTest, leastRecentlyUsedTileIsDropped) {
+  OccupancyGrid grid(openMap(192));
+  TiledGrid tiled(2);
+  tiled.assign(grid);
+  tiled.isOccupied(0, 0);   // tile 0
+  tiled.isOccupied(0, 64);  // tile 1
+  tiled.isOccupied(0, 1);   // tile 0 again
+  tiled.isOccupied(0, 128); // tile 2 replaces tile 1
+  EXPECT_EQ(tiled.getLoadCount(), 3u);
+  tiled.isOccupied(5, 5);
+  EXPECT_EQ(tiled.getLoadCount(), 3u);
+  tiled.isOccupied(5, 70);
+  EXPECT_EQ(tiled.getLoadCount(), 4u);
+  EXPECT_EQ(tiled.getResidentTiles(), 2);
+}
+
+TEST(tiledGridTest, sameCostAsWholeMapSearch) {
+  OccupancyGrid grid(randomObstacleMap(200, 0.25, 7));
+  TiledGrid tiled(4); // fewer tiles than the searches visit
+  tiled.assign(grid);
+  for (Connectivity connectivity :
+       {Connectivity::FOUR_CONNECTED, Connectivity::EIGHT_CONNECTED}) {
+    optimalPlanner planner;
+    optimalPlanner reference;
+    planner.setConnectivity(connectivity);
+    reference.setConnectivity(connectivity);
+    for (int i = 0; i < 8; i++) {
+      std::pair<int, int> start(i * 23 % 200, i * 41 % 200);
+      std::pair<int, int> goal(199 - i * 17 % 200, 199 - i * 7 % 200);
+      if (grid.getValue(grid.toIndex(start)) == 1 ||
+          grid.getValue(grid.toIndex(goal)) == 1) {
+        continue;
+      }
+      std::stack<std::pair<int, int>> path = planner.search(tiled, start, goal);
+      EXPECT_EQ(path.size(), reference.search(grid, start, goal).size());
+      // every step is a move into a free cell
+      std::pair<int, int> cell = path.top();
+      EXPECT_EQ(cell, start);
+      path.pop();
+      while (!path.empty()) {
+        EXPECT_LE(std::abs(path.top().first - cell.first), 1);
+        EXPECT_LE(std::abs(path.top().second - cell.second), 1);
+        cell = path.top();
+        EXPECT_EQ(grid.getValue(grid.toIndex(cell)), 0);
+        path.pop();
+      }
+    }
+  }
+}
+
+TEST(tiledGridTest, searchTouchesVisitedTilesOnly) {
+  std::string file_name = "tiled_grid_test.gmap";
+  OccupancyGrid grid(openMap(4096), CellStorage::BIT);
+  ASSERT_TRUE(MapFile::save(file_name, grid));
+  TiledGrid tiled(16);
+  ASSERT_TRUE(tiled.open(file_name));
+  EXPECT_EQ(tiled.getTileRows(), 64);
+  optimalPlanner planner;
+  std::stack<std::pair<int, int>> path = planner.search(
+      tiled, std::make_pair(2000, 2000), std::make_pair(2000, 2100));
+  EXPECT_EQ(path.size(), 101u);
+  // a straight run over a few tiles of a 64 x 64 tile map
+  EXPECT_LE(planner.getSearchedTiles(), 4);
+  EXPECT_LE(tiled.getLoadCount(), 8u);
+  // blocked goals are answered without searching
+  grid.setValue(grid.toIndex(std::make_pair(10, 10)), 1);
+  tiled.assign(grid);
+  path = planner.search(tiled, std::make_pair(0, 0), std::make_pair(10, 10));
+  EXPECT_EQ(path.size(), 1u);
+  EXPECT_EQ(planner.getExpandedNodes(), 0);
+  std::remove(file_name.c_str());
+}
+
+TEST(tiledGridTest, opensMapsAboveIntCells) {
+  // a 1 x 50000 byte map file grown to 50000 x 50000 cells (2.5 * 10^9)
+  // by raising the height in the header and extending the file sparsely
+  std::string file_name = "tiled_grid_large.gmap";
+  const int side = 50000;
+  OccupancyGrid row(1, side);
+  ASSERT_TRUE(MapFile::save(file_name, row));
+  uint64_t cells = uint64_t(side) * side;
+  uint64_t corner = 64 + uint64_t(side - 1) * side + (side - 2);
+  {
+    std::fstream file(file_name,
+                      std::ios::in | std::ios::out | std::ios::binary);
+    uint32_t height = side;
+    file.seekp(8); // height field of the header
+    file.write(reinterpret_cast<const char *>(&height), sizeof(height));
+    file.seekp(std::streamoff(corner));
+    file.put(char(1));
+  }
+  ASSERT_EQ(truncate(file_name.c_str(), off_t(64 + (cells + 7) / 8 * 8)), 0);
+
+  MapFile map;
+  ASSERT_TRUE(map.open(file_name));
+  EXPECT_EQ(map.getHeight(), side);
+  EXPECT_EQ(map.getView().getValue(std::make_pair(side - 1, side - 2)), 1);
+  EXPECT_EQ(map.getView().getValue(std::make_pair(side - 1, side - 3)), 0);
+  map.close();
+
+  TiledGrid tiled(16);
+  ASSERT_TRUE(tiled.open(file_name));
+  EXPECT_TRUE(tiled.isOccupied(side - 1, side - 2));
+  EXPECT_FALSE(tiled.isOccupied(side - 2, side - 2));
+  optimalPlanner planner;
+  std::stack<std::pair<int, int>> path = planner.search(
+      tiled, std::make_pair(side - 1, side - 10),
+      std::make_pair(side - 1, side - 1));
+  // around the obstacle in the last row
+  EXPECT_EQ(path.size(), 12u);
+  std::remove(file_name.c_str());
+}